@@ -28,7 +28,7 @@ static const char *driverName = "asynAxisAxis";
   * Connects pasynUser_ to this asyn port and axisNo.
   */
 asynAxisAxis::asynAxisAxis(class asynAxisController *pC, int axisNo)
-  : pC_(pC), axisNo_(axisNo), statusChanged_(1)
+  : pC_(pC), axisNo_(axisNo), statusDirty_(MOTOR_STATUS_DIRTY_ALL)
 {
   static const char *functionName = "asynAxisAxis";
 
@@ -47,6 +47,9 @@ asynAxisAxis::asynAxisAxis(class asynAxisController *pC, int axisNo)
   profilePositions_       = NULL;
   profileReadbacks_       = NULL;
   profileFollowingErrors_ = NULL;
+  profileMaxVelocity_     = 0.0;
+  profileMaxAcceleration_ = 0.0;
+  movesWhileMoving_       = false;
   
   /* Used to keep track of referencing mode in the driver.*/
   referencingMode_ = 0;
@@ -57,6 +60,14 @@ asynAxisAxis::asynAxisAxis(class asynAxisController *pC, int axisNo)
   disableFlag_ = 0;
   lastEndOfMoveTime_ = 0;
 
+  /* Use the poll periods of the controller, poll as soon as the poller runs */
+  movingPollPeriod_ = 0.0;
+  idlePollPeriod_ = 0.0;
+  forcedFastPolls_ = 0;
+  nextPollTime_.secPastEpoch = 0;
+  nextPollTime_.nsec = 0;
+  numSlowPolls_ = 0;
+
   // Create the asynUser, connect to this axis
   pasynUser_ = pasynManager->createAsynUser(NULL, NULL);
   pasynManager->connectDevice(pasynUser_, pC->portName, axisNo);
@@ -238,100 +249,48 @@ int  asynAxisAxis::getReferencingModeMove()
 /** Sets the value for an integer for this axis in the parameter library.
   * This function takes special action if the parameter is one of the motorStatus parameters
   * (motorStatusDirection_, motorStatusHomed_, etc.).  In that case it sets or clears the appropriate
-  * bit in its private MotorStatus.status structure and if that status has changed sets a flag to
-  * do callbacks to devMotorAsyn when callParamCallbacks() is called.
+  * bit in its private MotorStatus.status structure and if that status has changed marks it dirty,
+  * to do callbacks to devMotorAsyn when callParamCallbacks() is called.
   * \param[in] function The function (parameter) number 
   * \param[in] value Value to set */
 asynStatus asynAxisAxis::setIntegerParam(int function, int value)
 {
-  int mask;
-  epicsUInt32 status=0, flags=0;
-  // This assumes the parameters defined above are in the same order as the bits the motor record expects!
-  if (function >= pC_->motorStatusDirection_ && 
-      function <= pC_->motorStatusHomed_) {
-    status = status_.status;
-    mask = 1 << (function - pC_->motorStatusDirection_);
-    if (value) status |= mask;
-    else       status &= ~mask;
-    if (status != status_.status) {
-      status_.status = status;
-      statusChanged_ = 1;
-    }
-  } else  if (function >= pC_->motorFlagsHomeOnLs_ && 
-              function <= pC_->motorFlagsShowNotHomed_) {
-    flags = status_.flags;
-    mask = 1 << (function - pC_->motorFlagsHomeOnLs_);
-    if (value) flags |= mask;
-    else       flags &= ~mask;
-    if (flags != status_.flags) {
-      status_.flags = flags;
-      statusChanged_ = 1;
+  const MotorStatusMapEntry *pEntry = pC_->getMotorStatusMapEntry(function);
+
+  if (pEntry && pEntry->bitMask) {
+    epicsUInt32 *pWord;
+    epicsUInt32 word;
+    if (pEntry->dirtyMask == MOTOR_STATUS_DIRTY_STATUS) pWord = &status_.status;
+    else                                                pWord = &status_.flags;
+    if (value) word = *pWord |  pEntry->bitMask;
+    else       word = *pWord & ~pEntry->bitMask;
+    if (word != *pWord) {
+      *pWord = word;
+      statusDirty_ |= pEntry->dirtyMask;
     }
   }
   // Call the base class method
-  pC_->setIntegerParam(axisNo_, pC_->motorStatus_, status);
   return pC_->setIntegerParam(axisNo_, function, value);
 }
 
 
 
 /** Sets the value for a double for this axis in the parameter library.
-  * This function takes special action if the parameter is motorPosition_ or motorEncoderPosition_.  
+  * This function takes special action if the parameter is motorPosition_, motorEncoderPosition_,
+  * or one of the read only configuration parameters (motorHighLimitRO_ etc.).
   * In that case it sets the value in the private MotorStatus structure and if the value has changed
-  * then sets a flag to do callbacks to devMotorAsyn when callParamCallbacks() is called.
+  * marks it dirty, to do callbacks to devMotorAsyn when callParamCallbacks() is called.
   * \param[in] function The function (parameter) number 
   * \param[in] value Value to set */
 asynStatus asynAxisAxis::setDoubleParam(int function, double value)
 {
-  if (function == pC_->motorPosition_) {
-    if (value != status_.position) {
-        statusChanged_ = 1;
-        status_.position = value;
-    }
-  } else if (function == pC_->motorEncoderPosition_) {
-    if (value != status_.encoderPosition) {
-        statusChanged_ = 1;
-        status_.encoderPosition = value;
-    }
-  } else if (function == pC_->motorHighLimitRO_) {
-    if (value != status_.MotorConfigRO.motorHighLimitRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorHighLimitRaw = value;
-    }
-  } else if (function == pC_->motorLowLimitRO_) {
-    if (value != status_.MotorConfigRO.motorLowLimitRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorLowLimitRaw = value;
-    }
-  } else if (function == pC_->motorDefVelocityRO_) {
-    if (value != status_.MotorConfigRO.motorDefVelocityRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorDefVelocityRaw = value;
-    }
-  } else if (function == pC_->motorMaxVelocityRO_) {
-    if (value != status_.MotorConfigRO.motorMaxVelocityRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorMaxVelocityRaw = value;
-    }
-  } else if (function == pC_->motorDefJogVeloRO_) {
-    if (value != status_.MotorConfigRO.motorDefJogVeloRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorDefJogVeloRaw = value;
-    }
-  } else if (function == pC_->motorDefJogAccRO_) {
-    if (value != status_.MotorConfigRO.motorDefJogAccRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorDefJogAccRaw = value;
-    }
-  } else if (function == pC_->motorSDBDRO_) {
-    if (value != status_.MotorConfigRO.motorSDBDRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorSDBDRaw = value;
-    }
-  } else if (function == pC_->motorRDBDRO_) {
-    if (value != status_.MotorConfigRO.motorRDBDRaw) {
-      statusChanged_ = 1;
-      status_.MotorConfigRO.motorRDBDRaw = value;
+  const MotorStatusMapEntry *pEntry = pC_->getMotorStatusMapEntry(function);
+
+  if (pEntry && !pEntry->bitMask) {
+    double *pValue = (double *)((char *)&status_ + pEntry->doubleOffset);
+    if (value != *pValue) {
+      *pValue = value;
+      statusDirty_ |= pEntry->dirtyMask;
     }
   }
   // Call the base class method
@@ -487,11 +446,15 @@ void asynAxisAxis::updateMsgTxtField()
 
 /** Calls the callbacks for any parameters that have changed for this axis in the parameter library.
   * This function takes special action if the aggregate MotorStatus structure has changed.
-  * In that case it does callbacks on the asynGenericPointer interface, typically to devMotorAsyn. */  
+  * In that case it updates motorStatus_ and does callbacks on the asynGenericPointer interface,
+  * typically to devMotorAsyn. */  
 asynStatus asynAxisAxis::callParamCallbacks()
 {
-  if (statusChanged_) {
-    statusChanged_ = 0;
+  if (statusDirty_) {
+    if (statusDirty_ & MOTOR_STATUS_DIRTY_STATUS) {
+      pC_->setIntegerParam(axisNo_, pC_->motorStatus_, status_.status);
+    }
+    statusDirty_ = 0;
     updateMsgTxtField();
     pC_->doCallbacksGenericPointer((void *)&status_, pC_->motorStatus_, axisNo_);
   }
@@ -499,14 +462,15 @@ asynStatus asynAxisAxis::callParamCallbacks()
 }
 
 /* These are the functions for profile moves */
+/** Allocates the profile positions, and points the readback and following error arrays
+  * to this axis' part of the buffer which asynAxisController::initializeProfile() allocated,
+  * so that all axes can be read in one ProfileBlock. */
 asynStatus asynAxisAxis::initializeProfile(size_t maxProfilePoints)
 {
   if (profilePositions_)       free(profilePositions_);
   profilePositions_ =         (double *)calloc(maxProfilePoints, sizeof(double));
-  if (profileReadbacks_)    free(profileReadbacks_);
-  profileReadbacks_ =         (double *)calloc(maxProfilePoints, sizeof(double));
-  if (profileFollowingErrors_) free(profileFollowingErrors_);
-  profileFollowingErrors_ =   (double *)calloc(maxProfilePoints, sizeof(double));
+  profileReadbacks_ =         pC_->profileReadbackBuffer_ + axisNo_*maxProfilePoints;
+  profileFollowingErrors_ =   pC_->profileReadbackBuffer_ + (pC_->numAxes_ + axisNo_)*maxProfilePoints;
   return asynSuccess;
 }
   
@@ -621,6 +585,40 @@ asynStatus asynAxisAxis::readbackProfile()
   return asynSuccess;
 }
 
+/** Set the limits which asynAxisController::checkProfileKinematics() applies to this axis.
+  * \param[in] maxVelocity The largest velocity of an element of the profile, in controller units/s.
+  *            <= 0 means the maximum velocity which the controller reports in motorMaxVelocityRaw.
+  * \param[in] maxAcceleration The largest acceleration between two elements, in controller units/s^2.
+  *            <= 0 means that the acceleration is not checked. */
+asynStatus asynAxisAxis::setProfileLimits(double maxVelocity, double maxAcceleration)
+{
+  static const char *functionName = "setProfileLimits";
+
+  asynPrint(pasynUser_, ASYN_TRACE_FLOW,
+    "%s:%s: axis=%d maxVelocity=%f maxAcceleration=%f\n",
+    driverName, functionName, axisNo_, maxVelocity, maxAcceleration);
+  profileMaxVelocity_     = maxVelocity;
+  profileMaxAcceleration_ = maxAcceleration;
+  return asynSuccess;
+}
+
+/** Declare that move() sends a new target to the controller while the axis is still moving,
+  * without stopping it first.  The software profile move of asynAxisController sends each
+  * set point with move() while the axis moves to the previous one, so it only runs with axes
+  * which declare this.  Drivers whose move() stops the axis first, like IcePAP and EthercatMC,
+  * would run a profile stop-and-go and must not declare it.
+  * \param[in] movesWhileMoving true if move() takes a new target while the axis moves. */
+void asynAxisAxis::setMovesWhileMoving(bool movesWhileMoving)
+{
+  movesWhileMoving_ = movesWhileMoving;
+}
+
+/** Read if move() takes a new target while the axis moves, see setMovesWhileMoving(). */
+bool asynAxisAxis::getMovesWhileMoving()
+{
+  return movesWhileMoving_;
+}
+
 /****************************************************************************/
 /* The following functions are used by the automatic drive power control in the 
    base class poller in the asynAxisController class.*/
@@ -675,5 +673,194 @@ void asynAxisAxis::setLastEndOfMoveTime(double time)
 }
 
 
-/********************************************************************/
+/****************************************************************************/
+/* The following functions are used by the per-axis poll scheduling in the
+   base class poller in the asynAxisController class.*/
+
+/** Set poll periods for this axis, overriding the ones of the controller.
+  * \param[in] movingPollPeriod The time between polls when this axis is moving.
+  * \param[in] idlePollPeriod The time between polls when this axis is not moving.
+  * A value <= 0 means that the period of the controller is used. */
+asynStatus asynAxisAxis::setPollPeriods(double movingPollPeriod, double idlePollPeriod)
+{
+  static const char *functionName = "setPollPeriods";
+
+  asynPrint(pasynUser_, ASYN_TRACE_FLOW,
+    "%s:%s: axis=%d movingPollPeriod=%f idlePollPeriod=%f\n",
+    driverName, functionName, axisNo_, movingPollPeriod, idlePollPeriod);
+  movingPollPeriod_ = movingPollPeriod;
+  idlePollPeriod_   = idlePollPeriod;
+  return asynSuccess;
+}
+
+/**
+ * Read the time between polls when this axis is moving.
+ */
+double asynAxisAxis::getMovingPollPeriod(void)
+{
+  if (movingPollPeriod_ > 0.0) return movingPollPeriod_;
+  return pC_->movingPollPeriod_;
+}
+
+/**
+ * Read the time between polls when this axis is not moving.
+ * In push mode this is the watchdog poll period of the controller,
+ * unless the axis has an idle poll period of its own.
+ * 0 means that the axis is only polled when the poller is woken up.
+ */
+double asynAxisAxis::getIdlePollPeriod(void)
+{
+  if (idlePollPeriod_ > 0.0) return idlePollPeriod_;
+  if (pC_->watchdogPollPeriod_ > 0.0) return pC_->watchdogPollPeriod_;
+  return pC_->idlePollPeriod_;
+}
+
+/**
+ * Check if this axis should be polled now.
+ * Axes which become due within one sleep quantum are polled in this cycle
+ * as well, so that the poller does not wake up for them right after.
+ * asynAxisController::pollCycle() calls this once per cycle and passes the
+ * result to the poll() method of the controller in pollDueAxes_.
+ */
+bool asynAxisAxis::pollIsDue(const epicsTimeStamp *pNow)
+{
+  if (!nextPollTime_.secPastEpoch && !nextPollTime_.nsec) return true;
+  return epicsTimeDiffInSeconds(&nextPollTime_, pNow) <= epicsThreadSleepQuantum();
+}
+
+/**
+ * Calculate the time of the next poll after this axis had been polled.
+ * A moving axis is polled with the moving poll period.
+ * After a wakeup, and after the axis stopped, the axis is polled
+ * forcedFastPolls times with the moving poll period, because the
+ * controller may need some polls until the new state is reported.
+ * \param[in] pNow The time when the poll cycle started.
+ * \param[in] moving The result of the latest poll.
+ */
+void asynAxisAxis::scheduleNextPoll(const epicsTimeStamp *pNow, bool moving)
+{
+  double period;
+
+  if (moving) {
+    period = getMovingPollPeriod();
+    forcedFastPolls_ = pC_->forcedFastPolls_;
+  } else if (forcedFastPolls_ > 0) {
+    period = getMovingPollPeriod();
+    forcedFastPolls_--;
+  } else {
+    period = getIdlePollPeriod();
+  }
+  nextPollTime_ = *pNow;
+  if (period > 0.0) {
+    epicsTimeAddSeconds(&nextPollTime_, period);
+  } else {
+    /* Idle poll period 0: poll only when the poller is woken up */
+    nextPollTime_.secPastEpoch = 0xFFFFFFFF;
+  }
+}
+
+/**
+ * Read the time in seconds until this axis must be polled again.
+ * A negative value means that the axis does not need to be polled
+ * until the poller is woken up.
+ */
+double asynAxisAxis::getNextPollDelay(const epicsTimeStamp *pNow)
+{
+  double delay;
+
+  if (nextPollTime_.secPastEpoch == 0xFFFFFFFF) return -1.0;
+  delay = epicsTimeDiffInSeconds(&nextPollTime_, pNow);
+  /* Overdue, e.g. the poll cycle took longer than the poll period */
+  if (delay < 0.0) delay = 0.0;
+  return delay;
+}
+
+/**
+ * Add an item which is polled much less often than the axis, like a configuration
+ * or the homed status, which change only rarely.
+ * The poller of the controller calls slowPoll() with the item at most every period
+ * seconds, and polls at most one item of all axes in a poll cycle, after the axes,
+ * so that the polls of the axes do not wait for the slow items.
+ * The item is polled for the first time in one of the next poll cycles.
+ * Must be called with the lock held, normally from the constructor of the derived class.
+ * \param[in] period The time between two slow polls of this item.
+ * Returns the number of the item, which is passed to slowPoll(), or -1 on error.
+ */
+int asynAxisAxis::addSlowPoll(double period)
+{
+  static const char *functionName = "addSlowPoll";
+
+  if ((period <= 0.0) || (numSlowPolls_ >= MAX_SLOW_POLL_ITEMS)) {
+    asynPrint(pasynUser_, ASYN_TRACE_ERROR,
+      "%s:%s: Error, axis=%d period=%f, at most %d items with a positive period\n",
+      driverName, functionName, axisNo_, period, MAX_SLOW_POLL_ITEMS);
+    return -1;
+  }
+  slowPollPeriods_[numSlowPolls_] = period;
+  slowPollTimes_[numSlowPolls_].secPastEpoch = 0;
+  slowPollTimes_[numSlowPolls_].nsec = 0;
+  return numSlowPolls_++;
+}
+
+/**
+ * Poll a slow poll item in one of the next poll cycles, e.g. because the axis
+ * status shows that it has changed.  Must be called with the lock held.
+ * \param[in] item The number returned by addSlowPoll(), -1 for all items.
+ */
+void asynAxisAxis::requestSlowPoll(int item)
+{
+  int i;
 
+  for (i=0; i<numSlowPolls_; i++) {
+    if ((item >= 0) && (i != item)) continue;
+    slowPollTimes_[i].secPastEpoch = 0;
+    slowPollTimes_[i].nsec = 0;
+  }
+}
+
+/** Poll a slow poll item added with addSlowPoll().
+  * Called by the poller with the lock held, it calls callParamCallbacks() afterwards.
+  * \param[in] item The number returned by addSlowPoll(). */
+asynStatus asynAxisAxis::slowPoll(int item)
+{
+  return asynSuccess;
+}
+
+/**
+ * Find the slow poll item of this axis which is due first.
+ * \param[in] pNow The current time.
+ * \param[out] pItem The item.
+ * \param[out] pDelay The time until the item is due, negative when it is overdue.
+ * Returns false if the axis has no slow poll items.
+ */
+bool asynAxisAxis::getNextSlowPoll(const epicsTimeStamp *pNow, int *pItem, double *pDelay)
+{
+  double delay;
+  int i;
+
+  for (i=0; i<numSlowPolls_; i++) {
+    if (!slowPollTimes_[i].secPastEpoch && !slowPollTimes_[i].nsec) {
+      delay = -slowPollPeriods_[i];
+    } else {
+      delay = epicsTimeDiffInSeconds(&slowPollTimes_[i], pNow);
+    }
+    if ((i == 0) || (delay < *pDelay)) {
+      *pItem = i;
+      *pDelay = delay;
+    }
+  }
+  return numSlowPolls_ > 0;
+}
+
+/**
+ * Calculate the time of the next slow poll of an item after it had been polled.
+ * \param[in] pNow The time when the poll cycle started.
+ * \param[in] item The item.
+ */
+void asynAxisAxis::scheduleSlowPoll(const epicsTimeStamp *pNow, int item)
+{
+  slowPollTimes_[item] = *pNow;
+  epicsTimeAddSeconds(&slowPollTimes_[item], slowPollPeriods_[item]);
+}
+
+/********************************************************************/
@@ -9,6 +9,7 @@
 #define asynAxisAxis_H
 
 #include <epicsEvent.h>
+#include <epicsTime.h>
 #include <epicsTypes.h>
 
 #ifdef __cplusplus
@@ -16,6 +17,9 @@
 
 #include "asynAxisController.h"
 
+/** Maximum number of slow poll items of an axis, see asynAxisAxis::addSlowPoll() */
+#define MAX_SLOW_POLL_ITEMS 8
+
 /** Class from which motor axis objects are derived. */
 class epicsShareClass asynAxisAxis {
 
@@ -52,6 +56,9 @@ class epicsShareClass asynAxisAxis {
   virtual asynStatus executeProfile();
   virtual asynStatus abortProfile();
   virtual asynStatus readbackProfile();
+  virtual asynStatus setProfileLimits(double maxVelocity, double maxAcceleration);
+  void setMovesWhileMoving(bool movesWhileMoving);
+  bool getMovesWhileMoving();
 
   void setReferencingModeMove(int distance);
   int getReferencingModeMove();
@@ -64,6 +71,15 @@ class epicsShareClass asynAxisAxis {
   void setLastEndOfMoveTime(double time);
   void updateMsgTxtFromDriver(const char *value);
 
+  virtual asynStatus setPollPeriods(double movingPollPeriod, double idlePollPeriod);
+  double getMovingPollPeriod();
+  double getIdlePollPeriod();
+  bool pollIsDue(const epicsTimeStamp *pNow);
+
+  int addSlowPoll(double period);
+  void requestSlowPoll(int item);
+  virtual asynStatus slowPoll(int item);
+
   protected:
   class asynAxisController *pC_;    /**< Pointer to the asynAxisController to which this axis belongs.
                                       *   Abbreviated because it is used very frequently */
@@ -72,9 +88,12 @@ class epicsShareClass asynAxisAxis {
   double *profilePositions_;         /**< Array of target positions for profile moves */
   double *profileReadbacks_;         /**< Array of readback positions for profile moves */
   double *profileFollowingErrors_;   /**< Array of following errors for profile moves */   
+  double profileMaxVelocity_;        /**< Velocity limit of profile moves, <= 0 means motorMaxVelocityRaw */
+  double profileMaxAcceleration_;    /**< Acceleration limit of profile moves, <= 0 means none */
+  bool movesWhileMoving_;            /**< move() takes a new target while the axis moves, see setMovesWhileMoving() */
   int referencingMode_;
   MotorStatus status_;
-  int statusChanged_;
+  epicsUInt32 statusDirty_;          /**< MOTOR_STATUS_DIRTY_xxx bits, flushed in callParamCallbacks() */
   
   private:
   void updateMsgTxtField(void);
@@ -82,6 +101,19 @@ class epicsShareClass asynAxisAxis {
   int wasMovingFlag_;
   int disableFlag_;
   double lastEndOfMoveTime_;
+  double movingPollPeriod_;      /**< Per-axis moving poll period, <= 0 means use the controller's */
+  double idlePollPeriod_;        /**< Per-axis idle poll period, <= 0 means use the controller's */
+  int forcedFastPolls_;          /**< Fast polls left after a wakeup or after the axis stopped */
+  epicsTimeStamp nextPollTime_;  /**< Time when the poller should poll this axis again */
+  asynAxisHistogram pollHistogram_; /**< Duration of poll() called from the poller */
+  int numSlowPolls_;             /**< Number of slow poll items added with addSlowPoll() */
+  double slowPollPeriods_[MAX_SLOW_POLL_ITEMS];        /**< Time between the slow polls of each item */
+  epicsTimeStamp slowPollTimes_[MAX_SLOW_POLL_ITEMS];  /**< Time when each item is due, 0 when requested */
+
+  void scheduleNextPoll(const epicsTimeStamp *pNow, bool moving);
+  double getNextPollDelay(const epicsTimeStamp *pNow);
+  bool getNextSlowPoll(const epicsTimeStamp *pNow, int *pItem, double *pDelay);
+  void scheduleSlowPoll(const epicsTimeStamp *pNow, int item);
   
   friend class asynAxisController;
 };
@@ -5,10 +5,14 @@
  * This file defines the base class for an asynAxisController.  It is the class
  * from which real motor controllers are derived.  It derives from asynPortDriver.
  */
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 #include <epicsThread.h>
+#include <epicsStdio.h>
+#include <epicsMath.h>
 #include <iocsh.h>
 
 #include <asynPortDriver.h>
@@ -18,10 +22,13 @@
 #include <shareLib.h>
 #include "asynAxisController.h"
 #include "asynAxisAxis.h"
+#include "asynAxisPollerPool.h"
+#include "asynAxisProfile.h"
 
 static const char *driverName = "asynAxisController";
 static void asynMotorPollerC(void *drvPvt);
 static void asynMotorMoveToHomeC(void *drvPvt);
+static void asynMotorSoftwareProfileC(void *drvPvt);
 
 
 
@@ -109,6 +116,13 @@ asynAxisController::asynAxisController(const char *portName, int numAxes, int nu
   createParam(motorSDBDROString,                 asynParamFloat64,    &motorSDBDRO_);
   createParam(motorRDBDROString,                 asynParamFloat64,    &motorRDBDRO_);
 
+  // Timing histograms
+  createParam(motorTimingPollCycleString,   asynParamFloat64Array,    &motorTimingPollCycle_);
+  createParam(motorTimingAxisPollString,    asynParamFloat64Array,    &motorTimingAxisPoll_);
+  createParam(motorTimingWriteReadString,   asynParamFloat64Array,    &motorTimingWriteRead_);
+  createParam(motorTimingBucketsString,     asynParamFloat64Array,    &motorTimingBuckets_);
+  createParam(motorTimingResetString,            asynParamInt32,      &motorTimingReset_);
+
   // These are the per-controller parameters for profile moves
   createParam(profileNumAxesString,              asynParamInt32,      &profileNumAxes_);
   createParam(profileNumPointsString,            asynParamInt32,      &profileNumPoints_);
@@ -136,6 +150,8 @@ asynAxisController::asynAxisController(const char *portName, int numAxes, int nu
   createParam(profileReadbackStateString,        asynParamInt32,      &profileReadbackState_);
   createParam(profileReadbackStatusString,       asynParamInt32,      &profileReadbackStatus_);
   createParam(profileReadbackMessageString,      asynParamOctet,      &profileReadbackMessage_);
+  createParam(profilePositionsBlockString, asynParamGenericPointer,   &profilePositionsBlock_);
+  createParam(profileReadbackBlockString,  asynParamGenericPointer,   &profileReadbackBlock_);
 
   // These are the per-axis parameters for profile moves
   createParam(profileUseAxisString,              asynParamInt32,      &profileUseAxis_);
@@ -143,14 +159,65 @@ asynAxisController::asynAxisController(const char *portName, int numAxes, int nu
   createParam(profileReadbacksString,     asynParamFloat64Array,      &profileReadbacks_);
   createParam(profileFollowingErrorsString, asynParamFloat64Array,    &profileFollowingErrors_);
 
+  /* The parameters which are kept in the MotorStatus of the axes.
+   * This assumes the status parameters are in the same order as the bits the motor record expects! */
+  motorStatusMap_ = (MotorStatusMapEntry *)calloc(NUM_MOTOR_DRIVER_PARAMS, sizeof(MotorStatusMapEntry));
+  for (int function=motorStatusDirection_; function<=motorStatusHomed_; function++) {
+    setMotorStatusMapEntry(function, MOTOR_STATUS_DIRTY_STATUS,
+                           1 << (function - motorStatusDirection_), 0);
+  }
+  for (int function=motorFlagsHomeOnLs_; function<=motorFlagsShowNotHomed_; function++) {
+    setMotorStatusMapEntry(function, MOTOR_STATUS_DIRTY_FLAGS,
+                           1 << (function - motorFlagsHomeOnLs_), 0);
+  }
+  setMotorStatusMapEntry(motorPosition_, MOTOR_STATUS_DIRTY_POSITION, 0,
+                         offsetof(MotorStatus, position));
+  setMotorStatusMapEntry(motorEncoderPosition_, MOTOR_STATUS_DIRTY_ENCODER, 0,
+                         offsetof(MotorStatus, encoderPosition));
+  setMotorStatusMapEntry(motorHighLimitRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorHighLimitRaw));
+  setMotorStatusMapEntry(motorLowLimitRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorLowLimitRaw));
+  setMotorStatusMapEntry(motorDefVelocityRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorDefVelocityRaw));
+  setMotorStatusMapEntry(motorMaxVelocityRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorMaxVelocityRaw));
+  setMotorStatusMapEntry(motorDefJogVeloRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorDefJogVeloRaw));
+  setMotorStatusMapEntry(motorDefJogAccRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorDefJogAccRaw));
+  setMotorStatusMapEntry(motorSDBDRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorSDBDRaw));
+  setMotorStatusMapEntry(motorRDBDRO_, MOTOR_STATUS_DIRTY_CONFIG_RO, 0,
+                         offsetof(MotorStatus, MotorConfigRO.motorRDBDRaw));
+
   pAxes_ = (asynAxisAxis**) calloc(numAxes, sizeof(asynAxisAxis*));
+  pollDueAxes_ = (int *) calloc(numAxes, sizeof(int));
+  numPollDueAxes_ = 0;
   pollEventId_ = epicsEventMustCreate(epicsEventEmpty);
+  watchdogPollPeriod_ = 0.0;
+  pPollerPoolEntry_ = NULL;
   moveToHomeId_ = epicsEventMustCreate(epicsEventEmpty);
 
   maxProfilePoints_ = 0;
   profileTimes_ = NULL;
+  profileInverseTimes_ = NULL;
+  profileInverseMidTimes_ = NULL;
+  profileReadbackBuffer_ = NULL;
+  profileReadbackGeneration_ = 0;
   setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_DONE);
 
+  /* The software profile move is enabled with enableSoftwareProfile() */
+  softwareProfile_ = false;
+  softwareProfilePeriod_ = DEFAULT_SOFTWARE_PROFILE_PERIOD;
+  numProfileSetpoints_ = 0;
+  profileSetpoints_ = NULL;
+  profilePointTimes_ = NULL;
+  profileBasePositions_ = NULL;
+  profileAxisUsed_ = NULL;
+  softwareProfileAbort_ = false;
+  softwareProfileConverted_ = false;
+
   moveToHomeAxis_ = 0;
 
   asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
@@ -162,15 +229,41 @@ asynAxisController::~asynAxisController()
 {
 }
 
+/** Returns where a parameter is kept in the MotorStatus structure of an axis.
+  * Returns NULL if the parameter is not part of the MotorStatus.
+  * \param[in] function The function (parameter) number */
+const MotorStatusMapEntry* asynAxisController::getMotorStatusMapEntry(int function)
+{
+  const MotorStatusMapEntry *pEntry;
+
+  if ((function < FIRST_MOTOR_PARAM) || (function > LAST_MOTOR_PARAM)) return NULL;
+  pEntry = &motorStatusMap_[function - FIRST_MOTOR_PARAM];
+  if (!pEntry->dirtyMask) return NULL;
+  return pEntry;
+}
+
+void asynAxisController::setMotorStatusMapEntry(int function, epicsUInt32 dirtyMask,
+                                                epicsUInt32 bitMask, size_t doubleOffset)
+{
+  MotorStatusMapEntry *pEntry = &motorStatusMap_[function - FIRST_MOTOR_PARAM];
+
+  pEntry->dirtyMask    = dirtyMask;
+  pEntry->bitMask      = bitMask;
+  pEntry->doubleOffset = doubleOffset;
+}
+
 /** Called when asyn clients call pasynManager->report().
   * This calls the report method for each axis, and then the base class
   * asynPortDriver report method.
+  * If level >= 2 the timing histograms of the poller and of writeReadController()
+  * are printed as well.
   * \param[in] fp FILE pointer.
   * \param[in] level Level of detail to print. */
 void asynAxisController::report(FILE *fp, int level)
 {
   int axis;
   asynAxisAxis *pAxis;
+  char name[40];
 
   for (axis=0; axis<numAxes_; axis++) {
     pAxis = getAxis(axis);
@@ -178,6 +271,24 @@ void asynAxisController::report(FILE *fp, int level)
     pAxis->report(fp, level);
   }
 
+  if (softwareProfile_ && (level >= 1)) {
+    fprintf(fp, "  software profile move: set point period %f s, %d set points built\n",
+            softwareProfilePeriod_, numProfileSetpoints_);
+  }
+
+  if (level >= 2) {
+    lock();
+    pollCycleHistogram_.report(fp, "poll cycle");
+    writeReadHistogram_.report(fp, "writeReadController");
+    for (axis=0; axis<numAxes_; axis++) {
+      pAxis = getAxis(axis);
+      if (!pAxis) continue;
+      epicsSnprintf(name, sizeof(name), "axis %d poll", axis);
+      pAxis->pollHistogram_.report(fp, name);
+    }
+    unlock();
+  }
+
   // Call the base class method
   asynPortDriver::report(fp, level);
 }
@@ -202,6 +313,18 @@ asynStatus asynAxisController::writeInt32(asynUser *pasynUser, epicsInt32 value)
   int axis;
   static const char *functionName = "writeInt32";
 
+  /* The timing histograms of the controller do not depend on an axis,
+   * the controller may have no axis at the address of the records */
+  if (function == motorTimingReset_) {
+    int i;
+    pollCycleHistogram_.reset();
+    writeReadHistogram_.reset();
+    for (i=0; i<numAxes_; i++) {
+      if (pAxes_[i]) pAxes_[i]->pollHistogram_.reset();
+    }
+    return asynSuccess;
+  }
+
   pAxis = getAxis(pasynUser);
   if (!pAxis) return asynError;
   axis = pAxis->axisNo_;
@@ -223,10 +346,13 @@ asynStatus asynAxisController::writeInt32(asynUser *pasynUser, epicsInt32 value)
 
   } else if (function == motorUpdateStatus_) {
     bool moving;
-    /* Do a poll, and then force a callback */
+    /* Do a poll of this axis, and then force a callback */
+    pollDueAxes_[0] = axis;
+    numPollDueAxes_ = 1;
     poll();
     status = pAxis->poll(&moving);
-    pAxis->statusChanged_ = 1;
+    pollFinished();
+    pAxis->statusDirty_ |= MOTOR_STATUS_DIRTY_ALL;
 
   } else if (function == profileBuild_) {
     status = buildProfile();
@@ -482,8 +608,23 @@ asynStatus asynAxisController::readFloat64Array(asynUser *pasynUser, epicsFloat6
   int numReadbacks;
   static const char *functionName = "readFloat64Array";
 
+  /* Controller histograms, independent of the address */
+  if (function == motorTimingPollCycle_) {
+    return pollCycleHistogram_.read(value, nElements, nRead);
+  }
+  else if (function == motorTimingWriteRead_) {
+    return writeReadHistogram_.read(value, nElements, nRead);
+  }
+  else if (function == motorTimingBuckets_) {
+    return asynAxisHistogram::readBuckets(value, nElements, nRead);
+  }
+
   pAxis = getAxis(pasynUser);
   if (!pAxis) return asynError;
+
+  if (function == motorTimingAxisPoll_) {
+    return pAxis->pollHistogram_.read(value, nElements, nRead);
+  }
   
   getIntegerParam(profileNumReadbacks_, &numReadbacks);
   *nRead = numReadbacks;
@@ -507,7 +648,7 @@ asynStatus asynAxisController::readFloat64Array(asynUser *pasynUser, epicsFloat6
 
 /** Called when asyn clients call pasynGenericPointer->read().
   * Builds an aggregate MotorStatus structure at the memory location of the
-  * input pointer.  
+  * input pointer, or for PROFILE_READBACK_BLOCK a ProfileBlock of the readbacks of all axes.
   * \param[in] pasynUser asynUser structure that encodes the reason and address.
   * \param[in] pointer Pointer to the MotorStatus object to return. */
 asynStatus asynAxisController::readGenericPointer(asynUser *pasynUser, void *pointer)
@@ -517,6 +658,11 @@ asynStatus asynAxisController::readGenericPointer(asynUser *pasynUser, void *poi
   asynAxisAxis *pAxis;
   static const char *functionName = "readGenericPointer";
 
+  if (pasynUser->reason == profileReadbackBlock_) {
+    if (!profileReadbackBuffer_) return asynError;
+    getProfileReadbackBlock((ProfileBlock *)pointer);
+    return asynSuccess;
+  }
   pAxis = getAxis(pasynUser);
   if (!pAxis) return asynError;
   axis = pAxis->axisNo_;
@@ -539,6 +685,43 @@ asynStatus asynAxisController::readGenericPointer(asynUser *pasynUser, void *poi
   return asynSuccess;
 }  
 
+/** Called when asyn clients call pasynGenericPointer->write().
+  * For PROFILE_POSITIONS_BLOCK, defines the profile positions of all axes in the ProfileBlock
+  * with asynAxisAxis::defineProfile(), as writeFloat64Array() does for PROFILE_POSITIONS of one axis.
+  * \param[in] pasynUser asynUser structure that encodes the reason and address.
+  * \param[in] pointer Pointer to the ProfileBlock. */
+asynStatus asynAxisController::writeGenericPointer(asynUser *pasynUser, void *pointer)
+{
+  ProfileBlock *pBlock = (ProfileBlock *)pointer;
+  int axis;
+  size_t numPoints;
+  asynAxisAxis *pAxis;
+  static const char *functionName = "writeGenericPointer";
+
+  if (pasynUser->reason != profilePositionsBlock_) {
+    return asynPortDriver::writeGenericPointer(pasynUser, pointer);
+  }
+  if ((pBlock->version != PROFILE_BLOCK_VERSION) || (pBlock->numAxes > numAxes_) ||
+      (pBlock->numPoints < 0) || (pBlock->stride < (size_t)pBlock->numPoints)) {
+    asynPrint(pasynUser, ASYN_TRACE_ERROR,
+      "%s:%s: invalid block, version=%u, numAxes=%d, numPoints=%d, stride=%d\n",
+      driverName, functionName, (unsigned)pBlock->version, pBlock->numAxes,
+      pBlock->numPoints, (int)pBlock->stride);
+    return asynError;
+  }
+  numPoints = pBlock->numPoints;
+  if (numPoints > maxProfilePoints_) numPoints = maxProfilePoints_;
+  for (axis=0; axis<pBlock->numAxes; axis++) {
+    pAxis = getAxis(axis);
+    if (!pAxis) continue;
+    pAxis->defineProfile(pBlock->positions + axis*pBlock->stride, numPoints);
+  }
+  asynPrint(pasynUser, ASYN_TRACE_FLOW,
+    "%s:%s: numAxes=%d, numPoints=%d\n",
+    driverName, functionName, pBlock->numAxes, (int)numPoints);
+  return asynSuccess;
+}
+
 /** Called when asyn clients call pasynOctetSyncIO->write().
   * Extracts the function and axis number from pasynUser.
   * Sets the value in the parameter library.
@@ -597,16 +780,27 @@ asynAxisAxis* asynAxisController::getAxis(int axisNo)
   * Derived classes will typically call this at near the end of their constructor.
   * Derived classes can typically use the base class implementation of the poller thread,
   * but are free to reimplement it if necessary.
-  * \param[in] movingPollPeriod The time between polls when any axis is moving.
-  * \param[in] idlePollPeriod The time between polls when no axis is moving.
+  * The poll periods are the defaults for all axes, an axis can override them with
+  * asynAxisAxis::setPollPeriods().
+  * \param[in] movingPollPeriod The time between polls when an axis is moving.
+  * \param[in] idlePollPeriod The time between polls when an axis is not moving.
   * \param[in] forcedFastPolls The number of times to force the movingPollPeriod after waking up the poller.  
   * This can need to be non-zero for controllers that do not immediately
-  * report that an axis is moving after it has been told to start. */
+  * report that an axis is moving after it has been told to start.
+  * When the poller pool has been created with asynMotorPollerPoolCreate, the controller
+  * is polled by the threads of the pool instead of a thread of its own. */
 asynStatus asynAxisController::startPoller(double movingPollPeriod, double idlePollPeriod, int forcedFastPolls)
 {
+  asynAxisPollerPool *pPool = asynAxisPollerPool::getPool();
+
   movingPollPeriod_ = movingPollPeriod;
   idlePollPeriod_   = idlePollPeriod;
   forcedFastPolls_  = forcedFastPolls;
+  if (pPool) {
+    pPollerPoolEntry_ = pPool->add(this);
+    wakeupPoller();  /* Force on poll at startup */
+    return asynSuccess;
+  }
   epicsThreadCreate("motorPoller", 
                     epicsThreadPriorityLow,
                     epicsThreadGetStackSize(epicsThreadStackMedium),
@@ -621,6 +815,29 @@ asynStatus asynAxisController::startPoller(double movingPollPeriod, double idleP
 asynStatus asynAxisController::wakeupPoller()
 {
   epicsEventSignal(pollEventId_);
+  if (pPollerPoolEntry_) asynAxisPollerPool::getPool()->wakeup(pPollerPoolEntry_);
+  return asynSuccess;
+}
+
+/** Declares that the driver gets the status of the axes pushed by the controller.
+  * The driver then calls wakeupPoller() when the controller notifies it of a change,
+  * and the poller polls axes which are not moving only at the watchdog poll period,
+  * to detect a lost notification or a lost connection.
+  * Moving axes are still polled at the movingPollPeriod_, so that the position
+  * readback follows the motion.
+  * \param[in] watchdogPollPeriod The time between polls when an axis is not moving.
+  * A value <= 0 switches push mode off. */
+asynStatus asynAxisController::setPushMode(double watchdogPollPeriod)
+{
+  static const char *functionName = "setPushMode";
+
+  asynPrint(pasynUserSelf, ASYN_TRACE_FLOW,
+    "%s:%s: watchdogPollPeriod=%f\n",
+    driverName, functionName, watchdogPollPeriod);
+  lock();
+  watchdogPollPeriod_ = (watchdogPollPeriod > 0.0) ? watchdogPollPeriod : 0.0;
+  unlock();
+  wakeupPoller();
   return asynSuccess;
 }
 
@@ -637,6 +854,14 @@ asynStatus asynAxisController::poll()
   return asynSuccess;
 }
 
+/** Called at the end of each poll cycle, after asynAxisAxis::poll has been called for the axes.
+  * This base class implementation does nothing.  Derived classes whose poll() caches values
+  * for the axis polls can discard them here, so that calls outside of the poll cycle
+  * never see values of an earlier cycle. */
+void asynAxisController::pollFinished()
+{
+}
+
 static void asynMotorPollerC(void *drvPvt)
 {
   asynAxisController *pController = (asynAxisController*)drvPvt;
@@ -645,23 +870,22 @@ static void asynMotorPollerC(void *drvPvt)
   
 /** Default poller function that runs in the thread created by asynAxisController::startPoller().
   * This base class implementation can be used by most derived classes. 
-  * It polls at the idlePollPeriod_ when no axes are moving, and at the movingPollPeriod_ when
-  * any axis is moving.  It will immediately do a poll when asynAxisController::wakeupPoller() is
-  * called, and will then do forcedFastPolls_ loops at the movingPollPeriod, before reverting back
-  * to the idlePollPeriod_ if no axes are moving. It takes the lock on the port driver when it is polling.
+  * Each axis has its own next-due time: it is polled at the movingPollPeriod_ when it is moving,
+  * and at the idlePollPeriod_ when it is not moving. An axis may override these periods,
+  * see asynAxisAxis::setPollPeriods(). It will immediately poll all axes when
+  * asynAxisController::wakeupPoller() is called, and will then do forcedFastPolls_ loops
+  * at the movingPollPeriod, before reverting back to the idlePollPeriod_ if the axis is not moving.
+  * An axis that stopped moving is polled forcedFastPolls_ times at the movingPollPeriod as well.
+  * In push mode, see asynAxisController::setPushMode(), the idlePollPeriod_ is replaced
+  * by the watchdogPollPeriod_.
+  * asynAxisController::poll() is called once in every cycle, before the axes are polled,
+  * also in the cycles in which no axis is due. It finds the axes which are polled in the
+  * cycle in pollDueAxes_.
+  * It takes the lock on the port driver when it is polling.
   */
 void asynAxisController::asynMotorPoller()
 {
   double timeout;
-  int i;
-  int forcedFastPolls=0;
-  bool anyMoving;
-  bool moving;
-  epicsTimeStamp nowTime;
-  double nowTimeSecs = 0.0;
-  asynAxisAxis *pAxis;
-  int autoPower = 0;
-  double autoPowerOffDelay = 0.0;
   int status;
 
   timeout = idlePollPeriod_;
@@ -670,67 +894,140 @@ void asynAxisController::asynMotorPoller()
   while(1) {
     if (timeout != 0.) status = epicsEventWaitWithTimeout(pollEventId_, timeout);
     else               status = epicsEventWait(pollEventId_);
-    if (status == epicsEventWaitOK) {
-      /* We got an event, rather than a timeout.  This is because other software
-       * knows that an axis should have changed state (started moving, etc.).
-       * Force a minimum number of fast polls, because the controller status
-       * might not have changed the first few polls
-       */
-      forcedFastPolls = forcedFastPolls_;
-    }
-    anyMoving = false;
-    lock();
-    if (shuttingDown_) {
-      unlock();
-      break;
-    }
+    timeout = pollCycle(status == epicsEventWaitOK);
+    if (timeout < 0.0) break;
+  }
+}
 
-    poll();
+/** Runs one cycle of the poller: polls the controller and the axes which are due.
+  * \param[in] woken The poller had been woken up, rather than a timeout.
+  * Returns the time until the next cycle, 0 to wait for the next wakeup,
+  * or a negative value when the IOC is shutting down. */
+double asynAxisController::pollCycle(bool woken)
+{
+  double timeout;
+  double delay;
+  int i, j;
+  bool moving;
+  epicsTimeStamp cycleTime;
+  epicsTimeStamp nowTime;
+  epicsTimeStamp axisPollTime;
+  double nowTimeSecs = 0.0;
+  asynAxisAxis *pAxis;
+  asynAxisAxis *pSlowAxis;
+  int item, slowItem = 0;
+  double slowDelay = 0.0;
+  int autoPower = 0;
+  double autoPowerOffDelay = 0.0;
+
+  lock();
+  if (shuttingDown_) {
+    unlock();
+    return -1.0;
+  }
+  epicsTimeGetCurrent(&cycleTime);
+  if (woken) {
+    /* We got an event, rather than a timeout.  This is because other software
+     * knows that an axis should have changed state (started moving, etc.).
+     * Poll all axes now, and force a minimum number of fast polls,
+     * because the controller status might not have changed the first few polls
+     */
     for (i=0; i<numAxes_; i++) {
       pAxis=getAxis(i);
       if (!pAxis) continue;
-      
-      getIntegerParam(i, motorPowerAutoOnOff_, &autoPower);
-      getDoubleParam(i, motorPowerOffDelay_, &autoPowerOffDelay);
-      
-      pAxis->poll(&moving);
-      if (moving) {
-	anyMoving = true;
-	pAxis->setWasMovingFlag(1);
-      } else {
-	if ((pAxis->getWasMovingFlag() == 1) && (autoPower == 1)) {
-	  pAxis->setDisableFlag(1);
-          pAxis->setWasMovingFlag(0);
-          epicsTimeGetCurrent(&nowTime);
-          pAxis->setLastEndOfMoveTime(nowTime.secPastEpoch + (nowTime.nsec / 1.e9));
-	}
-      }
+      pAxis->forcedFastPolls_ = forcedFastPolls_;
+      pAxis->nextPollTime_.secPastEpoch = 0;
+      pAxis->nextPollTime_.nsec = 0;
+    }
+  }
+
+  /* The axes which are due now, or were due earlier. poll() and the axis loop
+   * below use the same list, so that both agree on the axes of this cycle */
+  numPollDueAxes_ = 0;
+  for (i=0; i<numAxes_; i++) {
+    pAxis=getAxis(i);
+    if (!pAxis) continue;
+    if (pAxis->pollIsDue(&cycleTime)) pollDueAxes_[numPollDueAxes_++] = i;
+  }
+
+  poll();
+  for (j=0; j<numPollDueAxes_; j++) {
+    i = pollDueAxes_[j];
+    pAxis=getAxis(i);
+
+    getIntegerParam(i, motorPowerAutoOnOff_, &autoPower);
+    getDoubleParam(i, motorPowerOffDelay_, &autoPowerOffDelay);
 
-      //Auto power off drive, if:
-      //  We have detected an end of move
-      //  We are not moving again
-      //  Auto power off is enabled
-      //  Auto power off delay timer has expired
-      if ((!moving) && (autoPower == 1) && (pAxis->getDisableFlag() == 1)) {
-	epicsTimeGetCurrent(&nowTime);
-	nowTimeSecs = nowTime.secPastEpoch + (nowTime.nsec / 1.e9);
-	if ((nowTimeSecs - pAxis->getLastEndOfMoveTime()) >= autoPowerOffDelay) {
-	  pAxis->setClosedLoop(0);
-	  pAxis->setDisableFlag(0);
-	}
+    epicsTimeGetCurrent(&axisPollTime);
+    pAxis->poll(&moving);
+    pAxis->pollHistogram_.add(&axisPollTime);
+    if (moving) {
+      pAxis->setWasMovingFlag(1);
+    } else {
+      if ((pAxis->getWasMovingFlag() == 1) && (autoPower == 1)) {
+        pAxis->setDisableFlag(1);
+        pAxis->setWasMovingFlag(0);
+        epicsTimeGetCurrent(&nowTime);
+        pAxis->setLastEndOfMoveTime(nowTime.secPastEpoch + (nowTime.nsec / 1.e9));
       }
+    }
 
+    //Auto power off drive, if:
+    //  We have detected an end of move
+    //  We are not moving again
+    //  Auto power off is enabled
+    //  Auto power off delay timer has expired
+    if ((!moving) && (autoPower == 1) && (pAxis->getDisableFlag() == 1)) {
+      epicsTimeGetCurrent(&nowTime);
+      nowTimeSecs = nowTime.secPastEpoch + (nowTime.nsec / 1.e9);
+      if ((nowTimeSecs - pAxis->getLastEndOfMoveTime()) >= autoPowerOffDelay) {
+        pAxis->setClosedLoop(0);
+        pAxis->setDisableFlag(0);
+      }
     }
-    if (forcedFastPolls > 0) {
-      timeout = movingPollPeriod_;
-      forcedFastPolls--;
-    } else if (anyMoving) {
-      timeout = movingPollPeriod_;
-    } else {
-      timeout = idlePollPeriod_;
+    pAxis->scheduleNextPoll(&cycleTime, moving);
+  }
+  pollFinished();
+
+  /* Poll at most one slow poll item per cycle, the most overdue one of all axes,
+   * so that the axes above are not delayed by many slow items being due at once */
+  pSlowAxis = NULL;
+  for (i=0; i<numAxes_; i++) {
+    pAxis=getAxis(i);
+    if (!pAxis) continue;
+    if (!pAxis->getNextSlowPoll(&cycleTime, &item, &delay)) continue;
+    if (delay > 0.0) continue;
+    if (!pSlowAxis || (delay < slowDelay)) {
+      pSlowAxis = pAxis;
+      slowItem = item;
+      slowDelay = delay;
     }
-    unlock();
   }
+  if (pSlowAxis) {
+    pSlowAxis->slowPoll(slowItem);
+    pSlowAxis->scheduleSlowPoll(&cycleTime, slowItem);
+    pSlowAxis->callParamCallbacks();
+  }
+
+  /* Sleep until the next axis or slow poll item is due. Without any axis that
+   * needs to be polled, poll the controller at the idlePollPeriod_,
+   * or at the watchdogPollPeriod_ in push mode */
+  epicsTimeGetCurrent(&nowTime);
+  timeout = -1.0;
+  for (i=0; i<numAxes_; i++) {
+    pAxis=getAxis(i);
+    if (!pAxis) continue;
+    delay = pAxis->getNextPollDelay(&nowTime);
+    if ((delay >= 0.0) && ((timeout < 0.0) || (delay < timeout))) timeout = delay;
+    if (!pAxis->getNextSlowPoll(&nowTime, &item, &delay)) continue;
+    if (delay < 0.0) delay = 0.0;
+    if ((timeout < 0.0) || (delay < timeout)) timeout = delay;
+  }
+  if (timeout < 0.0) timeout = (watchdogPollPeriod_ > 0.0) ? watchdogPollPeriod_ : idlePollPeriod_;
+  else if (timeout < epicsThreadSleepQuantum()) timeout = epicsThreadSleepQuantum();
+  pollCycleHistogram_.add(epicsTimeDiffInSeconds(&nowTime, &cycleTime));
+  unlock();
+  return timeout;
 }
 
 /**
@@ -824,17 +1121,124 @@ asynStatus asynAxisController::writeReadController(const char *output, char *inp
   size_t nwrite;
   asynStatus status;
   int eomReason;
+  epicsTimeStamp startTime;
   // const char *functionName="writeReadController";
   
+  epicsTimeGetCurrent(&startTime);
   status = pasynOctetSyncIO->writeRead(pasynUserController_, output,
                                        strlen(output), input, maxChars, timeout,
                                        &nwrite, nread, &eomReason);
+  writeReadHistogram_.add(&startTime);
                         
   return status;
 }
 
 
 
+/* These are the functions for the timing histograms */
+/** Upper limits of the histogram buckets in seconds.
+  * The last bucket has no upper limit. */
+static const double timingBucketLimits[MOTOR_TIMING_NUM_BUCKETS - 1] = {
+  10e-6, 20e-6, 50e-6,
+  100e-6, 200e-6, 500e-6,
+  1e-3, 2e-3, 5e-3,
+  10e-3, 20e-3, 50e-3,
+  100e-3, 200e-3, 500e-3,
+  1.0, 2.0, 5.0,
+  10.0
+};
+
+asynAxisHistogram::asynAxisHistogram()
+{
+  reset();
+}
+
+/** Clears all buckets. */
+void asynAxisHistogram::reset()
+{
+  memset(counts_, 0, sizeof(counts_));
+  numSamples_ = 0;
+  minSeconds_ = 0.0;
+  maxSeconds_ = 0.0;
+}
+
+/** Adds one duration to the histogram.
+  * \param[in] seconds The duration. */
+void asynAxisHistogram::add(double seconds)
+{
+  int bucket;
+
+  if (seconds < 0.0) seconds = 0.0; /* The clock had been set back */
+  for (bucket=0; bucket<MOTOR_TIMING_NUM_BUCKETS - 1; bucket++) {
+    if (seconds <= timingBucketLimits[bucket]) break;
+  }
+  /* Counters saturate instead of wrapping around */
+  if (counts_[bucket] != 0xFFFFFFFFu) counts_[bucket]++;
+  if (!numSamples_ || seconds < minSeconds_) minSeconds_ = seconds;
+  if (!numSamples_ || seconds > maxSeconds_) maxSeconds_ = seconds;
+  if (numSamples_ != 0xFFFFFFFFu) numSamples_++;
+}
+
+/** Adds the time since pStartTime to the histogram.
+  * \param[in] pStartTime The time when the measured operation started. */
+void asynAxisHistogram::add(const epicsTimeStamp *pStartTime)
+{
+  epicsTimeStamp nowTime;
+  epicsTimeGetCurrent(&nowTime);
+  add(epicsTimeDiffInSeconds(&nowTime, pStartTime));
+}
+
+/** Copies the counts of the buckets into an array, used for the asynFloat64Array interface.
+  * \param[out] value The array of counts.
+  * \param[in] nElements Size of the array.
+  * \param[out] nRead Number of elements copied. */
+asynStatus asynAxisHistogram::read(epicsFloat64 *value, size_t nElements, size_t *nRead)
+{
+  size_t i;
+
+  *nRead = MOTOR_TIMING_NUM_BUCKETS;
+  if (*nRead > nElements) *nRead = nElements;
+  for (i=0; i<*nRead; i++) value[i] = counts_[i];
+  return asynSuccess;
+}
+
+/** Copies the upper limits of the buckets in seconds into an array.
+  * The last bucket has no upper limit, it is reported as 0.
+  * \param[out] value The array of limits.
+  * \param[in] nElements Size of the array.
+  * \param[out] nRead Number of elements copied. */
+asynStatus asynAxisHistogram::readBuckets(epicsFloat64 *value, size_t nElements, size_t *nRead)
+{
+  size_t i;
+
+  *nRead = MOTOR_TIMING_NUM_BUCKETS;
+  if (*nRead > nElements) *nRead = nElements;
+  for (i=0; i<*nRead; i++) {
+    value[i] = (i < MOTOR_TIMING_NUM_BUCKETS - 1) ? timingBucketLimits[i] : 0.0;
+  }
+  return asynSuccess;
+}
+
+/** Prints the non-empty buckets of the histogram.
+  * \param[in] fp FILE pointer.
+  * \param[in] name Name of the histogram. */
+void asynAxisHistogram::report(FILE *fp, const char *name)
+{
+  int bucket;
+
+  fprintf(fp, "  %s: %u samples, min=%.6f s, max=%.6f s\n",
+          name, (unsigned)numSamples_, minSeconds_, maxSeconds_);
+  for (bucket=0; bucket<MOTOR_TIMING_NUM_BUCKETS; bucket++) {
+    if (!counts_[bucket]) continue;
+    if (bucket < MOTOR_TIMING_NUM_BUCKETS - 1) {
+      fprintf(fp, "    <= %9.6f s: %u\n", timingBucketLimits[bucket], (unsigned)counts_[bucket]);
+    } else {
+      fprintf(fp, "    >  %9.6f s: %u\n", timingBucketLimits[bucket - 1], (unsigned)counts_[bucket]);
+    }
+  }
+}
+
+
 /* These are the functions for profile moves */
 /** Initialize a profile move of multiple axes. */
 asynStatus asynAxisController::initializeProfile(size_t maxProfilePoints)
@@ -846,6 +1250,13 @@ asynStatus asynAxisController::initializeProfile(size_t maxProfilePoints)
   maxProfilePoints_ = maxProfilePoints;
   if (profileTimes_) free(profileTimes_);
   profileTimes_ = (double *)calloc(maxProfilePoints, sizeof(double));
+  if (profileInverseTimes_) free(profileInverseTimes_);
+  profileInverseTimes_ = (double *)calloc(maxProfilePoints, sizeof(double));
+  if (profileInverseMidTimes_) free(profileInverseMidTimes_);
+  profileInverseMidTimes_ = (double *)calloc(maxProfilePoints, sizeof(double));
+  /* The axes use parts of this for their readback and following error arrays */
+  if (profileReadbackBuffer_) free(profileReadbackBuffer_);
+  profileReadbackBuffer_ = (double *)calloc(2*numAxes_*maxProfilePoints, sizeof(double));
   for (axis=0; axis<numAxes_; axis++) {
     pAxis = getAxis(axis);
     if (!pAxis) continue;
@@ -880,16 +1291,31 @@ asynStatus asynAxisController::buildProfile()
     if (!pAxis) continue;
     pAxis->buildProfile();
   }
+  if (softwareProfile_) return buildSoftwareProfile();
   return asynSuccess;
 }
 
 /** Execute a profile move of multiple axes. */
 asynStatus asynAxisController::executeProfile()
 {
-  // static const char *functionName = "executeProfile";
+  static const char *functionName = "executeProfile";
   int axis;
+  int executeState;
   asynAxisAxis *pAxis;
   
+  if (softwareProfile_) {
+    getIntegerParam(profileExecuteState_, &executeState);
+    if (executeState != PROFILE_EXECUTE_DONE) {
+      asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: Error, the profile move is already executing\n",
+                driverName, functionName);
+      return asynError;
+    }
+    /* Set the state now, so that it is busy before the thread runs */
+    setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_MOVE_START);
+    epicsEventSignal(softwareProfileExecuteEvent_);
+    return asynSuccess;
+  }
   for (axis=0; axis<numAxes_; axis++) {
     pAxis = getAxis(axis);
     if (!pAxis) continue;
@@ -903,8 +1329,24 @@ asynStatus asynAxisController::abortProfile()
 {
   // static const char *functionName = "abortProfile";
   int axis;
+  int executeState;
+  double acceleration;
   asynAxisAxis *pAxis;
   
+  if (softwareProfile_) {
+    getIntegerParam(profileExecuteState_, &executeState);
+    if (executeState != PROFILE_EXECUTE_DONE) {
+      softwareProfileAbort_ = true;
+      epicsEventSignal(softwareProfileAbortEvent_);
+      for (axis=0; axis<numAxes_; axis++) {
+        pAxis = getAxis(axis);
+        if (!pAxis || !profileAxisUsed_[axis]) continue;
+        getDoubleParam(axis, motorAccel_, &acceleration);
+        pAxis->stop(acceleration);
+      }
+      wakeupPoller();
+    }
+  }
   for (axis=0; axis<numAxes_; axis++) {
     pAxis = getAxis(axis);
     if (!pAxis) continue;
@@ -920,11 +1362,513 @@ asynStatus asynAxisController::readbackProfile()
   int axis;
   asynAxisAxis *pAxis;
   
+  if (softwareProfile_) return readbackSoftwareProfile();
   for (axis=0; axis<numAxes_; axis++) {
     pAxis = getAxis(axis);
     if (!pAxis) continue;
     pAxis->readbackProfile();
   }
+  postProfileReadbackBlock();
+  return asynSuccess;
+}
+
+/** Fills a ProfileBlock with the readbacks and following errors of all axes.
+  * \param[out] pBlock The block, which points to profileReadbackBuffer_. */
+void asynAxisController::getProfileReadbackBlock(ProfileBlock *pBlock)
+{
+  int numReadbacks;
+
+  getIntegerParam(profileNumReadbacks_, &numReadbacks);
+  pBlock->version         = PROFILE_BLOCK_VERSION;
+  pBlock->generation      = profileReadbackGeneration_;
+  pBlock->numAxes         = numAxes_;
+  pBlock->numPoints       = numReadbacks;
+  pBlock->stride          = maxProfilePoints_;
+  pBlock->positions       = profileReadbackBuffer_;
+  pBlock->followingErrors = profileReadbackBuffer_ + numAxes_*maxProfilePoints_;
+}
+
+/** Posts the readbacks and following errors of all axes as one ProfileBlock on PROFILE_READBACK_BLOCK.
+  * Called by readbackProfile() after the arrays of the axes have been posted,
+  * and by drivers which post readbacks while the profile move executes. */
+void asynAxisController::postProfileReadbackBlock()
+{
+  ProfileBlock block;
+
+  if (!profileReadbackBuffer_) return;
+  profileReadbackGeneration_++;
+  getProfileReadbackBlock(&block);
+  doCallbacksGenericPointer(&block, profileReadbackBlock_, 0);
+}
+
+/** Checks the velocities, accelerations and positions of the axes which are used in a profile move.
+  * The velocity of each element must not exceed the velocity limit of asynAxisAxis::setProfileLimits(),
+  * or else the maximum velocity which the controller reports in motorMaxVelocityRaw.
+  * The acceleration between two elements must not exceed the acceleration limit, if there is one.
+  * With checkLimits the positions must be within the soft limits, if the high limit is above the low limit.
+  * The positions must be in controller units, i.e. after asynAxisAxis::defineProfile(), and the times
+  * of the elements must be positive.  Positions and times which are NaN or infinite fail the check.
+  * Each axis is one pass over its array of positions, so this is cheap enough to be done on every
+  * build, also of long profiles.  The builds of the software profile move and of the PI wave
+  * generator call it; other drivers can call it from their buildProfile() if their profile
+  * positions and limits are in controller units.
+  * \param[in] numPoints The number of points, at least 2.
+  * \param[in] checkLimits Check the soft limits, i.e. the positions are absolute.
+  * \param[out] message The reason why the check failed, unchanged on success.
+  * \param[in] messageSize The size of message.
+  * Returns asynError if the check failed. */
+asynStatus asynAxisController::checkProfileKinematics(int numPoints, bool checkLimits, char *message, size_t messageSize)
+{
+  int axis;
+  int useAxis;
+  int point;
+  double maxVelocity, maxAcceleration;
+  double highLimit, lowLimit;
+  bool tooFast, tooHigh;
+  asynAxisProfileKinematics kinematics;
+  asynAxisAxis *pAxis;
+  static const char *functionName = "checkProfileKinematics";
+
+  for (point=0; point<numPoints-1; point++) {
+    /* Also false for NaN */
+    if (!(profileTimes_[point] > 0.) || !isfinite(profileTimes_[point])) {
+      epicsSnprintf(message, messageSize, "Invalid time %f at point %d", profileTimes_[point], point);
+      return asynError;
+    }
+  }
+  asynAxisProfileInverseTimes(profileTimes_, numPoints, profileInverseTimes_, profileInverseMidTimes_);
+  for (axis=0; axis<numAxes_; axis++) {
+    pAxis = getAxis(axis);
+    if (!pAxis) continue;
+    getIntegerParam(axis, profileUseAxis_, &useAxis);
+    if (!useAxis) continue;
+    point = asynAxisProfileFindNonFinite(pAxis->profilePositions_, numPoints);
+    if (point >= 0) {
+      epicsSnprintf(message, messageSize, "Invalid position %f for axis %d at point %d",
+                    pAxis->profilePositions_[point], axis, point);
+      return asynError;
+    }
+    asynAxisProfileKinematicsCompute(pAxis->profilePositions_, profileInverseTimes_,
+                                     profileInverseMidTimes_, numPoints, &kinematics);
+    maxVelocity = (pAxis->profileMaxVelocity_ > 0.) ? pAxis->profileMaxVelocity_ :
+                                                      pAxis->status_.MotorConfigRO.motorMaxVelocityRaw;
+    maxAcceleration = pAxis->profileMaxAcceleration_;
+    asynPrint(pasynUserSelf, ASYN_TRACE_FLOW,
+              "%s:%s: axis=%d, maxVelocity=%f (limit %f), maxAcceleration=%f (limit %f), positions %f to %f\n",
+              driverName, functionName, axis, kinematics.maxVelocity, maxVelocity,
+              kinematics.maxAcceleration, maxAcceleration, kinematics.minPosition, kinematics.maxPosition);
+    tooFast = (maxVelocity > 0.) && (kinematics.maxVelocity > maxVelocity);
+    tooHigh = (maxAcceleration > 0.) && (kinematics.maxAcceleration > maxAcceleration);
+    if (tooFast || tooHigh) {
+      /* Only now look for the first point where a limit is exceeded */
+      point = asynAxisProfileFindViolation(pAxis->profilePositions_, profileInverseTimes_,
+                                           profileInverseMidTimes_, numPoints,
+                                           tooFast ? maxVelocity : 0., tooHigh ? maxAcceleration : 0.);
+      if (tooFast) {
+        epicsSnprintf(message, messageSize, "Velocity too high for axis %d at point %d, %f > %f",
+                      axis, point, kinematics.maxVelocity, maxVelocity);
+      } else {
+        epicsSnprintf(message, messageSize, "Acceleration too high for axis %d at point %d, %f > %f",
+                      axis, point, kinematics.maxAcceleration, maxAcceleration);
+      }
+      return asynError;
+    }
+    if (!checkLimits) continue;
+    getDoubleParam(axis, motorHighLimit_, &highLimit);
+    getDoubleParam(axis, motorLowLimit_, &lowLimit);
+    if (highLimit <= lowLimit) continue;
+    if (kinematics.maxPosition > highLimit) {
+      epicsSnprintf(message, messageSize, "High soft limit violation for axis %d, %f > %f",
+                    axis, kinematics.maxPosition, highLimit);
+      return asynError;
+    }
+    if (kinematics.minPosition < lowLimit) {
+      epicsSnprintf(message, messageSize, "Low soft limit violation for axis %d, %f < %f",
+                    axis, kinematics.minPosition, lowLimit);
+      return asynError;
+    }
+  }
+  return asynSuccess;
+}
+
+/** Enables the software-timed profile move, for controllers which have no profile move of their own.
+  * buildProfile() checks and resamples the profile, executeProfile() streams the set points
+  * to the axes with asynAxisAxis::move() from a thread of this controller, and the readbacks
+  * and following errors are the positions which the poller read at the time of each point.
+  * Must be called after the axes have been created.  All axes must take a new target while
+  * they move, see asynAxisAxis::setMovesWhileMoving(), so that the set points are followed
+  * without stopping at each of them.
+  * \param[in] maxPoints The maximum number of profile points.
+  * \param[in] period The minimum time between set points; points which are closer together
+  *            are merged, so that the controller is not sent more moves than it can take.
+  *            <= 0 selects DEFAULT_SOFTWARE_PROFILE_PERIOD. */
+asynStatus asynAxisController::enableSoftwareProfile(size_t maxPoints, double period)
+{
+  int i;
+  asynAxisAxis *pAxis;
+  static const char *functionName = "enableSoftwareProfile";
+
+  if (softwareProfile_) {
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+              "%s:%s: Error, the software profile move is already enabled\n",
+              driverName, functionName);
+    return asynError;
+  }
+  if (maxPoints < 2) {
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+              "%s:%s: Error, invalid maximum number of points %d\n",
+              driverName, functionName, (int)maxPoints);
+    return asynError;
+  }
+  for (i=0; i<numAxes_; i++) {
+    pAxis = getAxis(i);
+    if (!pAxis || pAxis->getMovesWhileMoving()) continue;
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+              "%s:%s: Error, axis %d stops before each move, the profile would not be followed\n",
+              driverName, functionName, i);
+    return asynError;
+  }
+  initializeProfile(maxPoints);
+  profileSetpoints_     = (int *)calloc(maxPoints, sizeof(int));
+  profilePointTimes_    = (double *)calloc(maxPoints, sizeof(double));
+  profileBasePositions_ = (double *)calloc(numAxes_, sizeof(double));
+  profileAxisUsed_      = (bool *)calloc(numAxes_, sizeof(bool));
+  softwareProfilePeriod_ = (period > 0.) ? period : DEFAULT_SOFTWARE_PROFILE_PERIOD;
+  softwareProfileExecuteEvent_ = epicsEventMustCreate(epicsEventEmpty);
+  softwareProfileAbortEvent_ = epicsEventMustCreate(epicsEventEmpty);
+  softwareProfile_ = true;
+  epicsThreadCreate("motorSoftProfile", 
+                    epicsThreadPriorityMedium,
+                    epicsThreadGetStackSize(epicsThreadStackMedium),
+                    (EPICSTHREADFUNC)asynMotorSoftwareProfileC, (void *)this);
+  return asynSuccess;
+}
+
+/** Checks the profile and resamples it into the set points of the software profile move.
+  * The time of each element must be positive, and the profile must pass checkProfileKinematics().
+  * Points which follow the previous set point within softwareProfilePeriod_ are not sent
+  * to the axes, the last point always is. */
+asynStatus asynAxisController::buildSoftwareProfile()
+{
+  int i, j;
+  int numPoints;
+  int numUsed = 0;
+  int useAxis;
+  int from;
+  int moveMode;
+  bool buildOK = true;
+  char message[MAX_CONTROLLER_STRING_SIZE];
+  asynAxisAxis *pAxis;
+  static const char *functionName = "buildSoftwareProfile";
+
+  strcpy(message, "");
+  setStringParam(profileBuildMessage_, message);
+  setIntegerParam(profileBuildState_, PROFILE_BUILD_BUSY);
+  setIntegerParam(profileBuildStatus_, PROFILE_STATUS_UNDEFINED);
+  callParamCallbacks();
+
+  numProfileSetpoints_ = 0;
+  getIntegerParam(profileNumPoints_, &numPoints);
+  if ((numPoints < 2) || (numPoints > (int)maxProfilePoints_)) {
+    buildOK = false;
+    epicsSnprintf(message, sizeof(message), "Invalid number of points %d, must be 2 to %d",
+                  numPoints, (int)maxProfilePoints_);
+    goto done;
+  }
+  profilePointTimes_[0] = 0.;
+  for (i=1; i<numPoints; i++) {
+    if (!(profileTimes_[i-1] > 0.) || !isfinite(profileTimes_[i-1])) {
+      buildOK = false;
+      epicsSnprintf(message, sizeof(message), "Negative, null or invalid time at point %d", i-1);
+      goto done;
+    }
+    profilePointTimes_[i] = profilePointTimes_[i-1] + profileTimes_[i-1];
+  }
+
+  /* Resample */
+  profileSetpoints_[0] = 0;
+  numProfileSetpoints_ = 1;
+  for (i=1; i<numPoints; i++) {
+    from = profileSetpoints_[numProfileSetpoints_-1];
+    if ((i < numPoints-1) &&
+        (profilePointTimes_[i] - profilePointTimes_[from] < softwareProfilePeriod_)) continue;
+    profileSetpoints_[numProfileSetpoints_++] = i;
+  }
+
+  for (j=0; j<numAxes_; j++) {
+    pAxis = getAxis(j);
+    if (!pAxis) continue;
+    getIntegerParam(j, profileUseAxis_, &useAxis);
+    if (useAxis) numUsed++;
+  }
+  getIntegerParam(profileMoveMode_, &moveMode);
+  if (checkProfileKinematics(numPoints, moveMode == PROFILE_MOVE_MODE_ABSOLUTE,
+                             message, sizeof(message))) {
+    buildOK = false;
+    goto done;
+  }
+  if (numUsed == 0) {
+    buildOK = false;
+    strcpy(message, "No axis is used");
+  }
+
+  done:
+  if (!buildOK) numProfileSetpoints_ = 0;
+  asynPrint(pasynUserSelf, ASYN_TRACE_FLOW,
+            "%s:%s: numPoints=%d, numSetpoints=%d, period=%f\n",
+            driverName, functionName, numPoints, numProfileSetpoints_, softwareProfilePeriod_);
+  setIntegerParam(profileBuildStatus_, buildOK ? PROFILE_STATUS_SUCCESS : PROFILE_STATUS_FAILURE);
+  setStringParam(profileBuildMessage_, message);
+  if (!buildOK) {
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+              "%s:%s: %s\n",
+              driverName, functionName, message);
+  }
+  /* Clear build command.  This is a "busy" record, don't want to do this until build is complete. */
+  setIntegerParam(profileBuild_, 0);
+  setIntegerParam(profileBuildState_, PROFILE_BUILD_DONE);
+  callParamCallbacks();
+  return buildOK ? asynSuccess : asynError;
+}
+
+static void asynMotorSoftwareProfileC(void *drvPvt)
+{
+  asynAxisController *pController = (asynAxisController*)drvPvt;
+  pController->softwareProfileThread();
+}
+
+/** The thread which runs the software profile moves, started by enableSoftwareProfile(). */
+void asynAxisController::softwareProfileThread()
+{
+  while (1) {
+    epicsEventMustWait(softwareProfileExecuteEvent_);
+    runSoftwareProfile();
+  }
+}
+
+/** Waits until a time of the profile move, with the lock released.
+  * Must be called with the lock held.
+  * \param[in] pStartTime The time when the profile move started.
+  * \param[in] time The time to wait for, from pStartTime.
+  * Returns true if the profile move has been aborted. */
+bool asynAxisController::waitSoftwareProfile(const epicsTimeStamp *pStartTime, double time)
+{
+  epicsTimeStamp nowTime;
+  double delay;
+
+  while (!softwareProfileAbort_) {
+    epicsTimeGetCurrent(&nowTime);
+    delay = time - epicsTimeDiffInSeconds(&nowTime, pStartTime);
+    if (delay <= 0.) return false;
+    unlock();
+    epicsEventWaitWithTimeout(softwareProfileAbortEvent_, delay);
+    lock();
+  }
+  return true;
+}
+
+/** Stores the positions of the axes as the readbacks of a profile point, in controller units.
+  * These are the positions from the last poll of each axis, so they are as recent as the
+  * moving poll period.
+  * \param[in] point The index of the profile point. */
+void asynAxisController::sampleSoftwareProfile(int point)
+{
+  int j;
+  double position;
+  asynAxisAxis *pAxis;
+
+  for (j=0; j<numAxes_; j++) {
+    pAxis = getAxis(j);
+    if (!pAxis || !profileAxisUsed_[j]) continue;
+    getDoubleParam(j, motorPosition_, &position);
+    pAxis->profileReadbacks_[point] = position;
+    pAxis->profileFollowingErrors_[point] = position - (profileBasePositions_[j] + pAxis->profilePositions_[point]);
+  }
+  setIntegerParam(profileCurrentPoint_, point+1);
+  setIntegerParam(profileNumReadbacks_, point+1);
+  callParamCallbacks();
+}
+
+/** Runs a software profile move.
+  * The axes move to the first point at the velocity of normal moves.  Then the move to each set point
+  * is sent when the previous set point is due, with the velocity that gets the axis to the set point
+  * at its time, and the acceleration time from profileAcceleration_.
+  * The readbacks of all points are sampled at their times.
+  * Called from softwareProfileThread() without the lock. */
+asynStatus asynAxisController::runSoftwareProfile()
+{
+  int i, j;
+  int from, to;
+  int point;
+  int numPoints;
+  int moveMode;
+  int useAxis;
+  int axisDone;
+  int status;
+  bool allDone;
+  bool executeOK = true;
+  bool aborted = false;
+  double baseVelocity, velocity, acceleration;
+  double accelerationTime;
+  double distance;
+  char message[MAX_CONTROLLER_STRING_SIZE];
+  epicsTimeStamp startTime;
+  asynAxisAxis *pAxis;
+  static const char *functionName = "runSoftwareProfile";
+
+  lock();
+  strcpy(message, "");
+  softwareProfileAbort_ = false;
+  softwareProfileConverted_ = false;
+  epicsEventTryWait(softwareProfileAbortEvent_);
+  setIntegerParam(profileExecuteStatus_, PROFILE_STATUS_UNDEFINED);
+  setStringParam(profileExecuteMessage_, message);
+  setIntegerParam(profileCurrentPoint_, 0);
+  setIntegerParam(profileNumReadbacks_, 0);
+  callParamCallbacks();
+  if (numProfileSetpoints_ < 2) {
+    executeOK = false;
+    strcpy(message, "The profile has not been built");
+    goto done;
+  }
+  numPoints = profileSetpoints_[numProfileSetpoints_-1] + 1;
+  getIntegerParam(profileMoveMode_, &moveMode);
+  getDoubleParam(profileAcceleration_, &accelerationTime);
+  if (accelerationTime <= 0.) accelerationTime = softwareProfilePeriod_;
+
+  /* Move to the first point, clearing the readbacks of the last profile move */
+  profileReadbackGeneration_++;
+  for (j=0; j<numAxes_; j++) {
+    pAxis = getAxis(j);
+    profileAxisUsed_[j] = false;
+    if (!pAxis) continue;
+    memset(pAxis->profileReadbacks_,       0, maxProfilePoints_*sizeof(double));
+    memset(pAxis->profileFollowingErrors_, 0, maxProfilePoints_*sizeof(double));
+    getIntegerParam(j, profileUseAxis_, &useAxis);
+    if (!useAxis) continue;
+    profileAxisUsed_[j] = true;
+    profileBasePositions_[j] = 0.;
+    if (moveMode == PROFILE_MOVE_MODE_RELATIVE) getDoubleParam(j, motorPosition_, &profileBasePositions_[j]);
+    getDoubleParam(j, motorVelBase_, &baseVelocity);
+    getDoubleParam(j, motorVelocity_, &velocity);
+    getDoubleParam(j, motorAccel_, &acceleration);
+    if (velocity <= 0.) velocity = pAxis->status_.MotorConfigRO.motorDefVelocityRaw;
+    status = pAxis->move(profileBasePositions_[j] + pAxis->profilePositions_[0], 0,
+                         baseVelocity, velocity, acceleration);
+    if (status) {
+      executeOK = false;
+      epicsSnprintf(message, sizeof(message), "Error moving axis %d to the first point", j);
+      goto done;
+    }
+    pAxis->setIntegerParam(motorStatusDone_, 0);
+    pAxis->callParamCallbacks();
+  }
+  wakeupPoller();
+  while (1) {
+    allDone = true;
+    for (j=0; j<numAxes_; j++) {
+      if (!profileAxisUsed_[j]) continue;
+      getIntegerParam(j, motorStatusDone_, &axisDone);
+      if (!axisDone) allDone = false;
+    }
+    if (allDone) break;
+    unlock();
+    epicsEventWaitWithTimeout(softwareProfileAbortEvent_, softwareProfilePeriod_);
+    lock();
+    if (softwareProfileAbort_) {
+      aborted = true;
+      goto done;
+    }
+  }
+
+  setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_EXECUTING);
+  callParamCallbacks();
+  epicsTimeGetCurrent(&startTime);
+  sampleSoftwareProfile(0);
+  point = 1;
+  for (i=1; i<numProfileSetpoints_; i++) {
+    from = profileSetpoints_[i-1];
+    to = profileSetpoints_[i];
+    for (j=0; j<numAxes_; j++) {
+      pAxis = getAxis(j);
+      if (!pAxis || !profileAxisUsed_[j]) continue;
+      distance = pAxis->profilePositions_[to] - pAxis->profilePositions_[from];
+      if (distance == 0.) continue;
+      velocity = fabs(distance) / (profilePointTimes_[to] - profilePointTimes_[from]);
+      status = pAxis->move(profileBasePositions_[j] + pAxis->profilePositions_[to], 0,
+                           0., velocity, velocity/accelerationTime);
+      if (status) {
+        executeOK = false;
+        epicsSnprintf(message, sizeof(message), "Error moving axis %d to point %d", j, to);
+        goto done;
+      }
+    }
+    if (i == 1) wakeupPoller();
+    for (; point<=to; point++) {
+      if (waitSoftwareProfile(&startTime, profilePointTimes_[point])) {
+        aborted = true;
+        goto done;
+      }
+      sampleSoftwareProfile(point);
+    }
+  }
+  asynPrint(pasynUserSelf, ASYN_TRACE_FLOW,
+            "%s:%s: done, numPoints=%d\n",
+            driverName, functionName, numPoints);
+
+  done:
+  if (aborted) {
+    strcpy(message, "Profile move aborted");
+  } else if (!executeOK) {
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+              "%s:%s: %s\n",
+              driverName, functionName, message);
+  }
+  setIntegerParam(profileExecuteStatus_, aborted ? PROFILE_STATUS_ABORT :
+                                         executeOK ? PROFILE_STATUS_SUCCESS : PROFILE_STATUS_FAILURE);
+  setStringParam(profileExecuteMessage_, message);
+  /* Clear execute command.  This is a "busy" record, don't want to do this until execution is complete. */
+  setIntegerParam(profileExecute_, 0);
+  setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_DONE);
+  callParamCallbacks();
+  unlock();
+  return (executeOK && !aborted) ? asynSuccess : asynError;
+}
+
+/** Converts the readbacks of the software profile move to user units and posts them.
+  * The conversion of asynAxisAxis::readbackProfile() is done in place,
+  * so a second readback of the same profile move only posts the arrays again. */
+asynStatus asynAxisController::readbackSoftwareProfile()
+{
+  int axis;
+  int numReadbacks;
+  asynAxisAxis *pAxis;
+  // static const char *functionName = "readbackSoftwareProfile";
+
+  setStringParam(profileReadbackMessage_, "");
+  setIntegerParam(profileReadbackState_, PROFILE_READBACK_BUSY);
+  setIntegerParam(profileReadbackStatus_, PROFILE_STATUS_UNDEFINED);
+  callParamCallbacks();
+
+  getIntegerParam(profileNumReadbacks_, &numReadbacks);
+  setIntegerParam(profileActualPulses_, numReadbacks);
+  for (axis=0; axis<numAxes_; axis++) {
+    pAxis = getAxis(axis);
+    if (!pAxis) continue;
+    if (!softwareProfileConverted_) {
+      pAxis->readbackProfile();
+    } else {
+      doCallbacksFloat64Array(pAxis->profileReadbacks_,       numReadbacks, profileReadbacks_,       axis);
+      doCallbacksFloat64Array(pAxis->profileFollowingErrors_, numReadbacks, profileFollowingErrors_, axis);
+    }
+  }
+  softwareProfileConverted_ = true;
+  postProfileReadbackBlock();
+  setIntegerParam(profileReadbackStatus_, PROFILE_STATUS_SUCCESS);
+  /* Clear readback command.  This is a "busy" record, don't want to do this until readback is complete. */
+  setIntegerParam(profileReadback_, 0);
+  setIntegerParam(profileReadbackState_, PROFILE_READBACK_DONE);
+  callParamCallbacks();
   return asynSuccess;
 }
 
@@ -994,6 +1938,95 @@ asynStatus setIdlePollPeriod(const char *portName, double idlePollPeriod)
 
 
 
+asynStatus setAxisPollPeriods(const char *portName, int axis, double movingPollPeriod, double idlePollPeriod)
+{
+  asynAxisController *pC = NULL;
+  asynAxisAxis *pA = NULL;
+  asynStatus status;
+  static const char *functionName = "setAxisPollPeriods";
+
+  pC = (asynAxisController*) findAsynPortDriver(portName);
+  if (!pC) {
+    printf("%s:%s: Error port %s not found\n", driverName, functionName, portName);
+    return asynError;
+  }
+
+  pA = pC->getAxis(axis);
+  if (!pA) {
+    printf("%s:%s: Error axis %d not found\n", driverName, functionName, axis);
+    return asynError;
+  }
+
+  pC->lock();
+  status = pA->setPollPeriods(movingPollPeriod, idlePollPeriod);
+  pC->wakeupPoller();
+  pC->unlock();
+  return status;
+}
+
+
+asynStatus asynMotorPollerPoolCreate(int numThreads)
+{
+  return asynAxisPollerPool::create(numThreads);
+}
+
+void asynMotorPollerPoolReport(void)
+{
+  asynAxisPollerPool *pPool = asynAxisPollerPool::getPool();
+
+  if (!pPool) {
+    printf("%s: the poller pool has not been created\n", driverName);
+    return;
+  }
+  pPool->report(stdout);
+}
+
+
+asynStatus asynMotorEnableSoftwareProfile(const char *portName, int maxPoints, double period)
+{
+  asynAxisController *pC;
+  asynStatus status;
+  static const char *functionName = "asynMotorEnableSoftwareProfile";
+
+  pC = (asynAxisController*) findAsynPortDriver(portName);
+  if (!pC) {
+    printf("%s:%s: Error port %s not found\n", driverName, functionName, portName);
+    return asynError;
+  }
+
+  pC->lock();
+  status = pC->enableSoftwareProfile(maxPoints, period);
+  pC->unlock();
+  return status;
+}
+
+
+asynStatus asynMotorSetProfileLimits(const char *portName, int axis, double maxVelocity, double maxAcceleration)
+{
+  asynAxisController *pC = NULL;
+  asynAxisAxis *pA = NULL;
+  asynStatus status;
+  static const char *functionName = "asynMotorSetProfileLimits";
+
+  pC = (asynAxisController*) findAsynPortDriver(portName);
+  if (!pC) {
+    printf("%s:%s: Error port %s not found\n", driverName, functionName, portName);
+    return asynError;
+  }
+
+  pA = pC->getAxis(axis);
+  if (!pA) {
+    printf("%s:%s: Error axis %d not found\n", driverName, functionName, axis);
+    return asynError;
+  }
+
+  pC->lock();
+  status = pA->setProfileLimits(maxVelocity, maxAcceleration);
+  pC->unlock();
+  return status;
+}
+
+
 asynStatus asynMotorEnableMoveToHome(const char *portName, int axis, int distance)
 {
   asynAxisController *pC = NULL;
@@ -1047,6 +2080,75 @@ static void setIdlePollPeriodCallFunc(const iocshArgBuf *args)
 }
 
 
+/* setAxisPollPeriods */
+static const iocshArg setAxisPollPeriodsArg0 = {"Controller port name", iocshArgString};
+static const iocshArg setAxisPollPeriodsArg1 = {"Axis number", iocshArgInt};
+static const iocshArg setAxisPollPeriodsArg2 = {"Moving poll period", iocshArgDouble};
+static const iocshArg setAxisPollPeriodsArg3 = {"Idle poll period", iocshArgDouble};
+static const iocshArg * const setAxisPollPeriodsArgs[] = {&setAxisPollPeriodsArg0,
+                                                          &setAxisPollPeriodsArg1,
+                                                          &setAxisPollPeriodsArg2,
+                                                          &setAxisPollPeriodsArg3};
+static const iocshFuncDef setAxisPollPeriodsDef = {"setAxisPollPeriods", 4, setAxisPollPeriodsArgs};
+
+static void setAxisPollPeriodsCallFunc(const iocshArgBuf *args)
+{
+  setAxisPollPeriods(args[0].sval, args[1].ival, args[2].dval, args[3].dval);
+}
+
+
+/* asynMotorPollerPoolCreate */
+static const iocshArg asynMotorPollerPoolCreateArg0 = {"Number of threads", iocshArgInt};
+static const iocshArg * const asynMotorPollerPoolCreateArgs[] = {&asynMotorPollerPoolCreateArg0};
+static const iocshFuncDef asynMotorPollerPoolCreateDef = {"asynMotorPollerPoolCreate", 1, asynMotorPollerPoolCreateArgs};
+
+static void asynMotorPollerPoolCreateCallFunc(const iocshArgBuf *args)
+{
+  asynMotorPollerPoolCreate(args[0].ival);
+}
+
+
+/* asynMotorPollerPoolReport */
+static const iocshFuncDef asynMotorPollerPoolReportDef = {"asynMotorPollerPoolReport", 0, NULL};
+
+static void asynMotorPollerPoolReportCallFunc(const iocshArgBuf *args)
+{
+  asynMotorPollerPoolReport();
+}
+
+
+/* asynMotorEnableSoftwareProfile */
+static const iocshArg asynMotorEnableSoftwareProfileArg0 = {"Controller port name", iocshArgString};
+static const iocshArg asynMotorEnableSoftwareProfileArg1 = {"Max points", iocshArgInt};
+static const iocshArg asynMotorEnableSoftwareProfileArg2 = {"Set point period", iocshArgDouble};
+static const iocshArg * const asynMotorEnableSoftwareProfileArgs[] = {&asynMotorEnableSoftwareProfileArg0,
+                                                                      &asynMotorEnableSoftwareProfileArg1,
+                                                                      &asynMotorEnableSoftwareProfileArg2};
+static const iocshFuncDef asynMotorEnableSoftwareProfileDef = {"asynMotorEnableSoftwareProfile", 3, asynMotorEnableSoftwareProfileArgs};
+
+static void asynMotorEnableSoftwareProfileCallFunc(const iocshArgBuf *args)
+{
+  asynMotorEnableSoftwareProfile(args[0].sval, args[1].ival, args[2].dval);
+}
+
+
+/* asynMotorSetProfileLimits */
+static const iocshArg asynMotorSetProfileLimitsArg0 = {"Controller port name", iocshArgString};
+static const iocshArg asynMotorSetProfileLimitsArg1 = {"Axis number", iocshArgInt};
+static const iocshArg asynMotorSetProfileLimitsArg2 = {"Max velocity", iocshArgDouble};
+static const iocshArg asynMotorSetProfileLimitsArg3 = {"Max acceleration", iocshArgDouble};
+static const iocshArg * const asynMotorSetProfileLimitsArgs[] = {&asynMotorSetProfileLimitsArg0,
+                                                                 &asynMotorSetProfileLimitsArg1,
+                                                                 &asynMotorSetProfileLimitsArg2,
+                                                                 &asynMotorSetProfileLimitsArg3};
+static const iocshFuncDef asynMotorSetProfileLimitsDef = {"asynMotorSetProfileLimits", 4, asynMotorSetProfileLimitsArgs};
+
+static void asynMotorSetProfileLimitsCallFunc(const iocshArgBuf *args)
+{
+  asynMotorSetProfileLimits(args[0].sval, args[1].ival, args[2].dval, args[3].dval);
+}
+
+
 /* asynMotorEnableMoveToHome */
 static const iocshArg asynMotorEnableMoveToHomeArg0 = {"Controller port name", iocshArgString};
 static const iocshArg asynMotorEnableMoveToHomeArg1 = {"Axis number", iocshArgInt};
@@ -1066,6 +2168,11 @@ static void asynAxisControllerRegister(void)
 {
   iocshRegister(&setMovingPollPeriodDef, setMovingPollPeriodCallFunc);
   iocshRegister(&setIdlePollPeriodDef, setIdlePollPeriodCallFunc);
+  iocshRegister(&setAxisPollPeriodsDef, setAxisPollPeriodsCallFunc);
+  iocshRegister(&asynMotorPollerPoolCreateDef, asynMotorPollerPoolCreateCallFunc);
+  iocshRegister(&asynMotorPollerPoolReportDef, asynMotorPollerPoolReportCallFunc);
+  iocshRegister(&asynMotorEnableSoftwareProfileDef, asynMotorEnableSoftwareProfileCallFunc);
+  iocshRegister(&asynMotorSetProfileLimitsDef, asynMotorSetProfileLimitsCallFunc);
   iocshRegister(&enableMoveToHome, enableMoveToHomeCallFunc);
 }
 epicsExportRegistrar(asynAxisControllerRegister);
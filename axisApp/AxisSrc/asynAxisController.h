@@ -9,10 +9,13 @@
 #define asynAxisController_H
 
 #include <epicsEvent.h>
+#include <epicsTime.h>
 #include <epicsTypes.h>
 
 #define MAX_CONTROLLER_STRING_SIZE 256
 #define DEFAULT_CONTROLLER_TIMEOUT 2.0
+/* Default minimum time between the set points of a software profile move */
+#define DEFAULT_SOFTWARE_PROFILE_PERIOD 0.1
 
 /** Strings defining parameters for the driver. 
   * These are the values passed to drvUserCreate. 
@@ -83,6 +86,13 @@
 #define motorSDBDROString               "MOTOR_SDBD_RO"
 #define motorRDBDROString               "MOTOR_RDBD_RO"
 
+/* Timing histograms, see asynAxisHistogram */
+#define motorTimingPollCycleString      "MOTOR_TIMING_POLL_CYCLE"
+#define motorTimingAxisPollString       "MOTOR_TIMING_AXIS_POLL"
+#define motorTimingWriteReadString      "MOTOR_TIMING_WRITE_READ"
+#define motorTimingBucketsString        "MOTOR_TIMING_BUCKETS"
+#define motorTimingResetString          "MOTOR_TIMING_RESET"
+
 /* These are the per-controller parameters for profile moves (coordinated motion) */
 #define profileNumAxesString            "PROFILE_NUM_AXES"
 #define profileNumPointsString          "PROFILE_NUM_POINTS"
@@ -110,6 +120,8 @@
 #define profileReadbackStateString      "PROFILE_READBACK_STATE"
 #define profileReadbackStatusString     "PROFILE_READBACK_STATUS"
 #define profileReadbackMessageString    "PROFILE_READBACK_MESSAGE"
+#define profilePositionsBlockString     "PROFILE_POSITIONS_BLOCK"
+#define profileReadbackBlockString      "PROFILE_READBACK_BLOCK"
 
 /* These are the per-axis parameters for profile moves */
 #define profileUseAxisString            "PROFILE_USE_AXIS"
@@ -156,6 +168,41 @@ typedef struct MotorStatus {
   struct MotorConfigRO MotorConfigRO;
 } MotorStatus;
 
+/** Version of the layout of the ProfileBlock structure */
+#define PROFILE_BLOCK_VERSION 1
+
+/** The arrays of a profile move of all axes in one block, for PROFILE_POSITIONS_BLOCK and
+  * PROFILE_READBACK_BLOCK, so that a client does not need an array transfer per axis and array.
+  * The array of each axis starts stride elements after the one of the previous axis.
+  * The readbacks are not copied: the pointers point to the arrays of the controller.
+  * They are changed when a profile move is executed or read back, which increments generation,
+  * so a client which uses them without holding the port lock checks generation afterwards. */
+typedef struct ProfileBlock {
+  epicsUInt32 version;       /**< PROFILE_BLOCK_VERSION */
+  epicsUInt32 generation;    /**< Incremented each time the readbacks change, not used for positions */
+  int numAxes;               /**< Number of axes in the block */
+  int numPoints;             /**< Number of points of each axis */
+  size_t stride;             /**< Number of elements from the array of one axis to the next */
+  double *positions;         /**< Positions to define, or readbacks, in user units */
+  double *followingErrors;   /**< Following errors in user units, not used for positions */
+} ProfileBlock;
+
+/* Bits in asynAxisAxis::statusDirty_: the parts of the MotorStatus which changed since the last callback */
+#define MOTOR_STATUS_DIRTY_STATUS    (1<<0)  /**< status, which is also copied into MOTOR_STATUS */
+#define MOTOR_STATUS_DIRTY_FLAGS     (1<<1)
+#define MOTOR_STATUS_DIRTY_POSITION  (1<<2)
+#define MOTOR_STATUS_DIRTY_ENCODER   (1<<3)
+#define MOTOR_STATUS_DIRTY_CONFIG_RO (1<<4)
+#define MOTOR_STATUS_DIRTY_ALL       0x1F
+
+/** Where a parameter is kept in the MotorStatus structure.
+  * The controller has one entry for each of its motor parameters. */
+typedef struct MotorStatusMapEntry {
+  epicsUInt32 dirtyMask;     /**< MOTOR_STATUS_DIRTY_xxx bit, 0 if the parameter is not in the MotorStatus */
+  epicsUInt32 bitMask;       /**< Bit in status or flags for integer parameters, 0 for doubles */
+  size_t doubleOffset;       /**< Offset of the double in the MotorStatus */
+} MotorStatusMapEntry;
+
 enum ProfileTimeMode{
   PROFILE_TIME_MODE_FIXED,
   PROFILE_TIME_MODE_ARRAY
@@ -211,7 +258,33 @@ enum LatestCommand {
 #ifdef __cplusplus
 #include <asynPortDriver.h>
 
+/** Number of buckets in an asynAxisHistogram.
+  * The upper limits of the buckets are 10us, 20us, 50us ... 10s, the last bucket
+  * collects everything above. */
+#define MOTOR_TIMING_NUM_BUCKETS 20
+
+/** Histogram of durations with fixed buckets.
+  * It is updated under the port lock, and does not allocate memory,
+  * so that it can stay enabled in production. */
+class epicsShareClass asynAxisHistogram {
+  public:
+  asynAxisHistogram();
+  void reset();
+  void add(double seconds);
+  void add(const epicsTimeStamp *pStartTime);
+  asynStatus read(epicsFloat64 *value, size_t nElements, size_t *nRead);
+  void report(FILE *fp, const char *name);
+  static asynStatus readBuckets(epicsFloat64 *value, size_t nElements, size_t *nRead);
+
+  private:
+  epicsUInt32 counts_[MOTOR_TIMING_NUM_BUCKETS];
+  epicsUInt32 numSamples_;
+  double minSeconds_;
+  double maxSeconds_;
+};
+
 class asynAxisAxis;
+struct asynAxisPollerPoolEntry;
 
 class epicsShareClass asynAxisController : public asynPortDriver {
 
@@ -229,6 +302,7 @@ class epicsShareClass asynAxisController : public asynPortDriver {
   virtual asynStatus writeFloat64Array(asynUser *pasynUser, epicsFloat64 *value, size_t nElements);
   virtual asynStatus readFloat64Array(asynUser *pasynUser, epicsFloat64 *value, size_t nElements, size_t *nRead);
   virtual asynStatus readGenericPointer(asynUser *pasynUser, void *pointer);
+  virtual asynStatus writeGenericPointer(asynUser *pasynUser, void *pointer);
   virtual asynStatus writeOctet(asynUser *pasynUser, const char *value, size_t nChars, size_t *nActual);
   virtual void report(FILE *fp, int details);
 
@@ -237,9 +311,12 @@ class epicsShareClass asynAxisController : public asynPortDriver {
   virtual asynAxisAxis* getAxis(int axisNo);
   virtual asynStatus startPoller(double movingPollPeriod, double idlePollPeriod, int forcedFastPolls);
   virtual asynStatus wakeupPoller();
+  virtual asynStatus setPushMode(double watchdogPollPeriod);
   virtual asynStatus poll();
+  virtual void pollFinished();
   virtual asynStatus setDeferredMoves(bool defer);
   void asynMotorPoller();  // This should be private but is called from C function
+  double pollCycle(bool woken);  // Called from asynMotorPoller() or from the asynAxisPollerPool
   
   /* Functions to deal with moveToHome.*/
   virtual asynStatus startMoveToHomeThread();
@@ -251,6 +328,12 @@ class epicsShareClass asynAxisController : public asynPortDriver {
   virtual asynStatus executeProfile();
   virtual asynStatus abortProfile();
   virtual asynStatus readbackProfile();
+  asynStatus checkProfileKinematics(int numPoints, bool checkLimits, char *message, size_t messageSize);
+  void postProfileReadbackBlock();
+
+  /* The software-timed profile move, for controllers without a profile move of their own */
+  virtual asynStatus enableSoftwareProfile(size_t maxPoints, double period);
+  void softwareProfileThread();  // This should be private but is called from C function
   
   virtual asynStatus setMovingPollPeriod(double movingPollPeriod);
   virtual asynStatus setIdlePollPeriod(double idlePollPeriod);
@@ -334,6 +417,14 @@ class epicsShareClass asynAxisController : public asynPortDriver {
   int motorDefJogAccRO_;
   int motorSDBDRO_;
   int motorRDBDRO_;
+
+  // Timing histograms
+  int motorTimingPollCycle_;
+  int motorTimingAxisPoll_;
+  int motorTimingWriteRead_;
+  int motorTimingBuckets_;
+  int motorTimingReset_;
+
   // These are the per-controller parameters for profile moves
   int profileNumAxes_;
   int profileNumPoints_;
@@ -361,6 +452,8 @@ class epicsShareClass asynAxisController : public asynPortDriver {
   int profileReadbackState_;
   int profileReadbackStatus_;
   int profileReadbackMessage_;
+  int profilePositionsBlock_;
+  int profileReadbackBlock_;
 
   // These are the per-axis parameters for profile moves
   int profileUseAxis_;
@@ -376,12 +469,39 @@ class epicsShareClass asynAxisController : public asynPortDriver {
   double idlePollPeriod_;       /**< The time between polls when no axes are moving */
   double movingPollPeriod_;     /**< The time between polls when any axis is moving */
   int    forcedFastPolls_;      /**< The number of forced fast polls when the poller wakes up */
+  double watchdogPollPeriod_;   /**< Push mode: the time between polls when an axis is not moving, 0 without push mode */
+  struct asynAxisPollerPoolEntry *pPollerPoolEntry_; /**< Entry in the asynAxisPollerPool, NULL with a poller thread of its own */
+  int *pollDueAxes_;            /**< The numbers of the axes which are polled in this cycle, set before poll() is called */
+  int numPollDueAxes_;          /**< The number of entries in pollDueAxes_ */
  
+  MotorStatusMapEntry *motorStatusMap_; /**< Indexed by parameter number - FIRST_MOTOR_PARAM */
+  const MotorStatusMapEntry *getMotorStatusMapEntry(int function);
+  void setMotorStatusMapEntry(int function, epicsUInt32 dirtyMask, epicsUInt32 bitMask, size_t doubleOffset);
+
   size_t maxProfilePoints_;     /**< Maximum number of profile points */
   double *profileTimes_;        /**< Array of times per profile point */
+  double *profileInverseTimes_;     /**< 1/profileTimes_, for checkProfileKinematics() */
+  double *profileInverseMidTimes_;  /**< Inverse mean time of the elements before and after each point */
+  double *profileReadbackBuffer_;   /**< The readbacks and then the following errors of all axes, maxProfilePoints_ per axis */
+  epicsUInt32 profileReadbackGeneration_; /**< ProfileBlock::generation, incremented when the readbacks change */
+
+  bool softwareProfile_;            /**< The profile move is run by softwareProfileThread() */
+  double softwareProfilePeriod_;    /**< Minimum time between the set points of the software profile move */
+  int numProfileSetpoints_;         /**< Number of set points after resampling, 0 if the build failed */
+  int *profileSetpoints_;           /**< Index of the profile point of each set point */
+  double *profilePointTimes_;       /**< Time of each profile point from the start of the profile move */
+  double *profileBasePositions_;    /**< Per axis, the positions are relative to this in PROFILE_MOVE_MODE_RELATIVE */
+  bool *profileAxisUsed_;           /**< Per axis, the axis moves in the running software profile move */
+  bool softwareProfileAbort_;       /**< abortProfile() has been called */
+  bool softwareProfileConverted_;   /**< The readbacks have been converted to user units */
+  epicsEventId softwareProfileExecuteEvent_; /**< Wakes up softwareProfileThread() */
+  epicsEventId softwareProfileAbortEvent_;   /**< Ends the waits of the software profile move */
 
   int moveToHomeAxis_;
 
+  asynAxisHistogram pollCycleHistogram_;  /**< Duration of a cycle of asynMotorPoller() */
+  asynAxisHistogram writeReadHistogram_;  /**< Round trip time of writeReadController() */
+
   /* These are convenience functions for controllers that use asynOctet interfaces to the hardware */
   asynStatus writeController();
   asynStatus writeController(const char *output, double timeout);
@@ -391,7 +511,16 @@ class epicsShareClass asynAxisController : public asynPortDriver {
   char outString_[MAX_CONTROLLER_STRING_SIZE];
   char inString_[MAX_CONTROLLER_STRING_SIZE];
 
+  private:
+  asynStatus buildSoftwareProfile();
+  asynStatus runSoftwareProfile();
+  asynStatus readbackSoftwareProfile();
+  bool waitSoftwareProfile(const epicsTimeStamp *pStartTime, double time);
+  void getProfileReadbackBlock(ProfileBlock *pBlock);
+  void sampleSoftwareProfile(int point);
+
   friend class asynAxisAxis;
+  friend class asynAxisPollerPool;
 };
 #define NUM_MOTOR_DRIVER_PARAMS (&LAST_MOTOR_PARAM - &FIRST_MOTOR_PARAM + 1)
 
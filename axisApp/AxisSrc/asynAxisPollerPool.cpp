@@ -0,0 +1,223 @@
+/* asynAxisPollerPool.cpp
+ *
+ * This file defines a pool of poller threads which is shared by all
+ * asynAxisControllers, instead of one poller thread per controller.
+ * The pool is created with the iocsh command asynMotorPollerPoolCreate(),
+ * which must be called before the controllers are configured.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <epicsThread.h>
+#include <epicsStdio.h>
+
+#include <asynPortDriver.h>
+#define epicsExportSharedSymbols
+#include <shareLib.h>
+#include "asynAxisController.h"
+#include "asynAxisPollerPool.h"
+
+static const char *driverName = "asynAxisPollerPool";
+
+asynAxisPollerPool *asynAxisPollerPool::pPool_ = NULL;
+
+static void asynAxisPollerPoolWorkerC(void *drvPvt)
+{
+  asynAxisPollerPool *pPool = (asynAxisPollerPool *)drvPvt;
+  pPool->worker();
+}
+
+/** Creates the pool of poller threads.
+  * Controllers which start their poller after this use the pool.
+  * \param[in] numThreads The number of worker threads. */
+asynStatus asynAxisPollerPool::create(int numThreads)
+{
+  static const char *functionName = "create";
+
+  if (pPool_) {
+    printf("%s:%s: Error, the poller pool already exists\n", driverName, functionName);
+    return asynError;
+  }
+  if (numThreads < 1) {
+    printf("%s:%s: Error, invalid number of threads %d\n", driverName, functionName, numThreads);
+    return asynError;
+  }
+  pPool_ = new asynAxisPollerPool(numThreads);
+  return asynSuccess;
+}
+
+/** Returns the pool of poller threads, NULL if it has not been created. */
+asynAxisPollerPool *asynAxisPollerPool::getPool()
+{
+  return pPool_;
+}
+
+asynAxisPollerPool::asynAxisPollerPool(int numThreads)
+  : numThreads_(numThreads)
+{
+  char threadName[20];
+  int i;
+
+  ellInit(&schedule_);
+  lock_ = epicsMutexMustCreate();
+  scheduleChanged_ = epicsEventMustCreate(epicsEventEmpty);
+  for (i=0; i<numThreads; i++) {
+    epicsSnprintf(threadName, sizeof(threadName), "motorPoller-%d", i);
+    epicsThreadCreate(threadName,
+                      epicsThreadPriorityLow,
+                      epicsThreadGetStackSize(epicsThreadStackMedium),
+                      (EPICSTHREADFUNC)asynAxisPollerPoolWorkerC, (void *)this);
+  }
+}
+
+/** Adds a controller to the pool, its first poll cycle is due immediately.
+  * Called from asynAxisController::startPoller().
+  * \param[in] pController The controller. */
+asynAxisPollerPoolEntry *asynAxisPollerPool::add(asynAxisController *pController)
+{
+  asynAxisPollerPoolEntry *pEntry;
+
+  pEntry = (asynAxisPollerPoolEntry *)calloc(1, sizeof(asynAxisPollerPoolEntry));
+  pEntry->pController = pController;
+  epicsTimeGetCurrent(&pEntry->dueTime);
+  epicsMutexLock(lock_);
+  schedule(pEntry);
+  epicsMutexUnlock(lock_);
+  epicsEventSignal(scheduleChanged_);
+  return pEntry;
+}
+
+/** Makes the poll cycle of a controller due immediately.
+  * Called from asynAxisController::wakeupPoller().
+  * \param[in] pEntry The entry returned from add(). */
+void asynAxisPollerPool::wakeup(asynAxisPollerPoolEntry *pEntry)
+{
+  epicsMutexLock(lock_);
+  if (pEntry->running) {
+    /* The worker reschedules it when the cycle is done */
+    pEntry->wakeupPending = true;
+    epicsMutexUnlock(lock_);
+    return;
+  }
+  if (!pEntry->inSchedule) {
+    /* The controller is shutting down, its entry has been retired */
+    epicsMutexUnlock(lock_);
+    return;
+  }
+  ellDelete(&schedule_, &pEntry->node);
+  pEntry->inSchedule = false;
+  pEntry->waitForWakeup = false;
+  epicsTimeGetCurrent(&pEntry->dueTime);
+  schedule(pEntry);
+  epicsMutexUnlock(lock_);
+  epicsEventSignal(scheduleChanged_);
+}
+
+/** Inserts an entry into the schedule, after all entries which are due earlier.
+  * Must be called with lock_ held. */
+void asynAxisPollerPool::schedule(asynAxisPollerPoolEntry *pEntry)
+{
+  asynAxisPollerPoolEntry *pNext;
+
+  for (pNext = (asynAxisPollerPoolEntry *)ellFirst(&schedule_); pNext;
+       pNext = (asynAxisPollerPoolEntry *)ellNext(&pNext->node)) {
+    if (pEntry->waitForWakeup) continue;
+    if (pNext->waitForWakeup) break;
+    if (epicsTimeLessThan(&pEntry->dueTime, &pNext->dueTime)) break;
+  }
+  if (pNext) ellInsert(&schedule_, ellPrevious(&pNext->node), &pEntry->node);
+  else       ellAdd(&schedule_, &pEntry->node);
+  pEntry->inSchedule = true;
+}
+
+/** The function which runs in each thread of the pool.
+  * Takes the first controller of the schedule when it is due, and runs its poll cycle.
+  * The controller is not in the schedule while the cycle is running, so that no other
+  * worker polls the same controller at the same time. */
+void asynAxisPollerPool::worker()
+{
+  asynAxisPollerPoolEntry *pEntry;
+  asynAxisPollerPoolEntry *pNext;
+  asynAxisController *pController;
+  epicsTimeStamp nowTime;
+  double delay;
+  double timeout;
+  bool woken;
+
+  epicsMutexLock(lock_);
+  while (1) {
+    pEntry = (asynAxisPollerPoolEntry *)ellFirst(&schedule_);
+    if (!pEntry || pEntry->waitForWakeup) {
+      epicsMutexUnlock(lock_);
+      epicsEventWait(scheduleChanged_);
+      epicsMutexLock(lock_);
+      continue;
+    }
+    epicsTimeGetCurrent(&nowTime);
+    delay = epicsTimeDiffInSeconds(&pEntry->dueTime, &nowTime);
+    if (delay > 0.0) {
+      epicsMutexUnlock(lock_);
+      epicsEventWaitWithTimeout(scheduleChanged_, delay);
+      epicsMutexLock(lock_);
+      continue;
+    }
+    ellDelete(&schedule_, &pEntry->node);
+    pEntry->inSchedule = false;
+    pEntry->running = true;
+    pEntry->wakeupPending = false;
+    /* Hand the next due controller over to another idle worker */
+    pNext = (asynAxisPollerPoolEntry *)ellFirst(&schedule_);
+    if (pNext && !pNext->waitForWakeup &&
+        !epicsTimeGreaterThan(&pNext->dueTime, &nowTime)) {
+      epicsEventSignal(scheduleChanged_);
+    }
+    epicsMutexUnlock(lock_);
+
+    pController = pEntry->pController;
+    woken = (epicsEventTryWait(pController->pollEventId_) == epicsEventWaitOK);
+    timeout = pController->pollCycle(woken);
+
+    epicsMutexLock(lock_);
+    pEntry->running = false;
+    if (timeout < 0.0) {
+      /* The controller is shutting down, it is not scheduled again,
+       * and wakeup() leaves the retired entry alone */
+      continue;
+    }
+    epicsTimeGetCurrent(&pEntry->dueTime);
+    if (pEntry->wakeupPending) {
+      pEntry->waitForWakeup = false;
+    } else if (timeout == 0.0) {
+      pEntry->waitForWakeup = true;
+    } else {
+      pEntry->waitForWakeup = false;
+      epicsTimeAddSeconds(&pEntry->dueTime, timeout);
+    }
+    schedule(pEntry);
+    /* Another worker may be waiting for a later due time */
+    epicsEventSignal(scheduleChanged_);
+  }
+}
+
+/** Prints the schedule of the pool.
+  * \param[in] fp FILE pointer. */
+void asynAxisPollerPool::report(FILE *fp)
+{
+  asynAxisPollerPoolEntry *pEntry;
+  epicsTimeStamp nowTime;
+
+  epicsMutexLock(lock_);
+  epicsTimeGetCurrent(&nowTime);
+  fprintf(fp, "Motor poller pool, %d threads, %d controllers scheduled\n",
+          numThreads_, ellCount(&schedule_));
+  for (pEntry = (asynAxisPollerPoolEntry *)ellFirst(&schedule_); pEntry;
+       pEntry = (asynAxisPollerPoolEntry *)ellNext(&pEntry->node)) {
+    if (pEntry->waitForWakeup) {
+      fprintf(fp, "  %s: waiting for wakeup\n", pEntry->pController->portName);
+    } else {
+      fprintf(fp, "  %s: due in %f s\n", pEntry->pController->portName,
+              epicsTimeDiffInSeconds(&pEntry->dueTime, &nowTime));
+    }
+  }
+  epicsMutexUnlock(lock_);
+}
@@ -0,0 +1,58 @@
+/* asynAxisPollerPool.h
+ *
+ * This file defines a pool of poller threads which is shared by all
+ * asynAxisControllers, instead of one poller thread per controller.
+ */
+#ifndef asynAxisPollerPool_H
+#define asynAxisPollerPool_H
+
+#include <stdio.h>
+
+#include <ellLib.h>
+#include <epicsEvent.h>
+#include <epicsMutex.h>
+#include <epicsTime.h>
+
+#ifdef __cplusplus
+#include <asynDriver.h>
+#include <shareLib.h>
+
+class asynAxisController;
+
+/** A controller in the schedule of the asynAxisPollerPool. */
+typedef struct asynAxisPollerPoolEntry {
+  ELLNODE node;                    /**< Must be first, the schedule is an ELLLIST */
+  asynAxisController *pController;
+  epicsTimeStamp dueTime;          /**< Time of the next poll cycle */
+  bool waitForWakeup;              /**< Poll only after a wakeup, dueTime is not used */
+  bool running;                    /**< A worker is running a poll cycle, the entry is not in the schedule */
+  bool wakeupPending;              /**< A wakeup came in while the poll cycle was running */
+  bool inSchedule;                 /**< The entry is in the schedule, not after the controller shut down */
+} asynAxisPollerPoolEntry;
+
+/** Pool of threads which run the poll cycles of all controllers.
+  * The controllers are kept in a list which is sorted by the time of
+  * their next poll cycle. An idle worker takes the first controller when it is due,
+  * and runs asynAxisController::pollCycle() for it, so that the poll() methods are
+  * called in the same way, and with the same locking, as from a thread of its own. */
+class epicsShareClass asynAxisPollerPool {
+  public:
+  static asynStatus create(int numThreads);
+  static asynAxisPollerPool *getPool();
+  asynAxisPollerPoolEntry *add(asynAxisController *pController);
+  void wakeup(asynAxisPollerPoolEntry *pEntry);
+  void report(FILE *fp);
+  void worker();
+
+  private:
+  asynAxisPollerPool(int numThreads);
+  void schedule(asynAxisPollerPoolEntry *pEntry);
+  static asynAxisPollerPool *pPool_;
+  int numThreads_;
+  ELLLIST schedule_;               /**< Controllers which are not running, sorted by dueTime */
+  epicsMutexId lock_;              /**< Protects schedule_ and the entries */
+  epicsEventId scheduleChanged_;   /**< Wakes up an idle worker */
+};
+
+#endif /* _cplusplus */
+#endif /* asynAxisPollerPool_H */
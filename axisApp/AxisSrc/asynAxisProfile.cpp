@@ -0,0 +1,155 @@
+/* asynAxisProfile.cpp
+ *
+ * This file defines the kinematics check of profile moves.
+ * Element i of a profile goes from point i to point i+1 in times[i].
+ * Its velocity is (positions[i+1] - positions[i]) / times[i], and the
+ * acceleration at point i is the change of the velocity from element i-1
+ * to element i, divided by the mean of their times.
+ */
+#include <math.h>
+
+#include <epicsMath.h>
+
+#define epicsExportSharedSymbols
+#include <shareLib.h>
+#include "asynAxisProfile.h"
+
+/* Number of independent maxima, so that the loops do not wait for the previous comparison */
+#define PROFILE_LANES 4
+
+/** Computes the inverse times of the elements and of the points of a profile,
+  * once for all axes.
+  * \param[in] times The time of each element, numPoints-1 of them must be positive.
+  * \param[in] numPoints The number of points.
+  * \param[out] inverseTimes 1/times[i] for each element.
+  * \param[out] inverseMidTimes 2/(times[i-1]+times[i]) for each point between two elements,
+  *             inverseMidTimes[0] is 0. */
+void asynAxisProfileInverseTimes(const double *times, int numPoints,
+                                 double *inverseTimes, double *inverseMidTimes)
+{
+  int i;
+
+  for (i=0; i<numPoints-1; i++) {
+    inverseTimes[i] = 1.0 / times[i];
+  }
+  inverseMidTimes[0] = 0.0;
+  for (i=1; i<numPoints-1; i++) {
+    inverseMidTimes[i] = 2.0 / (times[i-1] + times[i]);
+  }
+}
+
+/** Computes the largest velocity and acceleration and the range of positions of one axis.
+  * \param[in] positions The positions of the axis.
+  * \param[in] inverseTimes From asynAxisProfileInverseTimes().
+  * \param[in] inverseMidTimes From asynAxisProfileInverseTimes().
+  * \param[in] numPoints The number of points, at least 1.
+  * \param[out] pKinematics The results. */
+void asynAxisProfileKinematicsCompute(const double *positions,
+                                      const double *inverseTimes,
+                                      const double *inverseMidTimes,
+                                      int numPoints,
+                                      asynAxisProfileKinematics *pKinematics)
+{
+  double maxVelocity[PROFILE_LANES];
+  double maxAcceleration[PROFILE_LANES];
+  double minPosition[PROFILE_LANES];
+  double maxPosition[PROFILE_LANES];
+  double velocity, acceleration, position;
+  int numElements = numPoints - 1;
+  int i, lane;
+
+  for (lane=0; lane<PROFILE_LANES; lane++) {
+    maxVelocity[lane] = 0.0;
+    maxAcceleration[lane] = 0.0;
+    minPosition[lane] = positions[0];
+    maxPosition[lane] = positions[0];
+  }
+  if (numElements > 0) {
+    maxVelocity[0] = fabs((positions[1] - positions[0]) * inverseTimes[0]);
+    minPosition[0] = (positions[1] < positions[0]) ? positions[1] : positions[0];
+    maxPosition[0] = (positions[1] > positions[0]) ? positions[1] : positions[0];
+  }
+
+  /* From element 1 on, the velocity of each element, the position at its end, and the
+   * acceleration at its start.  The velocity of the element before is computed again,
+   * rather than carried over, so that the elements do not depend on each other */
+  for (i=1; i+PROFILE_LANES<=numElements; i+=PROFILE_LANES) {
+    for (lane=0; lane<PROFILE_LANES; lane++) {
+      position = positions[i+lane+1];
+      velocity = (position - positions[i+lane]) * inverseTimes[i+lane];
+      acceleration = fabs((velocity - (positions[i+lane] - positions[i+lane-1]) * inverseTimes[i+lane-1]) *
+                          inverseMidTimes[i+lane]);
+      velocity = fabs(velocity);
+      maxVelocity[lane] = (velocity > maxVelocity[lane]) ? velocity : maxVelocity[lane];
+      maxAcceleration[lane] = (acceleration > maxAcceleration[lane]) ? acceleration : maxAcceleration[lane];
+      minPosition[lane] = (position < minPosition[lane]) ? position : minPosition[lane];
+      maxPosition[lane] = (position > maxPosition[lane]) ? position : maxPosition[lane];
+    }
+  }
+  for (; i<numElements; i++) {
+    position = positions[i+1];
+    velocity = (position - positions[i]) * inverseTimes[i];
+    acceleration = fabs((velocity - (positions[i] - positions[i-1]) * inverseTimes[i-1]) * inverseMidTimes[i]);
+    velocity = fabs(velocity);
+    maxVelocity[0] = (velocity > maxVelocity[0]) ? velocity : maxVelocity[0];
+    maxAcceleration[0] = (acceleration > maxAcceleration[0]) ? acceleration : maxAcceleration[0];
+    minPosition[0] = (position < minPosition[0]) ? position : minPosition[0];
+    maxPosition[0] = (position > maxPosition[0]) ? position : maxPosition[0];
+  }
+
+  pKinematics->maxVelocity = maxVelocity[0];
+  pKinematics->maxAcceleration = maxAcceleration[0];
+  pKinematics->minPosition = minPosition[0];
+  pKinematics->maxPosition = maxPosition[0];
+  for (lane=1; lane<PROFILE_LANES; lane++) {
+    if (maxVelocity[lane] > pKinematics->maxVelocity) pKinematics->maxVelocity = maxVelocity[lane];
+    if (maxAcceleration[lane] > pKinematics->maxAcceleration) pKinematics->maxAcceleration = maxAcceleration[lane];
+    if (minPosition[lane] < pKinematics->minPosition) pKinematics->minPosition = minPosition[lane];
+    if (maxPosition[lane] > pKinematics->maxPosition) pKinematics->maxPosition = maxPosition[lane];
+  }
+}
+
+/** Finds the first value which is NaN or infinite.
+  * The maxima of asynAxisProfileKinematicsCompute() do not see NaN, because every
+  * comparison with NaN is false, so the profile must be checked for these first.
+  * \param[in] values The positions of an axis, or the times.
+  * \param[in] numValues The number of values.
+  * Returns the index of the value, or -1 if all values are finite. */
+int asynAxisProfileFindNonFinite(const double *values, int numValues)
+{
+  int i;
+
+  for (i=0; i<numValues; i++) {
+    if (!isfinite(values[i])) return i;
+  }
+  return -1;
+}
+
+/** Finds the first point where the velocity or the acceleration of one axis is too high.
+  * Only called to report a violation which asynAxisProfileKinematicsCompute() found.
+  * \param[in] positions The positions of the axis.
+  * \param[in] inverseTimes From asynAxisProfileInverseTimes().
+  * \param[in] inverseMidTimes From asynAxisProfileInverseTimes().
+  * \param[in] numPoints The number of points.
+  * \param[in] maxVelocity The velocity limit, <= 0 for none.
+  * \param[in] maxAcceleration The acceleration limit, <= 0 for none.
+  * Returns the point at the end of the element which is too fast, or the point where
+  * the acceleration is too high, or -1 if there is none. */
+int asynAxisProfileFindViolation(const double *positions,
+                                 const double *inverseTimes,
+                                 const double *inverseMidTimes,
+                                 int numPoints,
+                                 double maxVelocity, double maxAcceleration)
+{
+  double velocity, previousVelocity = 0.0;
+  int i;
+
+  for (i=0; i<numPoints-1; i++) {
+    velocity = (positions[i+1] - positions[i]) * inverseTimes[i];
+    if ((maxVelocity > 0.0) && (fabs(velocity) > maxVelocity)) return i+1;
+    if ((i > 0) && (maxAcceleration > 0.0) &&
+        (fabs((velocity - previousVelocity) * inverseMidTimes[i]) > maxAcceleration)) return i;
+    previousVelocity = velocity;
+  }
+  return -1;
+}
@@ -0,0 +1,43 @@
+/* asynAxisProfile.h
+ *
+ * This file defines the kinematics check of profile moves, which is shared
+ * by asynAxisController and the drivers.
+ * The profile is kept as a struct of arrays: one array of positions per axis,
+ * and the inverse element times, which are the same for all axes.  The loops
+ * over the points have no branches, so that the compiler can vectorize them.
+ */
+#ifndef asynAxisProfile_H
+#define asynAxisProfile_H
+
+#include <shareLib.h>
+
+/** Largest values of one axis in a profile, in controller units. */
+typedef struct asynAxisProfileKinematics {
+  double maxVelocity;        /**< Largest |velocity| of an element */
+  double maxAcceleration;    /**< Largest |acceleration| at a point between two elements */
+  double minPosition;
+  double maxPosition;
+} asynAxisProfileKinematics;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+epicsShareFunc void asynAxisProfileInverseTimes(const double *times, int numPoints,
+                                                double *inverseTimes, double *inverseMidTimes);
+epicsShareFunc void asynAxisProfileKinematicsCompute(const double *positions,
+                                                     const double *inverseTimes,
+                                                     const double *inverseMidTimes,
+                                                     int numPoints,
+                                                     asynAxisProfileKinematics *pKinematics);
+epicsShareFunc int asynAxisProfileFindNonFinite(const double *values, int numValues);
+epicsShareFunc int asynAxisProfileFindViolation(const double *positions,
+                                                const double *inverseTimes,
+                                                const double *inverseMidTimes,
+                                                int numPoints,
+                                                double maxVelocity, double maxAcceleration);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* asynAxisProfile_H */
@@ -0,0 +1,134 @@
+/* Program to measure the time of the kinematics check which
+ * asynAxisController::checkProfileKinematics() does on every build of a software profile
+ * move or a PI wave generator profile.
+ * Compares a straightforward loop over the points, which divides by the times and
+ * carries the velocity from one point to the next, with asynAxisProfileKinematicsCompute(),
+ * and checks that both find the same results.
+ *
+ * Usage: asynAxisProfileBench [numBuilds [numPoints [numAxes]]]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <epicsTime.h>
+
+#include "asynAxisProfile.h"
+
+#define DEFAULT_NUM_BUILDS 20
+#define DEFAULT_NUM_POINTS 100000
+#define DEFAULT_NUM_AXES 6
+#define MAX_AXES 32
+
+/* The check as it would be written point by point */
+static void referenceKinematics(const double *positions, const double *times, int numPoints,
+                                asynAxisProfileKinematics *pKinematics)
+{
+  double velocity, previousVelocity = 0.0, acceleration;
+  int i;
+
+  pKinematics->maxVelocity = 0.0;
+  pKinematics->maxAcceleration = 0.0;
+  pKinematics->minPosition = positions[0];
+  pKinematics->maxPosition = positions[0];
+  for (i=0; i<numPoints-1; i++) {
+    velocity = (positions[i+1] - positions[i]) / times[i];
+    if (fabs(velocity) > pKinematics->maxVelocity) pKinematics->maxVelocity = fabs(velocity);
+    if (i > 0) {
+      acceleration = (velocity - previousVelocity) / ((times[i-1] + times[i]) / 2.0);
+      if (fabs(acceleration) > pKinematics->maxAcceleration) pKinematics->maxAcceleration = fabs(acceleration);
+    }
+    if (positions[i+1] < pKinematics->minPosition) pKinematics->minPosition = positions[i+1];
+    if (positions[i+1] > pKinematics->maxPosition) pKinematics->maxPosition = positions[i+1];
+    previousVelocity = velocity;
+  }
+}
+
+static double elapsed(epicsTimeStamp *pStart)
+{
+  epicsTimeStamp now;
+
+  epicsTimeGetCurrent(&now);
+  return epicsTimeDiffInSeconds(&now, pStart);
+}
+
+static int sameValue(double a, double b)
+{
+  return fabs(a - b) <= 1e-9 * (fabs(a) + fabs(b) + 1.0);
+}
+
+int main(int argc, char *argv[])
+{
+  int numBuilds = DEFAULT_NUM_BUILDS;
+  int numPoints = DEFAULT_NUM_POINTS;
+  int numAxes = DEFAULT_NUM_AXES;
+  double *times, *inverseTimes, *inverseMidTimes;
+  double *positions[MAX_AXES];
+  asynAxisProfileKinematics reference[MAX_AXES];
+  asynAxisProfileKinematics kinematics[MAX_AXES];
+  double referenceTime = 0., kinematicsTime = 0.;
+  epicsTimeStamp start;
+  int build, axis, i;
+
+  if (argc > 1) numBuilds = atoi(argv[1]);
+  if (argc > 2) numPoints = atoi(argv[2]);
+  if (argc > 3) numAxes = atoi(argv[3]);
+  if (numBuilds < 1 || numPoints < 2 || numAxes < 1 || numAxes > MAX_AXES) {
+    printf("Usage: %s [numBuilds [numPoints [numAxes]]], numPoints >= 2, numAxes 1 to %d\n",
+           argv[0], MAX_AXES);
+    return 1;
+  }
+
+  /* Times which vary a little, and a different sine wave on each axis */
+  times           = (double *)calloc(numPoints, sizeof(double));
+  inverseTimes    = (double *)calloc(numPoints, sizeof(double));
+  inverseMidTimes = (double *)calloc(numPoints, sizeof(double));
+  for (i=0; i<numPoints; i++) {
+    times[i] = 0.001 * (1.0 + 0.1*sin(0.001*i));
+  }
+  for (axis=0; axis<numAxes; axis++) {
+    positions[axis] = (double *)calloc(numPoints, sizeof(double));
+    for (i=0; i<numPoints; i++) {
+      positions[axis][i] = 1000.0 * (axis+1) * sin(0.0001 * (axis+1) * i + axis);
+    }
+  }
+
+  for (build=0; build<numBuilds; build++) {
+    epicsTimeGetCurrent(&start);
+    for (axis=0; axis<numAxes; axis++) {
+      referenceKinematics(positions[axis], times, numPoints, &reference[axis]);
+    }
+    referenceTime += elapsed(&start);
+
+    epicsTimeGetCurrent(&start);
+    asynAxisProfileInverseTimes(times, numPoints, inverseTimes, inverseMidTimes);
+    for (axis=0; axis<numAxes; axis++) {
+      asynAxisProfileKinematicsCompute(positions[axis], inverseTimes, inverseMidTimes,
+                                       numPoints, &kinematics[axis]);
+    }
+    kinematicsTime += elapsed(&start);
+  }
+
+  printf("%d points, %d axes, %d builds\n", numPoints, numAxes, numBuilds);
+  printf("%-24s %8.3f ms per build\n", "point by point", 1e3*referenceTime/numBuilds);
+  printf("%-24s %8.3f ms per build\n", "struct of arrays", 1e3*kinematicsTime/numBuilds);
+
+  for (axis=0; axis<numAxes; axis++) {
+    if (!sameValue(reference[axis].maxVelocity,     kinematics[axis].maxVelocity) ||
+        !sameValue(reference[axis].maxAcceleration, kinematics[axis].maxAcceleration) ||
+        (reference[axis].minPosition != kinematics[axis].minPosition) ||
+        (reference[axis].maxPosition != kinematics[axis].maxPosition)) {
+      printf("Error, axis %d: velocity %g/%g, acceleration %g/%g, positions %g/%g to %g/%g\n", axis,
+             reference[axis].maxVelocity, kinematics[axis].maxVelocity,
+             reference[axis].maxAcceleration, kinematics[axis].maxAcceleration,
+             reference[axis].minPosition, kinematics[axis].minPosition,
+             reference[axis].maxPosition, kinematics[axis].maxPosition);
+      return 1;
+    }
+    printf("axis %d: maxVelocity=%f maxAcceleration=%f positions %f to %f\n", axis,
+           kinematics[axis].maxVelocity, kinematics[axis].maxAcceleration,
+           kinematics[axis].minPosition, kinematics[axis].maxPosition);
+  }
+  printf("Both checks find the same results\n");
+  return 0;
+}
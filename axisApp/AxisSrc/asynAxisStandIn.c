@@ -0,0 +1,76 @@
+/* asynAxisStandIn.c
+ *
+ * This file defines the stand-in server of the benches.  It listens on a free
+ * port of the loopback interface and passes the connections one after the
+ * other to the connection function of the bench.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include <epicsThread.h>
+
+#define epicsExportSharedSymbols
+#include <shareLib.h>
+#include "asynAxisStandIn.h"
+
+typedef struct standInServer {
+  SOCKET listenSock;
+  asynAxisStandInConnection connection;
+  void *userPvt;
+} standInServer;
+
+static void standInAccept(void *arg)
+{
+  standInServer *pServer = (standInServer *)arg;
+  SOCKET sock;
+  osiSockAddr addr;
+  osiSocklen_t addrLen;
+
+  while (1) {
+    addrLen = sizeof(addr.sa);
+    sock = epicsSocketAccept(pServer->listenSock, &addr.sa, &addrLen);
+    if (sock == INVALID_SOCKET) break;
+    pServer->connection(sock, pServer->userPvt);
+  }
+  epicsSocketDestroy(pServer->listenSock);
+  free(pServer);
+}
+
+/** Starts a stand-in server on the loopback interface.
+  * \param[in] threadName The name of the thread which accepts the connections.
+  * \param[in] stackSize The stack size of this thread.
+  * \param[in] connection The function which serves a connection, it is called
+  *            in this thread, so the next connection is accepted when it returns.
+  * \param[in] userPvt Passed to connection.
+  * \return The port of the server, or -1 on error. */
+int asynAxisStandInStart(const char *threadName, unsigned int stackSize,
+                         asynAxisStandInConnection connection, void *userPvt)
+{
+  standInServer *pServer;
+  osiSockAddr addr;
+  osiSocklen_t addrLen = sizeof(addr.ia);
+
+  pServer = (standInServer *)calloc(1, sizeof(standInServer));
+  if (!pServer) return -1;
+  pServer->connection = connection;
+  pServer->userPvt = userPvt;
+  pServer->listenSock = epicsSocketCreate(AF_INET, SOCK_STREAM, 0);
+  if (pServer->listenSock == INVALID_SOCKET) {
+    free(pServer);
+    return -1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.ia.sin_family = AF_INET;
+  addr.ia.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.ia.sin_port = 0;
+  if (bind(pServer->listenSock, &addr.sa, sizeof(addr.ia)) ||
+      listen(pServer->listenSock, 10) ||
+      getsockname(pServer->listenSock, &addr.sa, &addrLen) ||
+      !epicsThreadCreate(threadName, epicsThreadPriorityMedium, stackSize,
+                         standInAccept, pServer)) {
+    epicsSocketDestroy(pServer->listenSock);
+    free(pServer);
+    return -1;
+  }
+  return ntohs(addr.ia.sin_port);
+}
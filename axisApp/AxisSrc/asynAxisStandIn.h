@@ -0,0 +1,25 @@
+/* asynAxisStandIn.h
+ *
+ * This file defines the stand-in server of the benches, which replaces a
+ * controller by a server on the loopback interface.
+ */
+#ifndef asynAxisStandIn_H
+#define asynAxisStandIn_H
+
+#include <shareLib.h>
+#include <osiSock.h>
+
+/** Serves one connection of a stand-in server and destroys its socket. */
+typedef void (*asynAxisStandInConnection)(SOCKET sock, void *userPvt);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+epicsShareFunc int asynAxisStandInStart(const char *threadName, unsigned int stackSize,
+                                        asynAxisStandInConnection connection, void *userPvt);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* asynAxisStandIn_H */
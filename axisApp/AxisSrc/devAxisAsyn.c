@@ -58,6 +58,8 @@
 #include <devSup.h>
 #include <alarm.h>
 #include <epicsEvent.h>
+#include <epicsMutex.h>
+#include <callback.h>
 #include <cantProceed.h> /* !! for callocMustSucceed() */
 #include <dbEvent.h>
 
@@ -85,6 +87,7 @@ static RTN_STATUS build_trans( motor_cmnd, double *, struct axisRecord *);
 static RTN_STATUS end_trans(struct axisRecord *);
 static void asynCallback(asynUser *);
 static void statusCallback(void *, asynUser *, void *);
+static void statusProcessCallback(CALLBACK *);
 
 typedef enum {int32Type, float64Type, float64ArrayType} interfaceType;
 
@@ -161,6 +164,14 @@ typedef struct
     void *registrarPvt;
     epicsEventId initEvent;
     int driverReasons[NUM_MOTOR_COMMANDS];
+    /* The latest status from the driver. statusCallback() stores it here
+       without taking the record lock, the record copies it into status
+       when it processes. snapshotLock is only held while copying */
+    epicsMutexId snapshotLock;
+    struct MotorStatus snapshot;
+    int snapshotNew;
+    int processQueued;
+    CALLBACK processCallback;
 } motorAsynPvt;
 
 
@@ -317,6 +328,10 @@ static long init_record(struct axisRecord * pmr )
     pPvt->pasynUser = pasynUser;
     pPvt->pmr = pmr;
     pmr->dpvt = pPvt;
+    pPvt->snapshotLock = epicsMutexMustCreate();
+    callbackSetCallback(statusProcessCallback, &pPvt->processCallback);
+    callbackSetPriority(pmr->prio, &pPvt->processCallback);
+    callbackSetUser(pPvt, &pPvt->processCallback);
 
     status = pasynEpicsUtils->parseLink(pasynUser, &pmr->out,
                                         &port, &signal, &userParam);
@@ -450,6 +465,11 @@ static long init_record(struct axisRecord * pmr )
         asynPrint(pasynUser, ASYN_TRACE_ERROR,
                   "devMotorAsyn::init_record: %s pasynGenericPointer->read returned %s", 
                   pmr->name, pasynUser->errorMessage);
+    } else {
+        /* A snapshot from an earlier callback is older than this status */
+        epicsMutexMustLock(pPvt->snapshotLock);
+        pPvt->snapshotNew = 0;
+        epicsMutexUnlock(pPvt->snapshotLock);
     }
 
     /* We must get the first set of status values from the controller before
@@ -507,6 +527,13 @@ CALLBACK_VALUE update_values(struct axisRecord * pmr)
     {
         epicsInt32 rawvalue;
 
+        epicsMutexMustLock(pPvt->snapshotLock);
+        if (pPvt->snapshotNew) {
+            memcpy(&pPvt->status, &pPvt->snapshot, sizeof(struct MotorStatus));
+            pPvt->snapshotNew = 0;
+        }
+        epicsMutexUnlock(pPvt->snapshotLock);
+
         pmr->priv->readBack.position = pPvt->status.position;
         pmr->priv->readBack.encoderPosition = pPvt->status.encoderPosition;
         rawvalue = (epicsInt32)floor(pPvt->status.position + 0.5);
@@ -731,6 +758,7 @@ static void asynCallback(asynUser *pasynUser)
     motorAsynPvt *pPvt = (motorAsynPvt *)pasynUser->userPvt;
     axisRecord *pmr = pPvt->pmr;
     motorAsynMessage *pmsg = pasynUser->userData;
+    struct MotorStatus motorStatusRead;
     int status;
     int commandIsMove = 0;
 
@@ -743,14 +771,22 @@ static void asynCallback(asynUser *pasynUser)
 
     switch (pmsg->command) {
         case motorStatus:
-            /* Read the current status of the device */
+            /* Read the current status of the device. It goes into the snapshot
+               like the status from statusCallback(), so that update_values()
+               always uses the latest one. The port is locked during the read,
+               so snapshotLock is only taken afterwards */
             status = pPvt->pasynGenericPointer->read(pPvt->asynGenericPointerPvt,
                                   pasynUser,
-                                  (void *)&pPvt->status);
+                                  (void *)&motorStatusRead);
             if (status != asynSuccess) {
                 asynPrint(pasynUser, ASYN_TRACE_ERROR,
                           "devMotorAsyn::asynCallback: %s pasynGenericPointer->read returned %s\n", 
                           pmr->name, pasynUser->errorMessage);
+            } else {
+                epicsMutexMustLock(pPvt->snapshotLock);
+                memcpy(&pPvt->snapshot, &motorStatusRead, sizeof(struct MotorStatus));
+                pPvt->snapshotNew = 1;
+                epicsMutexUnlock(pPvt->snapshotLock);
             }
             break;
 
@@ -811,6 +847,10 @@ static void asynCallback(asynUser *pasynUser)
 
 /**
  * True callback to notify that controller status has changed.
+ *
+ * Called from the poller with the port locked. The status is only stored
+ * in the snapshot; the record is processed in a callback thread, so that
+ * the poller never waits for the record lock.
  */
 static void statusCallback(void *drvPvt, asynUser *pasynUser,
                void *pValue)
@@ -818,6 +858,7 @@ static void statusCallback(void *drvPvt, asynUser *pasynUser,
     motorAsynPvt *pPvt = (motorAsynPvt *)drvPvt;
     axisRecord *pmr = pPvt->pmr;
     MotorStatus *value = (MotorStatus *)pValue;
+    int needQueue;
 
     asynPrint(pasynUser, ASYN_TRACEIO_DEVICE,
               "%s devMotorAsyn::statusCallback new value=[p:%f,e:%f,s:%x] %c%c\n",
@@ -825,18 +866,48 @@ static void statusCallback(void *drvPvt, asynUser *pasynUser,
               pPvt->needUpdate ? 'N':' ', 
               pPvt->moveRequestPending ? 'P':' ');
 
-    if (dbScanLockOK) {
-        dbScanLock((dbCommon *)pmr);
+    epicsMutexMustLock(pPvt->snapshotLock);
+    memcpy(&pPvt->snapshot, value, sizeof(struct MotorStatus));
+    pPvt->snapshotNew = 1;
+    needQueue = dbScanLockOK && !pPvt->processQueued;
+    if (needQueue) pPvt->processQueued = 1;
+    epicsMutexUnlock(pPvt->snapshotLock);
+
+    if (!dbScanLockOK) {
         memcpy(&pPvt->status, value, sizeof(struct MotorStatus));
-        if (!pPvt->moveRequestPending) {
         pPvt->needUpdate = 1;
-        /* pmr->rset->process((dbCommon*)pmr); */
-            dbProcess((dbCommon*)pmr);
+    } else if (needQueue) {
+        if (callbackRequest(&pPvt->processCallback)) {
+            /* Queue full, try again with the next status */
+            epicsMutexMustLock(pPvt->snapshotLock);
+            pPvt->processQueued = 0;
+            epicsMutexUnlock(pPvt->snapshotLock);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR,
+                      "%s devMotorAsyn::statusCallback callbackRequest failed\n",
+                      pmr->name);
         }
-        dbScanUnlock((dbCommon*)pmr);
-    } else {
-        memcpy(&pPvt->status, value, sizeof(struct MotorStatus));
-        pPvt->needUpdate = 1;
     }
 }
 
+/**
+ * Processes the record after statusCallback() had stored a new status.
+ * Several status updates may result in a single processing,
+ * update_values() uses the latest one.
+ */
+static void statusProcessCallback(CALLBACK *pcallback)
+{
+    motorAsynPvt *pPvt;
+    axisRecord *pmr;
+
+    callbackGetUser(pPvt, pcallback);
+    pmr = pPvt->pmr;
+    dbScanLock((dbCommon *)pmr);
+    epicsMutexMustLock(pPvt->snapshotLock);
+    pPvt->processQueued = 0;
+    epicsMutexUnlock(pPvt->snapshotLock);
+    if (!pPvt->moveRequestPending) {
+        pPvt->needUpdate = 1;
+        dbProcess((dbCommon*)pmr);
+    }
+    dbScanUnlock((dbCommon*)pmr);
+}
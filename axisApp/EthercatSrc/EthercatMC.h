@@ -4,6 +4,7 @@ FILENAME...   EthercatMC.h
 
 #include "asynAxisController.h"
 #include "asynAxisAxis.h"
+#include "EthercatMCParse.h"
 
 #define AMPLIFIER_ON_FLAG_CREATE_AXIS  (1)
 #define AMPLIFIER_ON_FLAG_WHEN_HOMING  (1<<1)
@@ -60,40 +61,6 @@ extern "C" {
   asynStatus checkACK(const char *outdata, size_t outlen, const char *indata);
 }
 
-typedef struct {
-  /* V1 members */
-  int bEnable;           /*  1 */
-  int bReset;            /*  2 */
-  int bExecute;          /*  3 */
-  int nCommand;          /*  4 */
-  int nCmdData;          /*  5 */
-  double fVelocity;      /*  6 */
-  double fPosition;      /*  7 */
-  double fAcceleration;  /*  8 */
-  double fDecceleration; /*  9 */
-  int bJogFwd;           /* 10 */
-  int bJogBwd;           /* 11 */
-  int bLimitFwd;         /* 12 */
-  int bLimitBwd;         /* 13 */
-  double fOverride;      /* 14 */
-  int bHomeSensor;       /* 15 */
-  int bEnabled;          /* 16 */
-  int bError;            /* 17 */
-  int nErrorId;          /* 18 */
-  double fActVelocity;   /* 19 */
-  double fActPosition;   /* 20 */
-  double fActDiff;       /* 21 */
-  int bHomed;            /* 22 */
-  int bBusy;             /* 23 */
-  /* V2 members */
-  double positionRaw;
-  int atTarget;
-  /* neither V1 nor V2, but calculated here */
-  int mvnNRdyNex; /* Not in struct. Calculated in poll() */
-  int motorStatusDirection; /* Not in struct. Calculated in pollAll() */
-  int motorDiffPostion;     /* Not in struct. Calculated in poll() */
-} st_axis_status_type;
-
 class epicsShareClass EthercatMCAxis : public asynAxisAxis
 {
 public:
@@ -113,6 +80,7 @@ public:
   asynStatus pollAll(bool *moving);
   asynStatus pollAll(bool *moving, st_axis_status_type *pst_axis_status);
   asynStatus poll(bool *moving);
+  asynStatus slowPoll(int item);
 
 private:
   typedef enum
@@ -128,6 +96,8 @@ private:
                                    *   Abbreviated because it is used very frequently */
   struct {
     st_axis_status_type old_st_axis_status;
+    st_axis_status_type cached_st_axis_status; /* Filled by EthercatMCController::poll() */
+    int cachedStatusValid;
     double stepSize;
     double cfgStepSize;
     const char *externalEncoderStr;
@@ -173,8 +143,14 @@ private:
     char cmdErrorMessage[80];
     char adsport_str[15]; /* "ADSPORT=12345/" */ /* 14 should be enough, */
     char adsport_zero[1]; /* 15 + 1 for '\' keep us aligned in memory */
+    /* Commands collected by transactionAdd(), sent by transactionCommit() */
+    struct {
+      size_t outlen;
+      asynStatus status;
+    } transaction;
     double motorRecordHighLimit;
     double motorRecordLowLimit;
+    int softLimitsSlowPoll; /* Slow poll item which reads the soft limits */
   } drvlocal;
 
   asynStatus handleDisconnect(void);
@@ -187,11 +163,20 @@ private:
   asynStatus handleStatusChange(asynStatus status);
 
   asynStatus writeReadACK(void);
+  asynStatus checkACKandLog(asynStatus status, const char *outdata,
+                            const char *indata);
+  void transactionBegin(void);
+  asynStatus transactionAdd(const char *cmd);
+  asynStatus transactionAddValue(const char *var, int value);
+  asynStatus transactionAddValue(const char *var, double value);
+  asynStatus transactionAddSAFValue(unsigned indexGroup,
+                                    unsigned indexOffset,
+                                    double value);
+  asynStatus transactionCommit(void);
   asynStatus setValueOnAxis(const char* var, int value);
   asynStatus setValueOnAxisVerify(const char *var, const char *rbvar,
                                   int value, unsigned int retryCount);
   asynStatus setValueOnAxis(const char* var, double value);
-  asynStatus setValuesOnAxis(const char* var1, double value1, const char* var2, double value2);
   int getMotionAxisID(void);
   void getFeatures(void);
   asynStatus setSAFValueOnAxis(unsigned indexGroup,
@@ -252,20 +237,28 @@ private:
 class epicsShareClass EthercatMCController : public asynAxisController {
 public:
   EthercatMCController(const char *portName, const char *EthercatMCPortName, int numAxes, double movingPollPeriod, double idlePollPeriod);
+  virtual ~EthercatMCController();
 
   void report(FILE *fp, int level);
+  asynStatus poll(void);
   asynStatus setMCUErrMsg(const char *value);
   asynStatus configController(int needOk, const char *value);
   asynStatus writeReadOnErrorDisconnect(void);
+  asynStatus writeReadBatch(size_t outlen);
   EthercatMCAxis* getAxis(asynUser *pasynUser);
   EthercatMCAxis* getAxis(int axisNo);
   protected:
   void handleStatusChange(asynStatus status);
+  bool pollAxisInBatch(EthercatMCAxis *pAxis);
   struct {
     unsigned int local_no_ASYN_;
     unsigned int hasConfigError;
     unsigned int isConnected;
   } ctrlLocal;
+  /* One status query for all axes does not fit into outString_/inString_ */
+  char *batchOutString_;
+  char *batchInString_;
+  size_t batchStringSize_;
 
   /* First parameter */
   int EthercatMCErr_;
@@ -31,6 +31,9 @@
 #define NCOMMANDMOVEABS  3
 #define NCOMMANDHOME    10
 
+/* Seconds between two reads of the soft limits, which may be changed in the PLC */
+#define SOFTLIMITS_SLOW_POLL_PERIOD 10.0
+
 const static char *const modulName = "EthercatMCAxis::";
 
 //
@@ -95,6 +98,7 @@ EthercatMCAxis::EthercatMCAxis(EthercatMCController *pC, int axisNo,
     }
     free(pOptions);
   }
+  drvlocal.softLimitsSlowPoll = addSlowPoll(SOFTLIMITS_SLOW_POLL_PERIOD);
 }
 
 
@@ -174,6 +178,20 @@ void EthercatMCAxis::readBackSoftLimits(void)
   setDoubleParam(pC_->motorLowLimitRO_, fValueLow / stepSize);
 }
 
+/** Reads the soft limits again, which is a slow poll item.
+ *  They are read by initialUpdate() and after they have been written,
+ *  this picks up changes done in the PLC.
+ * \param[in] item The slow poll item
+ */
+asynStatus EthercatMCAxis::slowPoll(int item)
+{
+  if (item != drvlocal.softLimitsSlowPoll) return asynSuccess;
+  /* Not connected, or initialUpdate() will read them anyway */
+  if (drvlocal.dirty.initialUpdate) return asynSuccess;
+  readBackSoftLimits();
+  return asynSuccess;
+}
+
 /** Connection status is changed, the dirty bits must be set and
  *  the values in the controller must be updated
  * \param[in] AsynStatus status
@@ -337,7 +355,8 @@ extern "C" const char *errStringFromErrId(int nErrorId)
 
 
 
-/** Set velocity and acceleration for the axis
+/** Set velocity and acceleration for the axis, and start the motion
+ * The commands are added to the transaction, which is then committed
  * \param[in] maxVelocity, mm/sec
  * \param[in] acceleration ???
  *
@@ -357,16 +376,16 @@ asynStatus EthercatMCAxis::sendVelocityAndAccelExecute(double maxVelocity, doubl
     double acc_in_seconds = maxVelocity / acceleration_time;
     double acc_in_EGU_sec2 = maxVelocityEGU / acc_in_seconds;
     if (acc_in_EGU_sec2  < 0) acc_in_EGU_sec2 = 0 - acc_in_EGU_sec2 ;
-    status = setValuesOnAxis("fAcceleration", acc_in_EGU_sec2,
-                             "fDeceleration", acc_in_EGU_sec2);
-    if (status) return status;
+    transactionAddValue("fAcceleration", acc_in_EGU_sec2);
+    transactionAddValue("fDeceleration", acc_in_EGU_sec2);
   } else {
     asynPrint(pC_->pasynUserController_, ASYN_TRACE_INFO,
               "%s sendVelocityAndAccelExecute(%d) maxVelocityEGU=%g acceleration_time=%g\n",
                modulName, axisNo_, maxVelocityEGU, acceleration_time);
   }
-  status = setValueOnAxis("fVelocity", maxVelocityEGU);
-  if (status == asynSuccess) status = setValueOnAxis("bExecute", 1);
+  transactionAddValue("fVelocity", maxVelocityEGU);
+  transactionAddValue("bExecute", 1);
+  status = transactionCommit();
   drvlocal.waitNumPollsBeforeReady += 2;
   return status;
 }
@@ -384,10 +403,13 @@ asynStatus EthercatMCAxis::move(double position, int relative, double minVelocit
   asynStatus status = asynSuccess;
   int nCommand = relative ? NCOMMANDMOVEREL : NCOMMANDMOVEABS;
   if (status == asynSuccess) status = stopAxisInternal(__FUNCTION__, 0);
-  if (status == asynSuccess) status = setValueOnAxis("nCommand", nCommand);
-  if (status == asynSuccess) status = setValueOnAxis("nCmdData", 0);
-  if (status == asynSuccess) status = setValueOnAxis("fPosition", position * drvlocal.stepSize);
-  if (status == asynSuccess) status = sendVelocityAndAccelExecute(maxVelocity, acceleration);
+  if (status == asynSuccess) {
+    transactionBegin();
+    transactionAddValue("nCommand", nCommand);
+    transactionAddValue("nCmdData", 0);
+    transactionAddValue("fPosition", position * drvlocal.stepSize);
+    status = sendVelocityAndAccelExecute(maxVelocity, acceleration);
+  }
 
   return status;
 }
@@ -437,18 +459,18 @@ asynStatus EthercatMCAxis::home(double minVelocity, double maxVelocity, double a
   if (status == asynSuccess) status = stopAxisInternal(__FUNCTION__, 0);
   if ((drvlocal.axisFlags & AMPLIFIER_ON_FLAG_WHEN_HOMING) &&
       (status == asynSuccess)) status = enableAmplifier(1);
-  if (status == asynSuccess) status = setValueOnAxis("fHomePosition", posHom);
-  if (status == asynSuccess) status = setValueOnAxis("nCommand", nCommand );
-  if (status == asynSuccess) status = setValueOnAxis("nCmdData", procHom);
-
-  if (status == asynSuccess) status = setSAFValueOnAxis(0x4000, 0x6,
-                                                        velToHom);
-  if (status == asynSuccess) status = setSAFValueOnAxis(0x4000, 0x7,
-                                                        velFrmHom);
-  if (status == asynSuccess)  status = setValuesOnAxis("fAcceleration", accHom,
-                                                       "fDeceleration", decHom);
-
-  if (status == asynSuccess) status = setValueOnAxis("bExecute", 1);
+  if (status == asynSuccess) {
+    transactionBegin();
+    transactionAddValue("fHomePosition", posHom);
+    transactionAddValue("nCommand", nCommand);
+    transactionAddValue("nCmdData", procHom);
+    transactionAddSAFValue(0x4000, 0x6, velToHom);
+    transactionAddSAFValue(0x4000, 0x7, velFrmHom);
+    transactionAddValue("fAcceleration", accHom);
+    transactionAddValue("fDeceleration", decHom);
+    transactionAddValue("bExecute", 1);
+    status = transactionCommit();
+  }
   drvlocal.waitNumPollsBeforeReady += 2;
   return status;
 }
@@ -465,9 +487,12 @@ asynStatus EthercatMCAxis::moveVelocity(double minVelocity, double maxVelocity,
   asynStatus status = asynSuccess;
 
   if (status == asynSuccess) status = stopAxisInternal(__FUNCTION__, 0);
-  if (status == asynSuccess) setValueOnAxis("nCommand", NCOMMANDMOVEVEL);
-  if (status == asynSuccess) status = setValueOnAxis("nCmdData", 0);
-  if (status == asynSuccess) status = sendVelocityAndAccelExecute(maxVelocity, acceleration);
+  if (status == asynSuccess) {
+    transactionBegin();
+    transactionAddValue("nCommand", NCOMMANDMOVEVEL);
+    transactionAddValue("nCmdData", 0);
+    status = sendVelocityAndAccelExecute(maxVelocity, acceleration);
+  }
 
   return status;
 }
@@ -710,56 +735,29 @@ asynStatus EthercatMCAxis::pollAll(bool *moving, st_axis_status_type *pst_axis_s
 
   int motor_axis_no = 0;
   int nvals = 0;
-  const char * const Main_dot_str = "Main.";
-  const size_t       Main_dot_len = strlen(Main_dot_str);
-  struct {
-    double velocitySetpoint;
-    int cycleCounter;
-    unsigned int EtherCATtime_low32;
-    unsigned int EtherCATtime_high32;
-    int command;
-    int cmdData;
-    int reset;
-    int moving;
-    int stall;
-  } notUsed;
+
+  if (drvlocal.cachedStatusValid) {
+    /* The status had been read by EthercatMCController::poll(),
+       together with the status of all other axes */
+    drvlocal.cachedStatusValid = 0;
+    *pst_axis_status = drvlocal.cached_st_axis_status;
+    motor_axis_no = axisNo_;
+    if (drvlocal.supported.stAxisStatus_V2) {
+      pst_axis_status->mvnNRdyNex = pst_axis_status->bBusy || !pst_axis_status->atTarget;
+    } else {
+      pst_axis_status->mvnNRdyNex = pst_axis_status->bBusy && pst_axis_status->bEnabled;
+      if (!drvlocal.supported.bV1BusyNewStyle) {
+        pst_axis_status->mvnNRdyNex &= pst_axis_status->bExecute;
+      }
+    }
+    goto pollAllCalcDirection;
+  }
   if (drvlocal.supported.stAxisStatus_V2 || drvlocal.dirty.stAxisStatus_Vxx) {
     /* V2 is supported, use it. Or. unkown: try it as well */
     snprintf(pC_->outString_, sizeof(pC_->outString_),
             "%sMain.M%d.stAxisStatusV2?", drvlocal.adsport_str, axisNo_);
     comStatus = pC_->writeReadOnErrorDisconnect();
-    if (!strncasecmp(pC_->inString_,  Main_dot_str, Main_dot_len)) {
-      nvals = sscanf(&pC_->inString_[Main_dot_len],
-                     "M%d.stAxisStatusV2="
-                     "%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
-                     &motor_axis_no,
-                     &pst_axis_status->fPosition,
-                     &pst_axis_status->fActPosition,
-                     &pst_axis_status->positionRaw,          /* Send as uint64; parsed as double ! */
-                     &notUsed.velocitySetpoint,
-                     &pst_axis_status->fActVelocity,
-                     &pst_axis_status->fAcceleration,
-                     &pst_axis_status->fDecceleration,
-                     &notUsed.cycleCounter,
-                     &notUsed.EtherCATtime_low32,
-                     &notUsed.EtherCATtime_high32,
-                     &pst_axis_status->bEnable,
-                     &pst_axis_status->bEnabled,
-                     &pst_axis_status->bExecute,
-                     &notUsed.command,
-                     &notUsed.cmdData,
-                     &pst_axis_status->bLimitBwd,
-                     &pst_axis_status->bLimitFwd,
-                     &pst_axis_status->bHomeSensor,
-                     &pst_axis_status->bError,
-                     &pst_axis_status->nErrorId,
-                     &notUsed.reset,
-                     &pst_axis_status->bHomed,
-                     &pst_axis_status->bBusy,
-                     &pst_axis_status->atTarget,
-                     &notUsed.moving,
-                     &notUsed.stall);
-    }
+    nvals = EthercatMCParseAxisStatusV2(pC_->inString_, &motor_axis_no, pst_axis_status);
     if (nvals == 27) {
       if (drvlocal.dirty.stAxisStatus_Vxx) {
         drvlocal.supported.stAxisStatus_V2 = 1;
@@ -774,36 +772,7 @@ asynStatus EthercatMCAxis::pollAll(bool *moving, st_axis_status_type *pst_axis_s
             "%sMain.M%d.stAxisStatus?", drvlocal.adsport_str, axisNo_);
     comStatus = pC_->writeReadOnErrorDisconnect();
     if (comStatus) return comStatus;
-    if (!strncasecmp(pC_->inString_,  Main_dot_str, Main_dot_len)) {
-      nvals = sscanf(&pC_->inString_[Main_dot_len],
-                     "M%d.stAxisStatus="
-                     "%d,%d,%d,%u,%u,%lf,%lf,%lf,%lf,%d,"
-                     "%d,%d,%d,%lf,%d,%d,%d,%u,%lf,%lf,%lf,%d,%d",
-                     &motor_axis_no,
-                     &pst_axis_status->bEnable,        /*  1 */
-                     &pst_axis_status->bReset,         /*  2 */
-                     &pst_axis_status->bExecute,       /*  3 */
-                     &pst_axis_status->nCommand,       /*  4 */
-                     &pst_axis_status->nCmdData,       /*  5 */
-                     &pst_axis_status->fVelocity,      /*  6 */
-                     &pst_axis_status->fPosition,      /*  7 */
-                     &pst_axis_status->fAcceleration,  /*  8 */
-                     &pst_axis_status->fDecceleration, /*  9 */
-                     &pst_axis_status->bJogFwd,        /* 10 */
-                     &pst_axis_status->bJogBwd,        /* 11 */
-                     &pst_axis_status->bLimitFwd,      /* 12 */
-                     &pst_axis_status->bLimitBwd,      /* 13 */
-                     &pst_axis_status->fOverride,      /* 14 */
-                     &pst_axis_status->bHomeSensor,    /* 15 */
-                     &pst_axis_status->bEnabled,       /* 16 */
-                     &pst_axis_status->bError,         /* 17 */
-                     &pst_axis_status->nErrorId,       /* 18 */
-                     &pst_axis_status->fActVelocity,   /* 19 */
-                     &pst_axis_status->fActPosition,   /* 20 */
-                     &pst_axis_status->fActDiff,       /* 21 */
-                     &pst_axis_status->bHomed,         /* 22 */
-                     &pst_axis_status->bBusy           /* 23 */);
-    }
+    nvals = EthercatMCParseAxisStatusV1(pC_->inString_, &motor_axis_no, pst_axis_status);
     if (nvals != 24) {
       drvlocal.supported.stAxisStatus_V1 = 0;
       goto pollAllWrongnvals;
@@ -842,6 +811,7 @@ asynStatus EthercatMCAxis::pollAll(bool *moving, st_axis_status_type *pst_axis_s
     setIntegerParam(pC_->motorFlagsStopOnProblem_, 0);
     drvlocal.dirty.stAxisStatus_Vxx = 0;
   }
+pollAllCalcDirection:
   if (axisNo_ != motor_axis_no) return asynError;
 
   /* Use previous fActPosition and current fActPosition to calculate direction.*/
@@ -46,6 +46,9 @@ EthercatMCController::EthercatMCController(const char *portName, const char *Mot
 
   /* Controller */
   memset(&ctrlLocal, 0, sizeof(ctrlLocal));
+  batchStringSize_ = numAxes * MAX_CONTROLLER_STRING_SIZE;
+  batchOutString_ = (char *)calloc(batchStringSize_, 1);
+  batchInString_ = (char *)calloc(batchStringSize_, 1);
   createParam(EthercatMCMCUErrMsgString,     asynParamOctet,       &EthercatMCMCUErrMsg_);
   createParam(EthercatMCDbgStrToMcuString,   asynParamOctet,       &EthercatMCDbgStrToMcu_);
 
@@ -100,6 +103,12 @@ EthercatMCController::EthercatMCController(const char *portName, const char *Mot
   startPoller(movingPollPeriod, idlePollPeriod, 2);
 }
 
+EthercatMCController::~EthercatMCController()
+{
+  free(batchOutString_);
+  free(batchInString_);
+}
+
 
 /** Creates a new EthercatMCController object.
   * Configuration command, called directly or from iocsh
@@ -234,9 +243,12 @@ asynStatus EthercatMCController::writeReadOnErrorDisconnect(void)
 {
   asynStatus status = asynError;
   size_t outlen = strlen(outString_);
+  epicsTimeStamp startTime;
   inString_[0] = '\0';
+  epicsTimeGetCurrent(&startTime);
   status = writeReadOnErrorDisconnect_C(pasynUserController_, outString_, outlen,
                                         inString_, sizeof(inString_));
+  writeReadHistogram_.add(&startTime);
   handleStatusChange(status);
   if (status)
   {
@@ -245,25 +257,147 @@ asynStatus EthercatMCController::writeReadOnErrorDisconnect(void)
   return status;
 }
 
+/** Reads the status of all axes in one round trip to the MCU.
+  * The queries are joined with ';', and the MCU answers with
+  * the ';' separated replies in the same order.
+  * The result is cached in the axis and consumed in EthercatMCAxis::pollAll().
+  * Axes where nothing is cached fall back to a query of their own.
+  * Only the axes in pollDueAxes_, which pollCycle() polls in this cycle, are queried.
+  */
+asynStatus EthercatMCController::poll(void)
+{
+  asynStatus status;
+  size_t outlen = 0;
+  int numQueried = 0;
+  int axisNo;
+  int i;
+  char *pInString;
+
+  for (axisNo=0; axisNo<numAxes_; axisNo++) {
+    EthercatMCAxis *pAxis=getAxis(axisNo);
+    if (!pAxis) continue;
+    pAxis->drvlocal.cachedStatusValid = 0;
+  }
+  if (!batchOutString_ || !batchInString_ || !ctrlLocal.isConnected) {
+    return asynSuccess;
+  }
+
+  batchOutString_[0] = '\0';
+  for (i=0; i<numPollDueAxes_; i++) {
+    EthercatMCAxis *pAxis;
+    int res;
+    axisNo = pollDueAxes_[i];
+    pAxis = getAxis(axisNo);
+    if (!pAxis || !pollAxisInBatch(pAxis)) continue;
+    res = snprintf(&batchOutString_[outlen], batchStringSize_ - outlen,
+                   "%s%sMain.M%d.%s?",
+                   outlen ? ";" : "",
+                   pAxis->drvlocal.adsport_str, axisNo,
+                   pAxis->drvlocal.supported.stAxisStatus_V2 ?
+                   "stAxisStatusV2" : "stAxisStatus");
+    if (res < 0 || (size_t)res >= batchStringSize_ - outlen) {
+      /* Does not fit: the remaining axes poll themselves */
+      batchOutString_[outlen] = '\0';
+      break;
+    }
+    outlen += res;
+    numQueried++;
+  }
+  if (!numQueried) return asynSuccess;
+
+  status = writeReadBatch(outlen);
+  if (status) return status;
+
+  pInString = batchInString_;
+  for (i=0; i<numPollDueAxes_ && numQueried && pInString; i++) {
+    EthercatMCAxis *pAxis;
+    char *pSemicolon;
+    int motor_axis_no = 0;
+    int nvals;
+    bool ok;
+    axisNo = pollDueAxes_[i];
+    pAxis = getAxis(axisNo);
+    if (!pAxis || !pollAxisInBatch(pAxis)) continue;
+    numQueried--;
+    pSemicolon = strchr(pInString, ';');
+    if (pSemicolon) *pSemicolon = '\0';
+    if (pAxis->drvlocal.supported.stAxisStatus_V2) {
+      nvals = EthercatMCParseAxisStatusV2(pInString, &motor_axis_no,
+                                          &pAxis->drvlocal.cached_st_axis_status);
+      ok = (nvals == 27);
+    } else {
+      nvals = EthercatMCParseAxisStatusV1(pInString, &motor_axis_no,
+                                          &pAxis->drvlocal.cached_st_axis_status);
+      ok = (nvals == 24);
+    }
+    if (ok && motor_axis_no == axisNo) {
+      pAxis->drvlocal.cachedStatusValid = 1;
+    } else {
+      asynPrint(pasynUserController_, ASYN_TRACE_INFO,
+                "%s poll(%d) nvals=%d in=%s\n",
+                modulName, axisNo, nvals, pInString);
+    }
+    pInString = pSemicolon ? pSemicolon + 1 : NULL;
+  }
+  return asynSuccess;
+}
+
+/** Axes that know which status version the MCU supports, and are due
+  * to be polled, are polled by EthercatMCController::poll()
+  * \param[in] pAxis The axis, one of pollDueAxes_
+  */
+bool EthercatMCController::pollAxisInBatch(EthercatMCAxis *pAxis)
+{
+  if (!pAxis->drvlocal.stepSize) return false;
+  if (pAxis->drvlocal.dirty.initialUpdate) return false;
+  if (pAxis->drvlocal.dirty.stAxisStatus_Vxx) return false;
+  return pAxis->drvlocal.supported.stAxisStatus_V2 ||
+    pAxis->drvlocal.supported.stAxisStatus_V1;
+}
+
+/** Writes batchOutString_ to the controller and reads the response
+  * into batchInString_.
+  * Disconnects in case of error
+  * \param[in] outlen The length of the data in batchOutString_
+  */
+asynStatus EthercatMCController::writeReadBatch(size_t outlen)
+{
+  asynStatus status;
+  epicsTimeStamp startTime;
+  if (!batchOutString_ || !batchInString_) return asynError;
+  batchInString_[0] = '\0';
+  epicsTimeGetCurrent(&startTime);
+  status = writeReadOnErrorDisconnect_C(pasynUserController_,
+                                        batchOutString_, outlen,
+                                        batchInString_, batchStringSize_);
+  writeReadHistogram_.add(&startTime);
+  batchInString_[batchStringSize_ - 1] = '\0';
+  handleStatusChange(status);
+  return status;
+}
+
+/** Checks that every ';' separated command in outdata
+  * had been acknowledged with an "OK" in indata:
+  * "cmd1;cmd2;cmd3" -> "OK;OK;OK"
+  */
 extern "C"
 asynStatus checkACK(const char *outdata, size_t outlen,
                     const char *indata)
 {
   size_t i;
   unsigned int numOK = 1;
-  int res = 1;
   for( i = 0; i < outlen; i++) {
     if (outdata[i] == ';') numOK++;
   }
-  switch(numOK) {
-    case 1: res = strcmp(indata, "OK");  break;
-    case 2: res = strcmp(indata, "OK;OK");  break;
-    case 3: res = strcmp(indata, "OK:OK;OK");  break;
-    case 4: res = strcmp(indata, "OK;OK;OK;OK");  break;
-    default:
-    ;
+  while (numOK--) {
+    if (strncmp(indata, "OK", 2)) return asynError;
+    indata += 2;
+    if (numOK) {
+      if (indata[0] != ';') return asynError;
+      indata++;
+    }
   }
-  return res ? asynError : asynSuccess;
+  return indata[0] ? asynError : asynSuccess;
 }
 
 asynStatus EthercatMCController::setMCUErrMsg(const char *value)
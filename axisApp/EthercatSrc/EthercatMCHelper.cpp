@@ -31,40 +31,34 @@ const static unsigned int MAXADSPORT = 861; /* something useful */
 asynStatus EthercatMCAxis::writeReadACK(void)
 {
   asynStatus status = pC_->writeReadOnErrorDisconnect();
+  return checkACKandLog(status, pC_->outString_, pC_->inString_);
+}
+
+/** Checks the logical ack from the controller, see checkACK()
+ * \param[in] status the result of the communication
+ * \param[in] outdata the command(s) sent to the controller
+ * \param[in] indata the response from the controller
+ */
+asynStatus EthercatMCAxis::checkACKandLog(asynStatus status,
+                                          const char *outdata,
+                                          const char *indata)
+{
   switch (status) {
     case asynError:
       return status;
     case asynSuccess:
     {
-      const char *semicolon = &pC_->outString_[0];
-      unsigned int numOK = 1;
-      int res = 1;
-      while (semicolon && semicolon[0]) {
-        semicolon = strchr(semicolon, ';');
-        if (semicolon) {
-          numOK++;
-          semicolon++;
-        }
-      }
-      switch(numOK) {
-        case 1: res = strcmp(pC_->inString_, "OK");  break;
-        case 2: res = strcmp(pC_->inString_, "OK;OK");  break;
-        case 3: res = strcmp(pC_->inString_, "OK:OK;OK");  break;
-        case 4: res = strcmp(pC_->inString_, "OK;OK;OK;OK");  break;
-        default:
-          ;
-      }
-      if (res) {
-        status = asynError;
+      status = checkACK(outdata, strlen(outdata), indata);
+      if (status) {
         asynPrint(pC_->pasynUserController_, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
                   "%s out=%s in=%s return=%s (%d)\n",
                    modulName,
-                  pC_->outString_, pC_->inString_,
+                  outdata, indata,
                   pasynManager->strStatus(status), (int)status);
         if (!drvlocal.cmdErrorMessage[0]) {
           snprintf(drvlocal.cmdErrorMessage, sizeof(drvlocal.cmdErrorMessage)-1,
                    "E: writeReadACK() out=%s in=%s\n",
-                   pC_->outString_, pC_->inString_);
+                   outdata, indata);
           /* The poller co-ordinates the writing into the parameter library */
         }
         return status;
@@ -76,11 +70,103 @@ asynStatus EthercatMCAxis::writeReadACK(void)
   asynPrint(pC_->pasynUserController_, ASYN_TRACE_INFO,
             "%s out=%s in=%s status=%s (%d)\n",
              modulName,
-            pC_->outString_, pC_->inString_,
+            outdata, indata,
             pasynManager->strStatus(status), (int)status);
   return status;
 }
 
+/** Starts a transaction: commands to the axis are collected and
+ * sent in one line, separated by ';', when transactionCommit() is called.
+ * The controller acks each of them: "OK;OK;OK"
+ * The line is kept in pC_->batchOutString_
+ */
+void EthercatMCAxis::transactionBegin(void)
+{
+  drvlocal.transaction.outlen = 0;
+  drvlocal.transaction.status = pC_->batchOutString_ ? asynSuccess : asynError;
+}
+
+/** Adds a command to the transaction
+ * When the line is full, the commands collected so far are sent
+ * \param[in] cmd the command, e.g. "Main.M1.bExecute=1"
+ */
+asynStatus EthercatMCAxis::transactionAdd(const char *cmd)
+{
+  size_t len = strlen(cmd);
+  if (drvlocal.transaction.status) return drvlocal.transaction.status;
+  if (drvlocal.transaction.outlen &&
+      drvlocal.transaction.outlen + 1 + len >= pC_->batchStringSize_) {
+    asynStatus status = transactionCommit();
+    drvlocal.transaction.status = status;
+    if (status) return status;
+  }
+  if (len >= pC_->batchStringSize_) {
+    drvlocal.transaction.status = asynError;
+    return asynError;
+  }
+  if (drvlocal.transaction.outlen) {
+    pC_->batchOutString_[drvlocal.transaction.outlen++] = ';';
+  }
+  memcpy(&pC_->batchOutString_[drvlocal.transaction.outlen], cmd, len + 1);
+  drvlocal.transaction.outlen += len;
+  return asynSuccess;
+}
+
+/** Adds an integer or boolean value for the axis to the transaction
+ * \param[in] name of the variable to be updated
+ * \param[in] value the (integer) variable to be updated
+ */
+asynStatus EthercatMCAxis::transactionAddValue(const char *var, int value)
+{
+  char cmd[MAX_CONTROLLER_STRING_SIZE];
+  snprintf(cmd, sizeof(cmd),
+           "%sMain.M%d.%s=%d", drvlocal.adsport_str, axisNo_, var, value);
+  return transactionAdd(cmd);
+}
+
+/** Adds a floating point value for the axis to the transaction
+ * \param[in] name of the variable to be updated
+ * \param[in] value the (floating point) variable to be updated
+ */
+asynStatus EthercatMCAxis::transactionAddValue(const char *var, double value)
+{
+  char cmd[MAX_CONTROLLER_STRING_SIZE];
+  snprintf(cmd, sizeof(cmd),
+           "%sMain.M%d.%s=%g", drvlocal.adsport_str, axisNo_, var, value);
+  return transactionAdd(cmd);
+}
+
+/** Adds a floating point value to the transaction, see setSAFValueOnAxis()
+ */
+asynStatus EthercatMCAxis::transactionAddSAFValue(unsigned indexGroup,
+                                                  unsigned indexOffset,
+                                                  double value)
+{
+  char cmd[MAX_CONTROLLER_STRING_SIZE];
+  int axisID = getMotionAxisID();
+  if (axisID < 0) {
+    drvlocal.transaction.status = asynError;
+    return asynError;
+  }
+  snprintf(cmd, sizeof(cmd), "ADSPORT=%u/.ADR.16#%X,16#%X,8,5=%g",
+          501, indexGroup + axisID, indexOffset, value);
+  return transactionAdd(cmd);
+}
+
+/** Sends the commands collected in the transaction and checks
+ * that all of them are acked
+ * If a command could not be added, nothing is sent and an error is returned
+ */
+asynStatus EthercatMCAxis::transactionCommit(void)
+{
+  asynStatus status = drvlocal.transaction.status;
+  size_t outlen = drvlocal.transaction.outlen;
+  drvlocal.transaction.outlen = 0;
+  if (status || !outlen) return status;
+  status = pC_->writeReadBatch(outlen);
+  return checkACKandLog(status, pC_->batchOutString_, pC_->batchInString_);
+}
+
 
 /** Sets an integer or boolean value on an axis
  * the values in the controller must be updated
@@ -164,23 +250,6 @@ asynStatus EthercatMCAxis::setValueOnAxis(const char* var, double value)
   return writeReadACK();
 }
 
-/** Sets 2 floating point value on an axis
- * the values in the controller must be updated
- * \param[in] name of the variable to be updated
- * \param[in] value the (floating point) variable to be updated
- *
- */
-asynStatus EthercatMCAxis::setValuesOnAxis(const char* var1, double value1,
-                                           const char* var2, double value2)
-{
-  snprintf(pC_->outString_, sizeof(pC_->outString_),
-           "%sMain.M%d.%s=%g;%sMain.M%d.%s=%g",
-           drvlocal.adsport_str, axisNo_, var1, value1,
-           drvlocal.adsport_str, axisNo_, var2, value2);
-  return writeReadACK();
-}
-
-
 int EthercatMCAxis::getMotionAxisID(void)
 {
   int ret = drvlocal.dirty.nMotionAxisID;
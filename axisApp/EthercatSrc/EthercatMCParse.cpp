@@ -0,0 +1,372 @@
+/*
+  FILENAME... EthercatMCParse.cpp
+
+  Parsers for the status replies of the MCU.
+  They are called for every axis in every poll cycle and replace
+  sscanf() with the "%d,%lf,..." formats: there is no format string
+  to be interpreted, nothing is allocated, and the decimal point is
+  always '.', whatever the locale says.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+
+#include "EthercatMCParse.h"
+
+#define PARSE_OK       1
+#define PARSE_NOMATCH  0
+#define PARSE_EOF    (-1) /* End of input, sscanf() returns EOF */
+
+/* The exact powers of 10 in a double */
+static const double pow10tab[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+  1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+  1e20, 1e21, 1e22
+};
+#define MAX_EXACT_POW10 22
+#define MAX_EXACT_MANTISSA (1ULL << 53)
+#define MAX_MANTISSA_DIGITS 19
+#define MAX_SLOW_NUMBER_LEN 127
+
+static int isSpaceC(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static int isDigitC(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static int isAlnumC(char c)
+{
+  return isDigitC(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static const char *skipSpace(const char *p)
+{
+  while (isSpaceC(*p)) p++;
+  return p;
+}
+
+/* Match a literal, like a non-% character in a sscanf() format */
+static int parseLiteral(const char **pp, const char *literal)
+{
+  const char *p = *pp;
+  while (*literal) {
+    if (!*p) return PARSE_EOF;
+    if (*p != *literal) return PARSE_NOMATCH;
+    p++;
+    literal++;
+  }
+  *pp = p;
+  return PARSE_OK;
+}
+
+/* "%d" and "%u": strtol() and strtoul() with base 10,
+   the result is truncated into an int like sscanf() does */
+static int parseInteger(const char **pp, int isUnsigned, int *pValue)
+{
+  const char *p = skipSpace(*pp);
+  unsigned long value = 0;
+  int overflow = 0;
+  int neg = 0;
+  if (!*p) return PARSE_EOF;
+  if (*p == '-' || *p == '+') {
+    neg = *p == '-';
+    p++;
+  }
+  if (!isDigitC(*p)) return PARSE_NOMATCH;
+  while (isDigitC(*p)) {
+    unsigned long digit = (unsigned long)(*p - '0');
+    if (value > (~0UL - digit) / 10) overflow = 1;
+    else value = value * 10 + digit;
+    p++;
+  }
+  if (isUnsigned) {
+    if (overflow) value = ~0UL;
+    else if (neg) value = 0UL - value;
+    *pValue = (int)(unsigned int)value;
+  } else {
+    const unsigned long longMax = ~0UL >> 1;
+    long lValue;
+    if (neg) {
+      if (overflow || value > longMax + 1UL) lValue = -(long)longMax - 1;
+      else lValue = (long)(0UL - value);
+    } else {
+      if (overflow || value > longMax) lValue = (long)longMax;
+      else lValue = (long)value;
+    }
+    *pValue = (int)lValue;
+  }
+  *pp = p;
+  return PARSE_OK;
+}
+
+/* strtod() for the numbers that parseDouble() does not convert itself.
+   strtod() expects the decimal point of the locale, so the number is
+   copied with the '.' replaced by it. Only the characters strtod() may
+   accept are copied, so a ',' in the reply is never taken as a decimal
+   point. Returns the number of characters consumed from the reply */
+static size_t strtodC(const char *start, double *pValue)
+{
+  char buf[MAX_SLOW_NUMBER_LEN + 1];
+  const char *decimalPoint = localeconv()->decimal_point;
+  size_t dpLen = strlen(decimalPoint);
+  size_t bufLen = 0;
+  size_t consumed;
+  size_t len;
+  char *end;
+
+  if (dpLen == 1 && decimalPoint[0] == '.') {
+    *pValue = strtod(start, &end);
+    return (size_t)(end - start);
+  }
+  for (len = 0; isAlnumC(start[len]) || start[len] == '.' ||
+         start[len] == '+' || start[len] == '-' ||
+         start[len] == '(' || start[len] == ')' || start[len] == '_'; len++) {
+    size_t n = start[len] == '.' ? dpLen : 1;
+    if (bufLen + n > MAX_SLOW_NUMBER_LEN) break;
+    if (start[len] == '.') memcpy(&buf[bufLen], decimalPoint, dpLen);
+    else buf[bufLen] = start[len];
+    bufLen += n;
+  }
+  buf[bufLen] = '\0';
+  *pValue = strtod(buf, &end);
+  /* Map the end of the copy back into the reply */
+  consumed = (size_t)(end - buf);
+  bufLen = 0;
+  for (len = 0; bufLen < consumed; len++) {
+    bufLen += start[len] == '.' ? dpLen : 1;
+  }
+  return len;
+}
+
+/* "%lf": Decimal numbers with up to 19 digits and a small exponent
+   are converted here. A double can hold both the mantissa and the
+   power of 10 exactly, and a single multiplication or division
+   rounds correctly, so that the result is the same as from strtod().
+   Everything else (long mantissa, big exponent, inf, nan, hex) is
+   left to strtodC() */
+static int parseDouble(const char **pp, double *pValue)
+{
+  const char *start = skipSpace(*pp);
+  const char *p = start;
+  unsigned long long mantissa = 0;
+  int numDigits = 0;
+  int haveDigits = 0;
+  int exp10 = 0;
+  int neg = 0;
+  double value;
+
+  if (!*p) return PARSE_EOF;
+  if (*p == '-' || *p == '+') {
+    neg = *p == '-';
+    p++;
+  }
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    /* sscanf() does not convert "0x" without a hex digit */
+    if (!isDigitC(p[2]) &&
+        !(p[2] >= 'a' && p[2] <= 'f') && !(p[2] >= 'A' && p[2] <= 'F')) {
+      return PARSE_NOMATCH;
+    }
+    goto parseDoubleSlow;
+  }
+  while (isDigitC(*p)) {
+    haveDigits = 1;
+    if (mantissa || *p != '0') {
+      if (numDigits >= MAX_MANTISSA_DIGITS) goto parseDoubleSlow;
+      mantissa = mantissa * 10 + (unsigned)(*p - '0');
+      numDigits++;
+    }
+    p++;
+  }
+  if (*p == '.') {
+    p++;
+    while (isDigitC(*p)) {
+      haveDigits = 1;
+      if (mantissa || *p != '0') {
+        if (numDigits >= MAX_MANTISSA_DIGITS) goto parseDoubleSlow;
+        mantissa = mantissa * 10 + (unsigned)(*p - '0');
+        numDigits++;
+      }
+      exp10--;
+      p++;
+    }
+  }
+  if (!haveDigits) goto parseDoubleSlow;
+  if (*p == 'e' || *p == 'E') {
+    const char *q = p + 1;
+    int expNeg = 0;
+    int expValue = 0;
+    if (*q == '-' || *q == '+') {
+      expNeg = *q == '-';
+      q++;
+    }
+    while (isDigitC(*q)) {
+      if (expValue < 100000) expValue = expValue * 10 + (*q - '0');
+      q++;
+    }
+    exp10 += expNeg ? -expValue : expValue;
+    /* Like sscanf(), "1e" or "1e+" without digits is consumed as 1 */
+    p = q;
+  }
+  if (!mantissa) {
+    value = 0.0;
+  } else if (mantissa > MAX_EXACT_MANTISSA ||
+             exp10 < -MAX_EXACT_POW10 || exp10 > MAX_EXACT_POW10) {
+    goto parseDoubleSlow;
+  } else if (exp10 < 0) {
+    value = (double)mantissa / pow10tab[-exp10];
+  } else {
+    value = (double)mantissa * pow10tab[exp10];
+  }
+  *pValue = neg ? -value : value;
+  *pp = p;
+  return PARSE_OK;
+
+parseDoubleSlow:
+  {
+    size_t len = strtodC(start, &value);
+    if (!len) return PARSE_NOMATCH;
+    *pValue = value;
+    *pp = start + len;
+    return PARSE_OK;
+  }
+}
+
+/* "Main." is compared case insensitive */
+static const char *skipMainDot(const char *p)
+{
+  const char *Main_dot_str = "main.";
+  while (*Main_dot_str) {
+    char c = *p;
+    if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+    if (c != *Main_dot_str) return NULL;
+    p++;
+    Main_dot_str++;
+  }
+  return p;
+}
+
+/* Parse "M<n><name>=<v1>,<v2>,..."
+   types has one character per value: 'd' int, 'u' unsigned, 'f' double
+   Returns the number of converted values, like sscanf() */
+static int parseAxisStatus(const char *p, const char *name,
+                           int *pMotor_axis_no,
+                           const char *types, void *const *pValues)
+{
+  int nvals = 0;
+  int res;
+
+  res = parseLiteral(&p, "M");
+  if (res == PARSE_OK) res = parseInteger(&p, 0, pMotor_axis_no);
+  if (res != PARSE_OK) return res;
+  nvals++;
+  res = parseLiteral(&p, name);
+  if (res == PARSE_OK) res = parseLiteral(&p, "=");
+  for (; res == PARSE_OK && *types; types++, pValues++) {
+    if (nvals > 1) {
+      res = parseLiteral(&p, ",");
+      if (res != PARSE_OK) break;
+    }
+    switch (*types) {
+      case 'd':
+        res = parseInteger(&p, 0, (int *)*pValues);
+        break;
+      case 'u':
+        res = parseInteger(&p, 1, (int *)*pValues);
+        break;
+      case 'f':
+        res = parseDouble(&p, (double *)*pValues);
+        break;
+      default:
+        res = PARSE_NOMATCH;
+    }
+    if (res == PARSE_OK) nvals++;
+  }
+  return nvals;
+}
+
+int EthercatMCParseAxisStatusV1(const char *inString, int *pMotor_axis_no,
+                                st_axis_status_type *pst_axis_status)
+{
+  void *const pValues[] = {
+    &pst_axis_status->bEnable,        /*  1 */
+    &pst_axis_status->bReset,         /*  2 */
+    &pst_axis_status->bExecute,       /*  3 */
+    &pst_axis_status->nCommand,       /*  4 */
+    &pst_axis_status->nCmdData,       /*  5 */
+    &pst_axis_status->fVelocity,      /*  6 */
+    &pst_axis_status->fPosition,      /*  7 */
+    &pst_axis_status->fAcceleration,  /*  8 */
+    &pst_axis_status->fDecceleration, /*  9 */
+    &pst_axis_status->bJogFwd,        /* 10 */
+    &pst_axis_status->bJogBwd,        /* 11 */
+    &pst_axis_status->bLimitFwd,      /* 12 */
+    &pst_axis_status->bLimitBwd,      /* 13 */
+    &pst_axis_status->fOverride,      /* 14 */
+    &pst_axis_status->bHomeSensor,    /* 15 */
+    &pst_axis_status->bEnabled,       /* 16 */
+    &pst_axis_status->bError,         /* 17 */
+    &pst_axis_status->nErrorId,       /* 18 */
+    &pst_axis_status->fActVelocity,   /* 19 */
+    &pst_axis_status->fActPosition,   /* 20 */
+    &pst_axis_status->fActDiff,       /* 21 */
+    &pst_axis_status->bHomed,         /* 22 */
+    &pst_axis_status->bBusy           /* 23 */
+  };
+  const char *p = skipMainDot(inString);
+  if (!p) return 0;
+  return parseAxisStatus(p, ".stAxisStatus", pMotor_axis_no,
+                         "ddduuffffd" "dddfdddufffdd", pValues);
+}
+
+int EthercatMCParseAxisStatusV2(const char *inString, int *pMotor_axis_no,
+                                st_axis_status_type *pst_axis_status)
+{
+  struct {
+    double velocitySetpoint;
+    int cycleCounter;
+    unsigned int EtherCATtime_low32;
+    unsigned int EtherCATtime_high32;
+    int command;
+    int cmdData;
+    int reset;
+    int moving;
+    int stall;
+  } notUsed;
+  void *const pValues[] = {
+    &pst_axis_status->fPosition,
+    &pst_axis_status->fActPosition,
+    &pst_axis_status->positionRaw,          /* Send as uint64; parsed as double ! */
+    &notUsed.velocitySetpoint,
+    &pst_axis_status->fActVelocity,
+    &pst_axis_status->fAcceleration,
+    &pst_axis_status->fDecceleration,
+    &notUsed.cycleCounter,
+    &notUsed.EtherCATtime_low32,
+    &notUsed.EtherCATtime_high32,
+    &pst_axis_status->bEnable,
+    &pst_axis_status->bEnabled,
+    &pst_axis_status->bExecute,
+    &notUsed.command,
+    &notUsed.cmdData,
+    &pst_axis_status->bLimitBwd,
+    &pst_axis_status->bLimitFwd,
+    &pst_axis_status->bHomeSensor,
+    &pst_axis_status->bError,
+    &pst_axis_status->nErrorId,
+    &notUsed.reset,
+    &pst_axis_status->bHomed,
+    &pst_axis_status->bBusy,
+    &pst_axis_status->atTarget,
+    &notUsed.moving,
+    &notUsed.stall
+  };
+  const char *p = skipMainDot(inString);
+  if (!p) return 0;
+  return parseAxisStatus(p, ".stAxisStatusV2", pMotor_axis_no,
+                         "fffffff" "ddddddddddddddddddd", pValues);
+}
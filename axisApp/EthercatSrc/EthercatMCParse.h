@@ -0,0 +1,52 @@
+/*
+FILENAME...   EthercatMCParse.h
+*/
+
+#ifndef ETHERCATMCPARSE_H
+#define ETHERCATMCPARSE_H
+
+typedef struct {
+  /* V1 members */
+  int bEnable;           /*  1 */
+  int bReset;            /*  2 */
+  int bExecute;          /*  3 */
+  int nCommand;          /*  4 */
+  int nCmdData;          /*  5 */
+  double fVelocity;      /*  6 */
+  double fPosition;      /*  7 */
+  double fAcceleration;  /*  8 */
+  double fDecceleration; /*  9 */
+  int bJogFwd;           /* 10 */
+  int bJogBwd;           /* 11 */
+  int bLimitFwd;         /* 12 */
+  int bLimitBwd;         /* 13 */
+  double fOverride;      /* 14 */
+  int bHomeSensor;       /* 15 */
+  int bEnabled;          /* 16 */
+  int bError;            /* 17 */
+  int nErrorId;          /* 18 */
+  double fActVelocity;   /* 19 */
+  double fActPosition;   /* 20 */
+  double fActDiff;       /* 21 */
+  int bHomed;            /* 22 */
+  int bBusy;             /* 23 */
+  /* V2 members */
+  double positionRaw;
+  int atTarget;
+  /* neither V1 nor V2, but calculated here */
+  int mvnNRdyNex; /* Not in struct. Calculated in poll() */
+  int motorStatusDirection; /* Not in struct. Calculated in pollAll() */
+  int motorDiffPostion;     /* Not in struct. Calculated in poll() */
+} st_axis_status_type;
+
+/* Parsers for the replies to "Main.M<n>.stAxisStatus?" (V1) and
+   "Main.M<n>.stAxisStatusV2?" (V2).
+   They give the same results as the sscanf() formats they replace,
+   including the return value (the number of converted fields, 24 for
+   a complete V1 status, 27 for V2), but do not depend on the locale */
+int EthercatMCParseAxisStatusV1(const char *inString, int *pMotor_axis_no,
+                                st_axis_status_type *pst_axis_status);
+int EthercatMCParseAxisStatusV2(const char *inString, int *pMotor_axis_no,
+                                st_axis_status_type *pst_axis_status);
+
+#endif
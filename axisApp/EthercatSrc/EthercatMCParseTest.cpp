@@ -0,0 +1,296 @@
+/*
+  FILENAME... EthercatMCParseTest.cpp
+
+  Compares EthercatMCParseAxisStatusV1()/V2() with the sscanf()
+  formats that had been used in EthercatMCAxis::pollAll() before,
+  and measures the time needed by both.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <epicsString.h>
+#include <epicsTime.h>
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+#include "EthercatMCParse.h"
+
+#define NUM_RANDOM_REPLIES 5000
+#define NUM_BENCHMARK_LOOPS 100000
+
+static int sscanfAxisStatusV1(const char *inString, int *pMotor_axis_no,
+                              st_axis_status_type *pst_axis_status)
+{
+  const char * const Main_dot_str = "Main.";
+  const size_t       Main_dot_len = strlen(Main_dot_str);
+
+  if (epicsStrnCaseCmp(inString, Main_dot_str, Main_dot_len)) return 0;
+  return sscanf(&inString[Main_dot_len],
+                "M%d.stAxisStatus="
+                "%d,%d,%d,%u,%u,%lf,%lf,%lf,%lf,%d,"
+                "%d,%d,%d,%lf,%d,%d,%d,%u,%lf,%lf,%lf,%d,%d",
+                pMotor_axis_no,
+                &pst_axis_status->bEnable,        /*  1 */
+                &pst_axis_status->bReset,         /*  2 */
+                &pst_axis_status->bExecute,       /*  3 */
+                &pst_axis_status->nCommand,       /*  4 */
+                &pst_axis_status->nCmdData,       /*  5 */
+                &pst_axis_status->fVelocity,      /*  6 */
+                &pst_axis_status->fPosition,      /*  7 */
+                &pst_axis_status->fAcceleration,  /*  8 */
+                &pst_axis_status->fDecceleration, /*  9 */
+                &pst_axis_status->bJogFwd,        /* 10 */
+                &pst_axis_status->bJogBwd,        /* 11 */
+                &pst_axis_status->bLimitFwd,      /* 12 */
+                &pst_axis_status->bLimitBwd,      /* 13 */
+                &pst_axis_status->fOverride,      /* 14 */
+                &pst_axis_status->bHomeSensor,    /* 15 */
+                &pst_axis_status->bEnabled,       /* 16 */
+                &pst_axis_status->bError,         /* 17 */
+                &pst_axis_status->nErrorId,       /* 18 */
+                &pst_axis_status->fActVelocity,   /* 19 */
+                &pst_axis_status->fActPosition,   /* 20 */
+                &pst_axis_status->fActDiff,       /* 21 */
+                &pst_axis_status->bHomed,         /* 22 */
+                &pst_axis_status->bBusy           /* 23 */);
+}
+
+static int sscanfAxisStatusV2(const char *inString, int *pMotor_axis_no,
+                              st_axis_status_type *pst_axis_status)
+{
+  const char * const Main_dot_str = "Main.";
+  const size_t       Main_dot_len = strlen(Main_dot_str);
+  struct {
+    double velocitySetpoint;
+    int cycleCounter;
+    unsigned int EtherCATtime_low32;
+    unsigned int EtherCATtime_high32;
+    int command;
+    int cmdData;
+    int reset;
+    int moving;
+    int stall;
+  } notUsed;
+
+  if (epicsStrnCaseCmp(inString, Main_dot_str, Main_dot_len)) return 0;
+  return sscanf(&inString[Main_dot_len],
+                "M%d.stAxisStatusV2="
+                "%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
+                pMotor_axis_no,
+                &pst_axis_status->fPosition,
+                &pst_axis_status->fActPosition,
+                &pst_axis_status->positionRaw,
+                &notUsed.velocitySetpoint,
+                &pst_axis_status->fActVelocity,
+                &pst_axis_status->fAcceleration,
+                &pst_axis_status->fDecceleration,
+                &notUsed.cycleCounter,
+                &notUsed.EtherCATtime_low32,
+                &notUsed.EtherCATtime_high32,
+                &pst_axis_status->bEnable,
+                &pst_axis_status->bEnabled,
+                &pst_axis_status->bExecute,
+                &notUsed.command,
+                &notUsed.cmdData,
+                &pst_axis_status->bLimitBwd,
+                &pst_axis_status->bLimitFwd,
+                &pst_axis_status->bHomeSensor,
+                &pst_axis_status->bError,
+                &pst_axis_status->nErrorId,
+                &notUsed.reset,
+                &pst_axis_status->bHomed,
+                &pst_axis_status->bBusy,
+                &pst_axis_status->atTarget,
+                &notUsed.moving,
+                &notUsed.stall);
+}
+
+typedef int (*parseFunc)(const char *, int *, st_axis_status_type *);
+
+/* Both parsers must return the same, and fill in the same bits */
+static int sameResult(parseFunc reference, parseFunc parser, const char *inString)
+{
+  st_axis_status_type refStatus;
+  st_axis_status_type status;
+  int refMotor_axis_no = -1;
+  int motor_axis_no = -1;
+  int refNvals, nvals;
+
+  memset(&refStatus, 0, sizeof(refStatus));
+  memset(&status, 0, sizeof(status));
+  refNvals = reference(inString, &refMotor_axis_no, &refStatus);
+  nvals = parser(inString, &motor_axis_no, &status);
+  if (refNvals != nvals || refMotor_axis_no != motor_axis_no ||
+      memcmp(&refStatus, &status, sizeof(status))) {
+    testDiag("in=\"%s\" nvals=%d/%d motor_axis_no=%d/%d",
+             inString, refNvals, nvals, refMotor_axis_no, motor_axis_no);
+    return 0;
+  }
+  return 1;
+}
+
+static const char *const fixedReplies[] = {
+  /* As sent by the simulator and the MCU */
+  "Main.M1.stAxisStatus=1,0,0,3,0,0,0,0,0,0,0,1,1,0,0,1,0,0,0,100.1,0,1,0",
+  "Main.M12.stAxisStatus=1,0,1,3,0,17.5,42.25,100,100,0,0,1,1,0,0,1,1,17185,17.5,-3.125e-05,0.0001,1,1",
+  "Main.M1.stAxisStatusV2=10,9.99996,1234567,10,0,50,50,1234,99,12345,1,1,0,3,0,1,1,0,0,0,0,1,0,1,0,0",
+  "Main.M3.stAxisStatusV2=-0,-1e-7,18446744073709551615,3.4028234663852886e+38,1E22,1e23,.5,"
+  "-2147483648,4294967295,2147483648,1,1,1,1,1,1,1,1,1,17185,0,1,1,0,1,0",
+  "main.M2.stAxisStatusV2=0.1,0.2,0.3,123456789.123456789,2.2250738585072014e-308,4.9e-324,7,"
+  "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19",
+  "Main.M2.stAxisStatusV2=inf,-inf,nan,0x1p3,1e,5.,+3,"
+  "+1,-2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19",
+  "Main.M1.stAxisStatusV2= 1, 2,\t3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26",
+  /* Broken, truncated or unexpected */
+  "",
+  "Main.",
+  "Main.M",
+  "Main.Mx",
+  "Main.M1",
+  "Main.M1.stAxisStatus",
+  "Main.M1.stAxisStatusV2=",
+  "Main.M1.stAxisStatusV2=1,2,3",
+  "Main.M1.stAxisStatusV2=1,2,3,",
+  "Main.M1.stAxisStatusV2=1;2,3",
+  "Main.M1.stAxisStatusV2=1,2,3,4,5,6,7,8.5,9",
+  "Main.M1.stAxisStatusV2=1e+,1e-,1.e2,-,3",
+  "Main.M1.stAxisStatusV2=1,2,0x,3",
+  "Main.M1.stAxisStatus=1,0,0,-3,-1,0,0,0,0,0,0,1,1,0,0,1,0,-1,0,100.1,0,1,0",
+  "Main.M1.stAxisStatus=1,0,0,3,0,0,0,0,0,0,0,1,1,0,0,1,0,99999999999999999999,0,1,0,1,0",
+  "Main.M1.bBusy?",
+  "Error: 1234",
+};
+
+/* A pseudo random number generator that gives the same on all platforms */
+static unsigned int randomState = 12345;
+static unsigned int randomNumber(void)
+{
+  randomState = randomState * 1103515245U + 12345U;
+  return (randomState >> 8) & 0xFFFFFF;
+}
+
+static double randomDouble(void)
+{
+  double value = (double)randomNumber() / (double)(1 << (randomNumber() % 24));
+  if (randomNumber() & 1) value = -value;
+  return value;
+}
+
+static void randomDoubleString(char *buf, size_t len)
+{
+  switch (randomNumber() % 4) {
+    case 0: snprintf(buf, len, "%g", randomDouble()); break;
+    case 1: snprintf(buf, len, "%.17g", randomDouble()); break;
+    case 2: snprintf(buf, len, "%.3f", randomDouble()); break;
+    default: snprintf(buf, len, "%e", randomDouble() * 1e-9);
+  }
+}
+
+static void randomReplyV1(char *buf, size_t len)
+{
+  char f[9][40];
+  unsigned i;
+  for (i = 0; i < sizeof(f)/sizeof(f[0]); i++) {
+    randomDoubleString(f[i], sizeof(f[i]));
+  }
+  snprintf(buf, len, "Main.M%u.stAxisStatus="
+           "%u,%u,%u,%u,%u,%s,%s,%s,%s,%u,%u,%u,%u,%s,%u,%u,%u,%u,%s,%s,%s,%u,%u",
+           randomNumber() % 64,
+           randomNumber() & 1, randomNumber() & 1, randomNumber() & 1,
+           randomNumber() % 11, randomNumber() % 16,
+           f[0], f[1], f[2], f[3],
+           randomNumber() & 1, randomNumber() & 1, randomNumber() & 1, randomNumber() & 1,
+           f[4],
+           randomNumber() & 1, randomNumber() & 1, randomNumber() & 1,
+           randomNumber() & 0xFFFFF,
+           f[5], f[6], f[7],
+           randomNumber() & 1, randomNumber() & 1);
+}
+
+static void randomReplyV2(char *buf, size_t len)
+{
+  char f[7][40];
+  unsigned i;
+  for (i = 0; i < sizeof(f)/sizeof(f[0]); i++) {
+    randomDoubleString(f[i], sizeof(f[i]));
+  }
+  snprintf(buf, len, "Main.M%u.stAxisStatusV2="
+           "%s,%s,%u%u,%s,%s,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u",
+           randomNumber() % 64,
+           f[0], f[1], randomNumber(), randomNumber(), f[3], f[4], f[5], f[6],
+           randomNumber(), randomNumber(), randomNumber(),
+           randomNumber() & 1, randomNumber() & 1, randomNumber() & 1,
+           randomNumber() % 11, randomNumber() % 16,
+           randomNumber() & 1, randomNumber() & 1, randomNumber() & 1,
+           randomNumber() & 1, randomNumber() & 0xFFFFF,
+           randomNumber() & 1, randomNumber() & 1, randomNumber() & 1,
+           randomNumber() & 1, randomNumber() & 1, randomNumber() & 1);
+}
+
+static void testFixedReplies(void)
+{
+  unsigned i;
+  testDiag("Fixed replies");
+  for (i = 0; i < sizeof(fixedReplies)/sizeof(fixedReplies[0]); i++) {
+    testOk(sameResult(sscanfAxisStatusV1, EthercatMCParseAxisStatusV1, fixedReplies[i]),
+           "V1 \"%s\"", fixedReplies[i]);
+    testOk(sameResult(sscanfAxisStatusV2, EthercatMCParseAxisStatusV2, fixedReplies[i]),
+           "V2 \"%s\"", fixedReplies[i]);
+  }
+}
+
+static void testRandomReplies(void)
+{
+  char buf[512];
+  unsigned failedV1 = 0;
+  unsigned failedV2 = 0;
+  unsigned i;
+  testDiag("%u random replies", NUM_RANDOM_REPLIES);
+  for (i = 0; i < NUM_RANDOM_REPLIES; i++) {
+    randomReplyV1(buf, sizeof(buf));
+    if (!sameResult(sscanfAxisStatusV1, EthercatMCParseAxisStatusV1, buf)) failedV1++;
+    randomReplyV2(buf, sizeof(buf));
+    if (!sameResult(sscanfAxisStatusV2, EthercatMCParseAxisStatusV2, buf)) failedV2++;
+  }
+  testOk(!failedV1, "V1 random replies failed=%u", failedV1);
+  testOk(!failedV2, "V2 random replies failed=%u", failedV2);
+}
+
+static double benchmark(parseFunc parser, const char *inString)
+{
+  st_axis_status_type status;
+  int motor_axis_no;
+  epicsTimeStamp start, end;
+  unsigned i;
+  epicsTimeGetCurrent(&start);
+  for (i = 0; i < NUM_BENCHMARK_LOOPS; i++) {
+    (void)parser(inString, &motor_axis_no, &status);
+  }
+  epicsTimeGetCurrent(&end);
+  return epicsTimeDiffInSeconds(&end, &start) * 1e9 / NUM_BENCHMARK_LOOPS;
+}
+
+static void testBenchmark(void)
+{
+  char bufV1[512];
+  char bufV2[512];
+  randomReplyV1(bufV1, sizeof(bufV1));
+  randomReplyV2(bufV2, sizeof(bufV2));
+  testDiag("Benchmark, ns per reply (%u loops)", NUM_BENCHMARK_LOOPS);
+  testDiag("V1 sscanf=%.0f parser=%.0f",
+           benchmark(sscanfAxisStatusV1, bufV1),
+           benchmark(EthercatMCParseAxisStatusV1, bufV1));
+  testDiag("V2 sscanf=%.0f parser=%.0f",
+           benchmark(sscanfAxisStatusV2, bufV2),
+           benchmark(EthercatMCParseAxisStatusV2, bufV2));
+}
+
+MAIN(EthercatMCParseTest)
+{
+  testPlan(2 * sizeof(fixedReplies)/sizeof(fixedReplies[0]) + 2);
+  testFixedReplies();
+  testRandomReplies();
+  testBenchmark();
+  return testDone();
+}
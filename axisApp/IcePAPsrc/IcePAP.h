@@ -39,6 +39,7 @@ public:
   asynStatus home(double min_velocity, double max_velocity, double acceleration, int forwards);
   asynStatus stop(double acceleration);
   asynStatus poll(bool *moving);
+  asynStatus slowPoll(int item);
 
 private:
   IcePAPController *pC_;          /**< Pointer to the asynAxisController to which this axis belongs.
@@ -51,6 +52,15 @@ private:
     } cfg;
     unsigned int lastCommandIsHoming;
     char errbuf[256];
+    /* Read by IcePAPController::poll() for all axes, valid for one poll */
+    struct {
+      unsigned int status;
+      int motorPosition;
+      int encoderPosition;
+      int valid;
+      int encoderValid;
+    } cache;
+    int homestatSlowPoll; /* Slow poll item which reads HOMESTAT */
   } drvlocal;
 
   void handleStatusChange(asynStatus status);
@@ -78,6 +88,7 @@ private:
 class epicsShareClass IcePAPController : public asynAxisController {
 public:
   IcePAPController(const char *portName, const char *IcePAPPortName, int numAxes, double movingPollPeriod, double idlePollPeriod);
+  virtual ~IcePAPController();
 
   void report(FILE *fp, int level);
   asynStatus writeReadOnErrorDisconnect(void);
@@ -85,6 +96,7 @@ public:
 
   IcePAPAxis* getAxis(asynUser *pasynUser);
   IcePAPAxis* getAxis(int axisNo);
+  asynStatus poll();
   protected:
   void handleStatusChange(asynStatus status);
   asynStatus writeInt32(asynUser *pasynUser, epicsInt32 value);
@@ -107,5 +119,19 @@ public:
   #define LAST_VIRTUAL_PARAM EthercatMCErrRst_
   #define NUM_VIRTUAL_MOTOR_PARAMS ((int) (&LAST_VIRTUAL_PARAM - &FIRST_VIRTUAL_PARAM + 1))
 
+  /* Polling of all axes with one query, see poll() */
+  asynStatus readAllAxes(const char *var, const char *extra, int base,
+                         IcePAPAxis **axes, int numAxes, int *values,
+                         bool *pRejected);
+  bool pollAllAxes_;        /**< ?FSTATUS and ?FPOS of all axes are supported */
+  bool pollAllEncoders_;    /**< ?FPOS of the encoders of all axes is supported */
+  IcePAPAxis **pollAxes_;   /**< The axes which are polled in this cycle */
+  IcePAPAxis **pollEncoderAxes_; /**< The axes of pollAxes_ with the same external encoder */
+  int *pollValues_;         /**< The values of pollAxes_ of one query */
+  char *pollOutString_;     /**< Query for all axes, longer than outString_ */
+  char *pollInString_;      /**< Reply for all axes, longer than inString_ */
+  size_t pollOutSize_;
+  size_t pollInSize_;
+
   friend class IcePAPAxis;
 };
@@ -14,6 +14,9 @@
 #define ASYN_TRACE_INFO      0x0040
 #endif
 
+/* Seconds between two reads of HOMESTAT, when the status word does not change */
+#define HOMESTAT_SLOW_POLL_PERIOD 10.0
+
 /* Page 21 */
 #define STATUS_BIT_0         (1<<0)
 #define STATUS_BIT_1         (1<<1)
@@ -99,6 +102,7 @@ IcePAPAxis::IcePAPAxis(IcePAPController *pC, int axisNo,
     }
     free(pOptions);
   }
+  drvlocal.homestatSlowPoll = addSlowPoll(HOMESTAT_SLOW_POLL_PERIOD);
 
   pC_->wakeupPoller();
 }
@@ -132,6 +136,7 @@ void IcePAPAxis::handleStatusChange(asynStatus newStatus)
   asynPrint(pC_->pasynUserController_, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
             "IcePAPAxis::handleStatusChange status=%s (%d)\n",
             pasynManager->strStatus(newStatus), (int)newStatus);
+  requestSlowPoll(drvlocal.homestatSlowPoll);
   if (newStatus == asynSuccess) {
     if (drvlocal.cfg.axisFlags & AMPLIFIER_ON_FLAG_CREATE_AXIS) {
       /* Enable the amplifier when the axis is created,
@@ -507,16 +512,20 @@ asynStatus IcePAPAxis::poll(bool *moving)
   *pC_->inString_ = '\0';
   memset(&st_axis_status, 0, sizeof(st_axis_status));
 
-  /* Phase 1: read the Axis status */
-  sprintf(pC_->outString_, "%d:?STATUS", axisNo_);
-  comStatus = pC_->writeReadController();
-  if (comStatus) goto badpollall;
-  nvals = sscanf(pC_->inString_,
-                 "%d:?STATUS %x",
-                 &motor_axis_no,
-                 &st_axis_status.status);
-  if (nvals != 2) goto badpollall;
-  if (axisNo_ != motor_axis_no) goto badpollall;
+  /* Phase 1: read the Axis status, IcePAPController::poll() may have read it already */
+  if (drvlocal.cache.valid) {
+    st_axis_status.status = drvlocal.cache.status;
+  } else {
+    sprintf(pC_->outString_, "%d:?STATUS", axisNo_);
+    comStatus = pC_->writeReadController();
+    if (comStatus) goto badpollall;
+    nvals = sscanf(pC_->inString_,
+                   "%d:?STATUS %x",
+                   &motor_axis_no,
+                   &st_axis_status.status);
+    if (nvals != 2) goto badpollall;
+    if (axisNo_ != motor_axis_no) goto badpollall;
+  }
   setIntegerParam(pC_->motorStatusProblem_, 0); //st_axis_status.status & STATUS_BITS_DISABLE);
   setIntegerParam(pC_->motorStatusAtHome_, st_axis_status.status & STATUS_BIT_HSIGNAL);
   if (drvlocal.lastCommandIsHoming) {
@@ -530,8 +539,12 @@ asynStatus IcePAPAxis::poll(bool *moving)
   setIntegerParam(pC_->motorStatusPowerOn_, st_axis_status.status & STATUS_BIT_POWERON);
 
   /* Phase 2: read the Axis (readback) position */
-  comStatus = getFastValueFromAxis("FPOS", "", &st_axis_status.motorPosition);
-  if (comStatus) goto badpollall;
+  if (drvlocal.cache.valid) {
+    st_axis_status.motorPosition = drvlocal.cache.motorPosition;
+  } else {
+    comStatus = getFastValueFromAxis("FPOS", "", &st_axis_status.motorPosition);
+    if (comStatus) goto badpollall;
+  }
   /* Use previous motorPosition and current motorPosition to calculate direction.*/
   if (st_axis_status.motorPosition > drvlocal.lastpoll.motorPosition) {
     setIntegerParam(pC_->motorStatusDirection_, 1);
@@ -542,7 +555,12 @@ asynStatus IcePAPAxis::poll(bool *moving)
   setDoubleParam(pC_->motorPosition_, st_axis_status.motorPosition);
 
   if (drvlocal.cfg.externalEncoderStr) {
-    comStatus = getFastValueFromAxis("FPOS", drvlocal.cfg.externalEncoderStr, &encPosition);
+    if (drvlocal.cache.encoderValid) {
+      encPosition = drvlocal.cache.encoderPosition;
+      comStatus = asynSuccess;
+    } else {
+      comStatus = getFastValueFromAxis("FPOS", drvlocal.cfg.externalEncoderStr, &encPosition);
+    }
     if (!comStatus) {
       hasEncoder = 1;
       setDoubleParam(pC_->motorEncoderPosition_, encPosition);
@@ -551,6 +569,7 @@ asynStatus IcePAPAxis::poll(bool *moving)
 
   if (drvlocal.lastpoll.status != st_axis_status.status) {
     unsigned int status = st_axis_status.status;
+    requestSlowPoll(drvlocal.homestatSlowPoll);
     asynPrint(pC_->pasynUserController_, ASYN_TRACE_INFO,
               "poll(%d) 0x%x %s%s%s%s%s%s%s%s %s=%d\n",
               axisNo_, st_axis_status.status,
@@ -576,22 +595,6 @@ asynStatus IcePAPAxis::poll(bool *moving)
   setIntegerParam(pC_->motorStatusDone_, !nowMoving);
   *moving = nowMoving ? true : false;
 
-  /* Phase 4: Is the axis homed */
-  {
-    const char *found_str = "FOUND";
-    int homed = 0;
-    char homeencbuf[128];
-    asynStatus comStatus;
-
-    comStatus = getValueFromAxis("HOMESTAT", (int)sizeof(homeencbuf), &homeencbuf[0]);
-    if (!comStatus) {
-      if (!strncmp(homeencbuf, found_str, strlen(found_str))) {
-        homed = 1;
-      }
-    }
-    setIntegerParam(pC_->motorStatusHomed_, homed);
-  }
-
   if (memcmp(st_axis_status.errbuf, drvlocal.errbuf, sizeof(drvlocal.errbuf))) {
     setIntegerParam(pC_->EthercatMCErr_, 0);
     //setIntegerParam(pC_->EthercatMCErrId_, 0);
@@ -599,10 +602,15 @@ asynStatus IcePAPAxis::poll(bool *moving)
     memcpy(drvlocal.errbuf, st_axis_status.errbuf, sizeof(drvlocal.errbuf));
   }
 
+  drvlocal.cache.valid = 0;
+  drvlocal.cache.encoderValid = 0;
   callParamCallbacks();
   return asynSuccess;
 
   badpollall:
+  drvlocal.cache.valid = 0;
+  drvlocal.cache.encoderValid = 0;
+  requestSlowPoll(drvlocal.homestatSlowPoll);
   asynPrint(pC_->pasynUserController_, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
             "out=%s in=%s return=%s (%d)\n",
             pC_->outString_, pC_->inString_,
@@ -613,6 +621,29 @@ asynStatus IcePAPAxis::poll(bool *moving)
   return asynError;
 }
 
+/** Reads the homed status, which is a slow poll item.
+ * There is no query for all axes, the poller reads it every HOMESTAT_SLOW_POLL_PERIOD
+ * seconds, and in the next poll cycle after the status word changed.
+ * \param[in] item The slow poll item
+ */
+asynStatus IcePAPAxis::slowPoll(int item)
+{
+  const char *found_str = "FOUND";
+  int homed = 0;
+  char homeencbuf[128];
+  asynStatus comStatus;
+
+  if (item != drvlocal.homestatSlowPoll) return asynSuccess;
+  comStatus = getValueFromAxis("HOMESTAT", (int)sizeof(homeencbuf), &homeencbuf[0]);
+  if (!comStatus) {
+    if (!strncmp(homeencbuf, found_str, strlen(found_str))) {
+      homed = 1;
+    }
+  }
+  setIntegerParam(pC_->motorStatusHomed_, homed);
+  return comStatus;
+}
+
 asynStatus IcePAPAxis::setIntegerParam(int function, int value)
 {
   asynStatus status;
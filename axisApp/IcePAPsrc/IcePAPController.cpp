@@ -6,9 +6,11 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <ctype.h>
 
 #include <iocsh.h>
 #include <epicsThread.h>
+#include <epicsStdio.h>
 
 #include <asynOctetSyncIO.h>
 
@@ -44,6 +46,19 @@ IcePAPController::IcePAPController(const char *portName, const char *MotorPortNa
   createParam(EthercatMCDec_RBString,        asynParamFloat64,     &EthercatMCDec_RB_);
 
   createParam(EthercatMCErrRstString,        asynParamInt32,       &EthercatMCErrRst_);
+
+  /* poll() queries all axes at once: up to 3 digits and a blank per axis in the query,
+     up to 11 characters and a blank per axis in the reply */
+  pollAxes_        = (IcePAPAxis **)calloc(numAxes, sizeof(IcePAPAxis *));
+  pollEncoderAxes_ = (IcePAPAxis **)calloc(numAxes, sizeof(IcePAPAxis *));
+  pollValues_      = (int *)calloc(numAxes, sizeof(int));
+  pollOutSize_     = MAX_CONTROLLER_STRING_SIZE + 4*numAxes;
+  pollInSize_      = MAX_CONTROLLER_STRING_SIZE + 12*numAxes;
+  pollOutString_   = (char *)calloc(pollOutSize_, 1);
+  pollInString_    = (char *)calloc(pollInSize_, 1);
+  pollAllAxes_     = true;
+  pollAllEncoders_ = true;
+
   /* Connect to IcePAP controller */
   status = pasynOctetSyncIO->connect(MotorPortName, 0, &pasynUserController_, NULL);
   if (status) {
@@ -53,6 +68,15 @@ IcePAPController::IcePAPController(const char *portName, const char *MotorPortNa
   startPoller(movingPollPeriod, idlePollPeriod, 2);
 }
 
+IcePAPController::~IcePAPController()
+{
+  free(pollAxes_);
+  free(pollEncoderAxes_);
+  free(pollValues_);
+  free(pollOutString_);
+  free(pollInString_);
+}
+
 
 /** Creates a new IcePAPController object.
  * Configuration command, called directly or from iocsh
@@ -158,6 +182,164 @@ void IcePAPController::handleStatusChange(asynStatus status)
   }
 }
 
+/** Polls the controller.
+ * Reads the status and the position of the axes which are polled in this cycle
+ * with one ?FSTATUS and one ?FPOS for all of them, and the positions of their external
+ * encoders with one ?FPOS per encoder source, instead of the queries of each axis.
+ * IcePAPAxis::poll() takes the values from its cache.
+ * If a query fails, the axes read their values on their own and report the error.
+ * A query which the controller does not know is not sent again, any other error,
+ * e.g. of a driver which is powered off, only affects this cycle.
+ */
+asynStatus IcePAPController::poll()
+{
+  IcePAPAxis *pAxis;
+  const char *encoderStr;
+  asynStatus status;
+  bool rejected;
+  int numDue = 0;
+  int numEncoder;
+  int i, j;
+
+  for (i=0; i<numAxes_; i++) {
+    pAxis = getAxis(i);
+    if (!pAxis) continue;
+    pAxis->drvlocal.cache.valid = 0;
+    pAxis->drvlocal.cache.encoderValid = 0;
+  }
+  /* pollCycle() polls the axes in pollDueAxes_ in this cycle */
+  for (i=0; i<numPollDueAxes_; i++) {
+    pAxis = getAxis(pollDueAxes_[i]);
+    if (pAxis) pollAxes_[numDue++] = pAxis;
+  }
+  if (!numDue || !pollAllAxes_) return asynSuccess;
+
+  status = readAllAxes("FSTATUS", NULL, 16, pollAxes_, numDue, pollValues_, &rejected);
+  if (status) {
+    if (rejected) pollAllAxes_ = false;
+    return asynSuccess;
+  }
+  for (i=0; i<numDue; i++) {
+    pollAxes_[i]->drvlocal.cache.status = (unsigned int)pollValues_[i];
+  }
+  status = readAllAxes("FPOS", NULL, 10, pollAxes_, numDue, pollValues_, &rejected);
+  if (status) {
+    if (rejected) pollAllAxes_ = false;
+    return asynSuccess;
+  }
+  for (i=0; i<numDue; i++) {
+    pollAxes_[i]->drvlocal.cache.motorPosition = pollValues_[i];
+    pollAxes_[i]->drvlocal.cache.valid = 1;
+  }
+
+  for (i=0; i<numDue && pollAllEncoders_; i++) {
+    encoderStr = pollAxes_[i]->drvlocal.cfg.externalEncoderStr;
+    if (!encoderStr) continue;
+    /* Only the first axis of each encoder source queries all of them */
+    for (j=0; j<i; j++) {
+      if (pollAxes_[j]->drvlocal.cfg.externalEncoderStr &&
+          !strcmp(pollAxes_[j]->drvlocal.cfg.externalEncoderStr, encoderStr)) break;
+    }
+    if (j < i) continue;
+    numEncoder = 0;
+    for (j=i; j<numDue; j++) {
+      if (pollAxes_[j]->drvlocal.cfg.externalEncoderStr &&
+          !strcmp(pollAxes_[j]->drvlocal.cfg.externalEncoderStr, encoderStr)) {
+        pollEncoderAxes_[numEncoder++] = pollAxes_[j];
+      }
+    }
+    status = readAllAxes("FPOS", encoderStr, 10, pollEncoderAxes_, numEncoder, pollValues_,
+                         &rejected);
+    if (status) {
+      if (rejected) pollAllEncoders_ = false;
+      continue;
+    }
+    for (j=0; j<numEncoder; j++) {
+      pollEncoderAxes_[j]->drvlocal.cache.encoderPosition = pollValues_[j];
+      pollEncoderAxes_[j]->drvlocal.cache.encoderValid = 1;
+    }
+  }
+  return asynSuccess;
+}
+
+/** Checks if the message of an ERROR reply says that the command is not known.
+ * \param[in] msg The message after "ERROR"
+ */
+static bool isUnknownCommand(const char *msg)
+{
+  static const char *unknownMsgs[] = {"not recognised", "not recognized", "unknown command"};
+  char lower[64];
+  size_t i;
+
+  for (i=0; msg[i] && (i < sizeof(lower)-1); i++) lower[i] = (char)tolower((unsigned char)msg[i]);
+  lower[i] = '\0';
+  for (i=0; i<sizeof(unknownMsgs)/sizeof(unknownMsgs[0]); i++) {
+    if (strstr(lower, unknownMsgs[i])) return true;
+  }
+  return false;
+}
+
+/** Reads a value of several axes with one query, like "?FPOS 1 2 3"
+ * \param[in] var The name of the variable, e.g. FSTATUS or FPOS
+ * \param[in] extra Put between the variable and the axes, e.g. the encoder source, or NULL
+ * \param[in] base The base of the numbers in the reply, 16 or 10
+ * \param[in] axes The axes
+ * \param[in] numAxes The number of axes
+ * \param[out] values The value of each axis
+ * \param[out] pRejected The controller does not know the query, e.g. because of an
+ *             old firmware, it is not tried again. Other errors do not set this
+ */
+asynStatus IcePAPController::readAllAxes(const char *var, const char *extra, int base,
+                                         IcePAPAxis **axes, int numAxes, int *values,
+                                         bool *pRejected)
+{
+  asynStatus status;
+  size_t len;
+  size_t nread;
+  size_t varlen = strlen(var);
+  const char *pIn;
+  char *pEnd;
+  int i;
+
+  *pRejected = false;
+  len = epicsSnprintf(pollOutString_, pollOutSize_, "?%s%s%s",
+                      var, extra ? " " : "", extra ? extra : "");
+  for (i=0; (i<numAxes) && (len < pollOutSize_); i++) {
+    len += epicsSnprintf(pollOutString_+len, pollOutSize_-len, " %d", axes[i]->axisNo_);
+  }
+  if (len >= pollOutSize_) return asynError;
+  *pollInString_ = '\0';
+  status = writeReadController(pollOutString_, pollInString_, pollInSize_,
+                               &nread, DEFAULT_CONTROLLER_TIMEOUT);
+  if (status) goto badreply;
+
+  /* The reply starts with the query, without the axes: "?FPOS 100 -200 300",
+   * or it is an error like "?FPOS ERROR Board is not present in the system" */
+  pIn = pollInString_;
+  status = asynError;
+  if ((pIn[0] != '?') || strncmp(pIn+1, var, varlen)) goto badreply;
+  pIn += 1 + varlen;
+  if (!strncmp(pIn, " ERROR", 6)) {
+    *pRejected = isUnknownCommand(pIn + 6);
+    goto badreply;
+  }
+  for (i=0; i<numAxes; i++) {
+    if (base == 10) values[i] = (int)strtol(pIn, &pEnd, 10);
+    else            values[i] = (int)strtoul(pIn, &pEnd, base);
+    if (pEnd == pIn) goto badreply;
+    pIn = pEnd;
+  }
+  return asynSuccess;
+
+  badreply:
+  asynPrint(pasynUserController_, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
+            "out=%s in=%s return=%s (%d)%s\n",
+            pollOutString_, pollInString_,
+            pasynManager->strStatus(status), (int)status,
+            *pRejected ? ", the axes are polled one by one from now on" : "");
+  return asynError;
+}
+
 /** Reports on status of the driver
  * \param[in] fp The file pointer on which report information will be written
  * \param[in] level The level of report detail desired
@@ -104,6 +104,9 @@ using std::endl;
 /** Deadband to use for the velocity comparison with zero. */
 #define XPS_VELOCITY_DEADBAND 0.0000001
 
+/** Seconds between two reads of the software limits of an axis. */
+#define XPS_LIMITS_SLOW_POLL_PERIOD 5.0
+
 static const char *driverName = "XPSAxis";
 
 typedef enum { none, positionMove, velocityMove, homeReverseMove, homeForwardsMove } moveType;
@@ -171,6 +174,15 @@ XPSAxis::XPSAxis(XPSController *pC, int axisNo, const char *positionerName, doub
   // Assume axis is not moving
   moving_ = false;
 
+  /* The controller finds the group of this axis at the next poll */
+  pollGroup_ = -1;
+  groupIndex_ = -1;
+  pollCached_ = false;
+  pC_->pollGroupsValid_ = false;
+
+  /* The software limits are read again in case they have been changed by a TCL script */
+  limitsSlowPoll_ = addSlowPoll(XPS_LIMITS_SLOW_POLL_PERIOD);
+
   index = (char *)strchr(positionerName, '.');
   if (index == NULL) {
     asynPrint(pasynUser_, ASYN_TRACE_ERROR,
@@ -558,15 +570,21 @@ asynStatus XPSAxis::poll(bool *moving)
   int status;
   char readResponse[25];
   char statusString[MAX_MESSAGE_LEN] = {0};
+  XPSPollGroup_t *pGroup = NULL;
   static const char *functionName = "poll";
 
-  status = GroupStatusGet(pollSocket_, 
-                          groupName_, 
-                          &axisStatus_);
+  /* With group polling, XPSController::poll() has read the group already */
+  if (pollCached_) {
+    pGroup = &pC_->pollGroups_[pollGroup_];
+    axisStatus_ = pGroup->status;
+    status = 0;
+  } else {
+    status = GroupStatusGet(pollSocket_, 
+                            groupName_, 
+                            &axisStatus_);
+  }
   if (!status) {
-    status = GroupStatusStringGet(pollSocket_,
-                                  axisStatus_,
-                                  statusString); 
+    status = pC_->groupStatusStringGet(axisStatus_, statusString);
   }
   if (status) {
     asynPrint(pasynUser_, ASYN_TRACE_ERROR, 
@@ -624,13 +642,6 @@ asynStatus XPSAxis::poll(bool *moving)
   if (deferredMove_) *moving = true;
   setIntegerParam(pC_->motorStatusDone_, *moving?0:1);
 
-  /*Read the controller software limits in case these have been changed by a TCL script.*/
-  status = PositionerUserTravelLimitsGet(pollSocket_, positionerName_, &lowLimit_, &highLimit_);
-  if (status == 0) {
-    setDoubleParam(pC_->motorHighLimit_, (highLimit_/stepSize_));
-    setDoubleParam(pC_->motorLowLimit_, (lowLimit_/stepSize_));
-  }
-
   /* Set the ATHM signal.*/
   if (axisStatus_ == 11) {
     if (referencingMode_ == 0) {
@@ -682,28 +693,45 @@ asynStatus XPSAxis::poll(bool *moving)
     setIntegerParam(pC_->motorStatusProblem_, 0);
   }
 
-  status = GroupPositionCurrentGet(pollSocket_,
-                                   positionerName_,
-                                   1,
-                                   &encoderPosition_);
-  if (status) {
-    asynPrint(pasynUser_, ASYN_TRACE_ERROR, 
-              "%s:%s: [%s,%d]: error calling GroupPositionCurrentGet status=%d\n",
-              driverName, functionName, pC_->portName, axisNo_, status);
-    goto done;
-  }
-  setDoubleParam(pC_->motorEncoderPosition_, (encoderPosition_/stepSize_));
+  if (pGroup) {
+    encoderPosition_  = pGroup->currentPosition[groupIndex_];
+    setpointPosition_ = pGroup->setpointPosition[groupIndex_];
+    currentVelocity_  = pGroup->currentVelocity[groupIndex_];
+  } else {
+    status = GroupPositionCurrentGet(pollSocket_,
+                                     positionerName_,
+                                     1,
+                                     &encoderPosition_);
+    if (status) {
+      asynPrint(pasynUser_, ASYN_TRACE_ERROR, 
+                "%s:%s: [%s,%d]: error calling GroupPositionCurrentGet status=%d\n",
+                driverName, functionName, pC_->portName, axisNo_, status);
+      goto done;
+    }
 
-  status = GroupPositionSetpointGet(pollSocket_,
-                                   positionerName_,
-                                   1,
-                                   &setpointPosition_);
-  if (status) {
-    asynPrint(pasynUser_, ASYN_TRACE_ERROR, 
-              "%s:%s: [%s,%d]: error calling GroupPositionSetpointGet status=%d\n",
-              driverName, functionName, pC_->portName, axisNo_, status);
-    goto done;
+    status = GroupPositionSetpointGet(pollSocket_,
+                                     positionerName_,
+                                     1,
+                                     &setpointPosition_);
+    if (status) {
+      asynPrint(pasynUser_, ASYN_TRACE_ERROR, 
+                "%s:%s: [%s,%d]: error calling GroupPositionSetpointGet status=%d\n",
+                driverName, functionName, pC_->portName, axisNo_, status);
+      goto done;
+    }
+
+    status = GroupVelocityCurrentGet(pollSocket_,
+                                     positionerName_,
+                                     1,
+                                     &currentVelocity_);
+    if (status) {
+      asynPrint(pasynUser_, ASYN_TRACE_ERROR, 
+                "%s:%s: [%s,%d]: error calling GroupPositionVelocityGet status=%d\n",
+                driverName, functionName, pC_->portName, axisNo_,  status);
+      goto done;
+    }
   }
+  setDoubleParam(pC_->motorEncoderPosition_, (encoderPosition_/stepSize_));
   setDoubleParam(pC_->motorPosition_, (setpointPosition_/stepSize_));
 
   status = PositionerErrorGet(pollSocket_,
@@ -727,26 +755,38 @@ asynStatus XPSAxis::poll(bool *moving)
     setIntegerParam(pC_->motorStatusLowLimit_, 0);
   }
 
-  /* Read the current velocity and use it set motor direction and moving flag. */
-  status = GroupVelocityCurrentGet(pollSocket_,
-                                   positionerName_,
-                                   1,
-                                   &currentVelocity_);
-  if (status) {
-    asynPrint(pasynUser_, ASYN_TRACE_ERROR, 
-              "%s:%s: [%s,%d]: error calling GroupPositionVelocityGet status=%d\n",
-              driverName, functionName, pC_->portName, axisNo_,  status);
-    goto done;
-  }
+  /* Use the current velocity to set motor direction and moving flag. */
   setIntegerParam(pC_->motorStatusDirection_, (currentVelocity_ > XPS_VELOCITY_DEADBAND));
   setIntegerParam(pC_->motorStatusMoving_,    (fabs(currentVelocity_) > XPS_VELOCITY_DEADBAND));
   
   done:
+  pollCached_ = false;
   setIntegerParam(pC_->motorStatusCommsError_, status ? 1 : 0);
   callParamCallbacks();
   return status ? asynError : asynSuccess;
 }
 
+/** Reads the controller software limits, which is a slow poll item,
+  * in case these have been changed by a TCL script.
+  * \param[in] item The slow poll item */
+asynStatus XPSAxis::slowPoll(int item)
+{
+  int status;
+  static const char *functionName = "slowPoll";
+
+  if (item != limitsSlowPoll_) return asynSuccess;
+  status = PositionerUserTravelLimitsGet(pollSocket_, positionerName_, &lowLimit_, &highLimit_);
+  if (status) {
+    asynPrint(pasynUser_, ASYN_TRACE_ERROR,
+              "%s:%s: [%s,%d]: error calling PositionerUserTravelLimitsGet status=%d\n",
+              driverName, functionName, pC_->portName, axisNo_, status);
+    return asynError;
+  }
+  setDoubleParam(pC_->motorHighLimit_, (highLimit_/stepSize_));
+  setDoubleParam(pC_->motorLowLimit_, (lowLimit_/stepSize_));
+  return asynSuccess;
+}
+
 asynStatus XPSAxis::setLowLimit(double value)
 {
   double deviceValue;
@@ -1556,14 +1596,11 @@ asynStatus XPSAxis::defineProfile(double *positions, size_t numPoints)
 
 
 /** Function to readback the actual motor positions from a coordinated move of multiple axes.
-  * This scales by the stepSize to get to steps, and then calls the base class method
-  * that converts to user units
-  * Caution: this function modifies the readbacks in place, so it must only be called
-  * once per readback operation.
- */
+  * Posts the readback and following error arrays of a profile move.
+  * The points are converted to user units when they are read from the gathering,
+  * see convertProfileReadbacks(), so that the arrays can be posted while they fill up. */
 asynStatus XPSAxis::readbackProfile()
 {
-  int i;
   int numReadbacks;
   int status=0;
   // static const char *functionName = "readbackProfile";
@@ -1571,14 +1608,34 @@ asynStatus XPSAxis::readbackProfile()
   status |= pC_->getIntegerParam(pC_->profileNumReadbacks_, &numReadbacks);
   if (status) return asynError;
 
-  // Convert to steps
-  for (i=0; i<numReadbacks; i++) {
-    profileReadbacks_[i]       /= stepSize_;
-    profileFollowingErrors_[i] /= stepSize_;
+  status  = pC_->doCallbacksFloat64Array(profileReadbacks_,       numReadbacks, pC_->profileReadbacks_, axisNo_);
+  status |= pC_->doCallbacksFloat64Array(profileFollowingErrors_, numReadbacks, pC_->profileFollowingErrors_, axisNo_);
+  return status ? asynError : asynSuccess;
+}
+
+/** Converts points of the readback and following error arrays of a profile move
+  * from controller units to user units.
+  * \param[in] firstPoint The first point to convert.
+  * \param[in] numPoints The number of points to convert. */
+void XPSAxis::convertProfileReadbacks(int firstPoint, int numPoints)
+{
+  int i;
+  double resolution;
+  double offset;
+  int direction;
+  int status=0;
+
+  status |= pC_->getDoubleParam(axisNo_, pC_->motorRecResolution_, &resolution);
+  status |= pC_->getDoubleParam(axisNo_, pC_->motorRecOffset_, &offset);
+  status |= pC_->getIntegerParam(axisNo_, pC_->motorRecDirection_, &direction);
+  if (status) return;
+
+  // Convert to steps, and then to user units
+  if (direction != 0) resolution = -resolution;
+  for (i=firstPoint; i<firstPoint+numPoints; i++) {
+    profileReadbacks_[i]       = profileReadbacks_[i] / stepSize_ * resolution + offset;
+    profileFollowingErrors_[i] = profileFollowingErrors_[i] / stepSize_ * resolution;
   }
-  // Call the base class method
-  asynAxisAxis::readbackProfile();
-  return asynSuccess;
 }
 
 
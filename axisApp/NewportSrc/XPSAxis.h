@@ -40,6 +40,7 @@ class epicsShareClass XPSAxis : public asynAxisAxis
   asynStatus home(double min_velocity, double max_velocity, double acceleration, int forwards);
   asynStatus stop(double acceleration);
   asynStatus poll(bool *moving);
+  asynStatus slowPoll(int item);
   asynStatus doMoveToHome();
   asynStatus setPosition(double position);
   asynStatus setLowLimit(double limit);
@@ -53,6 +54,7 @@ class epicsShareClass XPSAxis : public asynAxisAxis
 
   virtual asynStatus defineProfile(double *positions, size_t numPoints);
   virtual asynStatus readbackProfile();
+  void convertProfileReadbacks(int firstPoint, int numPoints);
   
   private:
   XPSController *pC_;
@@ -97,6 +99,10 @@ class epicsShareClass XPSAxis : public asynAxisAxis
   double deferredPosition_;
   bool deferredMove_;
   bool deferredRelative_;
+  int pollGroup_;      /**< Index into pC_->pollGroups_, -1 if the axis is polled on its own */
+  int groupIndex_;     /**< Index of the positioner in its group */
+  bool pollCached_;    /**< pC_->pollGroups_ has been read for this poll */
+  int limitsSlowPoll_; /**< Slow poll item which reads the software limits */
 
   friend class XPSController;
 };
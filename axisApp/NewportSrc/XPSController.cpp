@@ -80,10 +80,12 @@ Versions: Release 4-5 and higher.
 #include <string.h>
 #include <math.h>
 #include <errno.h>
+#include <stdarg.h>
 
 #include <epicsTime.h>
 #include <epicsThread.h>
 #include <epicsString.h>
+#include <epicsStdio.h>
 #include <iocsh.h>
 #include <asynDriver.h>
 
@@ -101,6 +103,13 @@ static const char *driverName = "XPSController";
 
 static void XPSProfileThreadC(void *pPvt);
 
+static const char *buildStageNames[XPS_NUM_BUILD_STAGES] = {
+  "parameters",
+  "file",
+  "upload",
+  "verify"
+};
+
 /** Struct for a list of strings describing the different corrector types possible on the XPS.*/
 typedef struct {
   char *PIPosition;
@@ -218,10 +227,33 @@ XPSController::XPSController(const char *portName, const char *IPAddress, int IP
   /* See function XPSController::enableMovingMode().*/
   enableMovingMode_ = false;
 
+  /* Flag to disable polling each group at once, see XPSController::enableGroupPolling().*/
+  enableGroupPolling_ = false;
+  pollGroupsValid_ = false;
+  pollGroups_ = (XPSPollGroup_t *)calloc(numAxes, sizeof(XPSPollGroup_t));
+  numPollGroups_ = 0;
+  memset(groupStatusStrings_, 0, sizeof(groupStatusStrings_));
+
+  /* The gathering of a profile move is read from the poller while the profile executes */
+  gatheringStreaming_ = false;
+  gatheringNumRead_ = 0;
+  gatheringLinesPerRead_ = 0;
+  gatheringBuffer_ = NULL;
+  epicsTimeGetCurrent(&gatheringPublishTime_);
+
+  /* The FTP session is opened by the first buildProfile() */
+  ftpConnected_ = false;
+  trajectoryBuffer_ = NULL;
+  trajectoryBufferSize_ = 0;
+  trajectoryLength_ = 0;
+  memset(buildStageTimes_, 0, sizeof(buildStageTimes_));
+
 }
 
 void XPSController::report(FILE *fp, int level)
 {
+  int i;
+
   fprintf(fp, "XPS motor driver: %s\n", this->portName);
   fprintf(fp, "                 numAxes: %d\n", numAxes_);
   fprintf(fp, "        firmware version: %s\n", firmwareVersion_);
@@ -238,6 +270,11 @@ void XPSController::report(FILE *fp, int level)
     fprintf(fp, "           movesDeferred: %d\n", movesDeferred_);
     fprintf(fp, "              autoEnable: %d\n", autoEnable_);
     fprintf(fp, "          noDisableError: %d\n", noDisableError_);
+    fprintf(fp, "            groupPolling: %d\n", enableGroupPolling_);
+    fprintf(fp, "           ftpConnected: %d\n", ftpConnected_);
+    for (i=0; i<XPS_NUM_BUILD_STAGES; i++) {
+      fprintf(fp, "  last build %10s: %f\n", buildStageNames[i], buildStageTimes_[i]);
+    }
   }
 
   // Call the base class method
@@ -521,16 +558,88 @@ asynStatus XPSController::initializeProfile(size_t maxPoints, const char* ftpUse
 {
   ftpUsername_ = epicsStrDup(ftpUsername);
   ftpPassword_ = epicsStrDup(ftpPassword);
+  /* Room for the acceleration elements too */
+  trajectoryBufferSize_ = (maxPoints+2) * (numAxes_*2 + 1) * TRAJECTORY_ELEMENT_LEN;
+  trajectoryBuffer_ = (char *)calloc(trajectoryBufferSize_, sizeof(char));
   asynAxisController::initializeProfile(maxPoints);
   return asynSuccess;
 }
 
+/** Appends to the trajectory which buildProfile() stores on the XPS.
+  * The buffer grows when the text does not fit.
+  * Returns 0, or -1 if the buffer cannot grow. */
+int XPSController::appendTrajectory(const char *format, ...)
+{
+  va_list args;
+  int len;
+  size_t size;
+  char *buffer;
+
+  while (1) {
+    va_start(args, format);
+    len = epicsVsnprintf(trajectoryBuffer_ + trajectoryLength_,
+                         trajectoryBufferSize_ - trajectoryLength_, format, args);
+    va_end(args);
+    if (len < 0) return -1;
+    if (trajectoryLength_ + len < trajectoryBufferSize_) break;
+    size = MAX(2*trajectoryBufferSize_, trajectoryLength_ + len + 1);
+    buffer = (char *)realloc(trajectoryBuffer_, size);
+    if (!buffer) return -1;
+    trajectoryBuffer_ = buffer;
+    trajectoryBufferSize_ = size;
+  }
+  trajectoryLength_ += len;
+  return 0;
+}
+
+/** Stores the trajectory on the XPS by FTP, straight from the buffer.
+  * The FTP session is kept open between builds, which saves connecting,
+  * logging in and changing the directory each time.  The XPS may have closed
+  * the session since the last build, so when storing in an old session fails
+  * it connects again and tries once more.
+  * \param[in] fileName The name of the trajectory file on the XPS.
+  * \param[out] message Error message, at least MAX_MESSAGE_LEN long. */
+int XPSController::uploadTrajectory(char *fileName, char *message)
+{
+  int status;
+  bool newSession = false;
+  static const char *functionName = "uploadTrajectory";
+
+  while (1) {
+    if (!ftpConnected_) {
+      status = ftpConnect(IPAddress_, ftpUsername_, ftpPassword_, &ftpSocket_);
+      if (status) {
+        sprintf(message, "Error calling ftpConnect, status=%d\n", status);
+        return status;
+      }
+      status = ftpChangeDir(ftpSocket_, TRAJECTORY_DIRECTORY);
+      if (status) {
+        ftpDisconnect(ftpSocket_);
+        sprintf(message, "Error calling  ftpChangeDir, status=%d\n", status);
+        return status;
+      }
+      ftpConnected_ = true;
+      newSession = true;
+    }
+    status = ftpStoreBuffer(ftpSocket_, fileName, trajectoryBuffer_, (int)trajectoryLength_);
+    if (status == 0) return 0;
+    ftpDisconnect(ftpSocket_);
+    ftpConnected_ = false;
+    if (newSession) {
+      sprintf(message, "Error calling  ftpStoreBuffer, status=%d\n", status);
+      return status;
+    }
+    asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+              "%s:%s: storing in the FTP session failed, connecting again\n",
+              driverName, functionName);
+  }
+}
+
 
 
 /* Function to build, install and verify trajectory */ 
 asynStatus XPSController::buildProfile()
 {
-  FILE *trajFile;
   int i, j; 
   int status;
   bool buildOK=true;
@@ -539,7 +648,6 @@ asynStatus XPSController::buildProfile()
   int numElements;
   double trajVel;
   double D0, D1, T0, T1;
-  SOCKET ftpSocket;
   char fileName[MAX_FILENAME_LEN];
   char groupName[MAX_GROUPNAME_LEN];
   char message[MAX_MESSAGE_LEN];
@@ -558,6 +666,8 @@ asynStatus XPSController::buildProfile()
   bool inGroup[XPS_MAX_AXES];
   double time;
   int useAxis[XPS_MAX_AXES];
+  int stage;
+  epicsTimeStamp stageStart, stageEnd;
   static const char *functionName = "buildProfile";
   
   asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
@@ -573,6 +683,10 @@ asynStatus XPSController::buildProfile()
   setIntegerParam(profileBuildStatus_, PROFILE_STATUS_UNDEFINED);
   callParamCallbacks();
 
+  memset(buildStageTimes_, 0, sizeof(buildStageTimes_));
+  stage = XPSBuildStageParameters;
+  epicsTimeGetCurrent(&stageStart);
+
   /* We create trajectories with an extra element at the beginning and at the end.
    * The distance and time of the first element is defined so that the motors will
    * accelerate from 0 to the velocity of the first "real" element at their 
@@ -636,22 +750,22 @@ asynStatus XPSController::buildProfile()
     pAxes_[j]->profilePostDistance_ =  0.5 * postVelocity[j] * postTimeMax; 
   }
 
-  /* Create the profile file */
-  trajFile =  fopen(fileName, "wb");
-  if (trajFile == 0) {
-    buildOK = false;
-    status = -1;
-    sprintf(message, "Error creating trajectory file %s, error=%s\n", fileName, strerror(errno));
-    goto done;
-  }
+  epicsTimeGetCurrent(&stageEnd);
+  buildStageTimes_[stage] = epicsTimeDiffInSeconds(&stageEnd, &stageStart);
+  stage = XPSBuildStageFile;
+  stageStart = stageEnd;
+
+  /* Create the profile in memory, it is stored on the XPS without a local file */
+  trajectoryLength_ = 0;
+  status = 0;
 
   /* Create the initial acceleration element */
-  fprintf(trajFile,"%f", preTimeMax);
+  status |= appendTrajectory("%f", preTimeMax);
   for (j=0; j<numAxes_; j++) {
     if (!inGroup[j]) continue;
-    fprintf(trajFile,", %f, %f", pAxes_[j]->profilePreDistance_, preVelocity[j]);
+    status |= appendTrajectory(", %f, %f", pAxes_[j]->profilePreDistance_, preVelocity[j]);
   }
-  fprintf(trajFile,"\n");
+  status |= appendTrajectory("\n");
  
   /* The number of profile elements in the file is numPoints-1 */
   numElements = numPoints - 1;
@@ -661,7 +775,7 @@ asynStatus XPSController::buildProfile()
       T1 = profileTimes_[i+1];
     else
       T1 = T0;
-    fprintf(trajFile,"%f", profileTimes_[i]);
+    status |= appendTrajectory("%f", profileTimes_[i]);
     for (j=0; j<numAxes_; j++) {
       if (!inGroup[j]) continue;
       D0 = pAxes_[j]->profilePositions_[i+1] - 
@@ -677,45 +791,40 @@ asynStatus XPSController::buildProfile()
         D0 = 0.0;  /* Axis turned off*/
         trajVel = 0.0;
       }
-      fprintf(trajFile,", %f, %f",D0,trajVel);
+      status |= appendTrajectory(", %f, %f",D0,trajVel);
     }  
-    fprintf(trajFile,"\n");
+    status |= appendTrajectory("\n");
   }
 
   /* Create the final acceleration element. Final velocity must be 0. */
-  fprintf(trajFile,"%f", postTimeMax);
+  status |= appendTrajectory("%f", postTimeMax);
   for (j=0; j<numAxes_; j++) {
     if (!inGroup[j]) continue;
-    fprintf(trajFile,", %f, %f", pAxes_[j]->profilePostDistance_, 0.);
-  }
-  fclose (trajFile);
-  
-  /* FTP the trajectory file from the local directory to the XPS */
-  status = ftpConnect(IPAddress_, ftpUsername_, ftpPassword_, &ftpSocket);
-  if (status) {
-    buildOK = false;
-    sprintf(message, "Error calling ftpConnect, status=%d\n", status);
-    goto done;
-  }
-  status = ftpChangeDir(ftpSocket, TRAJECTORY_DIRECTORY);
-  if (status) {
-    buildOK = false;
-    sprintf(message, "Error calling  ftpChangeDir, status=%d\n", status);
-    goto done;
+    status |= appendTrajectory(", %f, %f", pAxes_[j]->profilePostDistance_, 0.);
   }
-  status = ftpStoreFile(ftpSocket, fileName);
   if (status) {
     buildOK = false;
-    sprintf(message, "Error calling  ftpStoreFile, status=%d\n", status);
+    sprintf(message, "Error creating trajectory %s, out of memory\n", fileName);
     goto done;
   }
-  status = ftpDisconnect(ftpSocket);
+
+  epicsTimeGetCurrent(&stageEnd);
+  buildStageTimes_[stage] = epicsTimeDiffInSeconds(&stageEnd, &stageStart);
+  stage = XPSBuildStageUpload;
+  stageStart = stageEnd;
+
+  /* FTP the trajectory from memory to the XPS */
+  status = uploadTrajectory(fileName, message);
   if (status) {
     buildOK = false;
-    sprintf(message, "Error calling  ftpDisconnect, status=%d\n", status);
     goto done;
   }
 
+  epicsTimeGetCurrent(&stageEnd);
+  buildStageTimes_[stage] = epicsTimeDiffInSeconds(&stageEnd, &stageStart);
+  stage = XPSBuildStageVerify;
+  stageStart = stageEnd;
+
   /* Verify trajectory */
   asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
             "%s:%s: calling MultipleAxesPVTVerification(%d, %s, %s)\n",
@@ -788,6 +897,16 @@ asynStatus XPSController::buildProfile()
     }
   }
   done:
+  /* The time of the stage which finished, or failed */
+  epicsTimeGetCurrent(&stageEnd);
+  buildStageTimes_[stage] = epicsTimeDiffInSeconds(&stageEnd, &stageStart);
+  asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+            "%s:%s: %s %f s, %s %f s, %s %f s, %s %f s\n",
+            driverName, functionName,
+            buildStageNames[XPSBuildStageParameters], buildStageTimes_[XPSBuildStageParameters],
+            buildStageNames[XPSBuildStageFile],       buildStageTimes_[XPSBuildStageFile],
+            buildStageNames[XPSBuildStageUpload],     buildStageTimes_[XPSBuildStageUpload],
+            buildStageNames[XPSBuildStageVerify],     buildStageTimes_[XPSBuildStageVerify]);
   buildStatus = (buildOK && verifyOK) ?  PROFILE_STATUS_SUCCESS : PROFILE_STATUS_FAILURE;
   setIntegerParam(profileBuildStatus_, buildStatus);
   setStringParam(profileBuildMessage_, message);
@@ -898,6 +1017,7 @@ asynStatus XPSController::runProfile()
   waitMotors();
 
   lock();
+  gatheringStreaming_ = false;
   setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_EXECUTING);
   callParamCallbacks();
   unlock();
@@ -915,6 +1035,19 @@ asynStatus XPSController::runProfile()
     goto done;
   }
 
+  /* Erase the readback and error arrays, the poller fills them from the new gathering */
+  lock();
+  profileReadbackGeneration_++;
+  for (j=0; j<numAxes_; j++) {
+    memset(pAxes_[j]->profileReadbacks_,       0, maxProfilePoints_*sizeof(double));
+    memset(pAxes_[j]->profileFollowingErrors_, 0, maxProfilePoints_*sizeof(double));
+  }
+  gatheringNumRead_ = 0;
+  gatheringLinesPerRead_ = (int)maxProfilePoints_;
+  setIntegerParam(profileNumReadbacks_, 0);
+  gatheringStreaming_ = true;
+  unlock();
+
   /* Write list of gathering parameters.
    * Note that there must be NUM_GATHERING_ITEMS per axis in this list. */
   strcpy(buffer, "");
@@ -1119,15 +1252,24 @@ asynStatus XPSController::runProfile()
 }
 
 /** Polls the controller, rather than individual axis
-  * Used during profile moves */
+  * Used during profile moves, and to read the groups when group polling is enabled.
+  * During profile moves the gathering is read as it fills up, and the partial
+  * readback arrays are posted every XPS_GATHERING_PUBLISH_PERIOD */
 asynStatus XPSController::poll()
 {
   int executeState;
   int status;
   int number;
+  int numRead;
+  int j;
   char fileName[MAX_FILENAME_LEN];
   char groupName[MAX_GROUPNAME_LEN];
+  char message[MAX_MESSAGE_LEN];
+  epicsTimeStamp nowTime;
+  static const char *functionName = "poll";
   
+  if (enableGroupPolling_) pollGroups();
+
   getIntegerParam(profileExecuteState_, &executeState);
   if (executeState != PROFILE_EXECUTE_EXECUTING) return asynSuccess;
 
@@ -1136,12 +1278,317 @@ asynStatus XPSController::poll()
   status = MultipleAxesPVTParametersGet(pollSocket_, groupName, fileName, &number);
   if (status) return asynError;
   setIntegerParam(profileCurrentPoint_, number);
+
+  if (gatheringStreaming_) {
+    numRead = gatheringNumRead_;
+    status = readGathering(false, message);
+    if (status) {
+      /* readbackProfile() tries again and reports the error */
+      asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+                "%s:%s: %s\n",
+                driverName, functionName, message);
+    }
+    if (gatheringNumRead_ > numRead) {
+      setIntegerParam(profileNumReadbacks_, gatheringNumRead_);
+      epicsTimeGetCurrent(&nowTime);
+      if (epicsTimeDiffInSeconds(&nowTime, &gatheringPublishTime_) >= XPS_GATHERING_PUBLISH_PERIOD) {
+        gatheringPublishTime_ = nowTime;
+        for (j=0; j<numAxes_; j++) {
+          pAxes_[j]->readbackProfile();
+        }
+        postProfileReadbackBlock();
+      }
+    }
+  }
   callParamCallbacks();
   return asynSuccess;
 }
 
+/** Reads the lines of the gathering which have not been read yet into the profile
+  * readback and following error arrays, in user units.
+  * \param[in] readAll Read until all lines are read; otherwise do a single
+  *            GatheringDataMultipleLinesGet(), so that a poll does not take long.
+  * \param[out] message Error message, at least MAX_MESSAGE_LEN long.
+  * Returns 0, or the error of the XPS, or -1 if the gathering could not be parsed. */
+int XPSController::readGathering(bool readAll, char *message)
+{
+  int currentSamples, maxSamples;
+  int firstLine;
+  int numLines;
+  int numParsed;
+  int status;
+  int j;
+  static const char *functionName = "readGathering";
+
+  status = GatheringCurrentNumberGet(pollSocket_, &currentSamples, &maxSamples);
+  asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW, 
+            "%s:%s: GatheringCurrentNumberGet, status=%d, currentSamples=%d, maxSamples=%d\n", 
+            driverName, functionName, status, currentSamples, maxSamples);
+  if (status != 0) {
+    sprintf(message, "Error calling GatherCurrentNumberGet, status=%d", status);
+    return status;
+  }
+  if (currentSamples > (int) maxProfilePoints_) {
+    currentSamples = maxProfilePoints_;
+  }
+  if (currentSamples < gatheringNumRead_) {
+    /* The gathering has been reset since it was read */
+    gatheringNumRead_ = 0;
+  }
+  if (gatheringLinesPerRead_ <= 0) gatheringLinesPerRead_ = (int)maxProfilePoints_;
+  if (!gatheringBuffer_) gatheringBuffer_ = (char *)calloc(GATHERING_MAX_READ_LEN, sizeof(char));
+
+  firstLine = gatheringNumRead_;
+  while (gatheringNumRead_ < currentSamples) {
+    /* Try to read all the remaining lines. When they do not fit into the reply,
+     * try half as many, and remember that for the next reads */
+    status = -1;
+    numLines = MIN(currentSamples - gatheringNumRead_, gatheringLinesPerRead_);
+    while (status && (numLines > 0)) {
+      status = GatheringDataMultipleLinesGet(pollSocket_, gatheringNumRead_, numLines, gatheringBuffer_);
+      asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW, 
+                "%s:%s: GatheringDataMultipleLinesGet, status=%d, numLines=%d\n", 
+                driverName, functionName, status, numLines);
+      if (status) {
+        numLines /= 2;
+        gatheringLinesPerRead_ = numLines;
+      }
+    }
+    if (numLines == 0) {
+      sprintf(message, "Error reading gathering data, numInBuffer = 0");
+      status = -1;
+      break;
+    }
+    numParsed = parseGathering(gatheringBuffer_, gatheringNumRead_, numLines);
+    gatheringNumRead_ += numParsed;
+    if (numParsed != numLines) {
+      sprintf(message, "Error reading Gathering.dat file, line %d should have %d items",
+              gatheringNumRead_, numAxes_*NUM_GATHERING_ITEMS);
+      status = -1;
+      break;
+    }
+    if (!readAll) break;
+  }
+
+  for (j=0; j<numAxes_; j++) {
+    pAxes_[j]->convertProfileReadbacks(firstLine, gatheringNumRead_ - firstLine);
+  }
+  return status;
+}
+
+/** Parses lines of the gathering, with NUM_GATHERING_ITEMS values per axis:
+  * "setpoint;actual;setpoint;actual;...\n".
+  * The values are stored in the profile readback and following error arrays,
+  * in controller units.  Scanning with strtod() rather than sscanf() spares
+  * interpreting the format for each value.
+  * \param[in] buffer The lines from GatheringDataMultipleLinesGet().
+  * \param[in] firstLine The index of the first line in the gathering.
+  * \param[in] numLines The number of lines in buffer.
+  * Returns the number of complete lines. */
+int XPSController::parseGathering(const char *buffer, int firstLine, int numLines)
+{
+  const char *bptr = buffer;
+  char *tptr;
+  double setpointPosition, actualPosition;
+  int i, j;
+
+  for (i=0; i<numLines; i++) {
+    for (j=0; j<numAxes_; j++) {
+      setpointPosition = strtod(bptr, &tptr);
+      if ((tptr == bptr) || (*tptr != ';')) return i;
+      bptr = tptr + 1;
+      actualPosition = strtod(bptr, &tptr);
+      if (tptr == bptr) return i;
+      bptr = tptr;
+      if (*bptr == ';') bptr++;
+      // Note, these positions are in controller units, need to be converted to user units
+      pAxes_[j]->profileFollowingErrors_[firstLine+i] = actualPosition - setpointPosition;
+      pAxes_[j]->profileReadbacks_[firstLine+i] = actualPosition;
+    }
+    /* Skip to the next line */
+    bptr = strchr(bptr, '\n');
+    if (!bptr) return (i == numLines-1) ? numLines : i+1;
+    bptr++;
+  }
+  return numLines;
+}
 
 
+
+/** Finds a positioner in the list returned by ObjectsListGet(),
+  * e.g. "GROUP1;GROUP1.POSITIONER;GROUP2;GROUP2.X;GROUP2.Y".
+  * The positioners of a group are listed in the order of the values of GroupPositionCurrentGet().
+  * \param[in] objectsList The list of groups and positioners.
+  * \param[in] positionerName The name of the positioner, e.g. "GROUP2.Y".
+  * \param[out] numPositioners The number of positioners in the group of the positioner.
+  * Returns the index of the positioner in its group, -1 if it is not in the list. */
+static int findPositionerInGroup(const char *objectsList, const char *positionerName, int *numPositioners)
+{
+  const char *pObject = objectsList;
+  const char *pEnd;
+  const char *pDot;
+  size_t groupNameLen;
+  size_t len;
+  int index = -1;
+
+  *numPositioners = 0;
+  pDot = strchr(positionerName, '.');
+  if (!pDot) return -1;
+  groupNameLen = pDot - positionerName;
+  while (*pObject) {
+    while (*pObject == ';' || *pObject == ' ') pObject++;
+    pEnd = strchr(pObject, ';');
+    if (!pEnd) pEnd = pObject + strlen(pObject);
+    len = pEnd - pObject;
+    while (len > 0 && pObject[len-1] == ' ') len--;
+    if ((len > groupNameLen) && (pObject[groupNameLen] == '.') &&
+        (strncmp(pObject, positionerName, groupNameLen) == 0)) {
+      if ((len == strlen(positionerName)) && (strncmp(pObject, positionerName, len) == 0)) {
+        index = *numPositioners;
+      }
+      (*numPositioners)++;
+    }
+    pObject = pEnd;
+  }
+  return index;
+}
+
+/** Assigns the axes to groups for group polling.
+  * Axes which are not found in the list of objects of the XPS are polled on their own. */
+void XPSController::buildPollGroups()
+{
+  XPSAxis *pAxis;
+  XPSPollGroup_t *pGroup;
+  char *objectsList;
+  int numPositioners;
+  int status;
+  int i, j;
+  static const char *functionName = "buildPollGroups";
+
+  numPollGroups_ = 0;
+  pollGroupsValid_ = true;
+  for (i=0; i<numAxes_; i++) {
+    pAxis = getAxis(i);
+    if (!pAxis) continue;
+    pAxis->pollGroup_ = -1;
+    pAxis->groupIndex_ = -1;
+  }
+  /* ObjectsListGet() copies up to 64 kB */
+  objectsList = (char *)calloc(GATHERING_MAX_READ_LEN, 1);
+  status = ObjectsListGet(pollSocket_, objectsList);
+  if (status) {
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+              "%s:%s: [%s]: error calling ObjectsListGet status=%d, axes are polled one by one\n",
+              driverName, functionName, portName, status);
+    free(objectsList);
+    return;
+  }
+  for (i=0; i<numAxes_; i++) {
+    pAxis = getAxis(i);
+    if (!pAxis) continue;
+    pAxis->groupIndex_ = findPositionerInGroup(objectsList, pAxis->positionerName_, &numPositioners);
+    if ((pAxis->groupIndex_ < 0) || (numPositioners > XPS_MAX_AXES)) {
+      asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: [%s,%d]: positioner %s not found, the axis is polled on its own\n",
+                driverName, functionName, portName, i, pAxis->positionerName_);
+      continue;
+    }
+    for (j=0; j<numPollGroups_; j++) {
+      if (strcmp(pollGroups_[j].groupName, pAxis->groupName_) == 0) break;
+    }
+    pGroup = &pollGroups_[j];
+    if (j == numPollGroups_) {
+      pGroup->groupName = pAxis->groupName_;
+      pGroup->numPositioners = numPositioners;
+      numPollGroups_++;
+    }
+    pAxis->pollGroup_ = j;
+    asynPrint(pasynUserSelf, ASYN_TRACE_FLOW,
+              "%s:%s: [%s,%d]: positioner %s is %d of %d in group %s\n",
+              driverName, functionName, portName, i, pAxis->positionerName_,
+              pAxis->groupIndex_, numPositioners, pGroup->groupName);
+  }
+  free(objectsList);
+}
+
+/** Reads the status, the positions and the velocities of the groups
+  * which have an axis that is polled in this cycle.
+  * Each request returns the values of all positioners in the group,
+  * XPSAxis::poll() takes them from pollGroups_. */
+void XPSController::pollGroups()
+{
+  XPSPollGroup_t *pGroup;
+  XPSAxis *pAxis;
+  int status;
+  int i;
+  static const char *functionName = "pollGroups";
+
+  if (!pollGroupsValid_) buildPollGroups();
+
+  for (i=0; i<numPollGroups_; i++) pollGroups_[i].due = false;
+  for (i=0; i<numAxes_; i++) {
+    pAxis = getAxis(i);
+    if (pAxis) pAxis->pollCached_ = false;
+  }
+  /* pollCycle() polls the axes in pollDueAxes_ in this cycle */
+  for (i=0; i<numPollDueAxes_; i++) {
+    pAxis = getAxis(pollDueAxes_[i]);
+    if (!pAxis || (pAxis->pollGroup_ < 0)) continue;
+    pollGroups_[pAxis->pollGroup_].due = true;
+  }
+
+  for (i=0; i<numPollGroups_; i++) {
+    pGroup = &pollGroups_[i];
+    if (!pGroup->due) continue;
+    status = GroupStatusGet(pollSocket_, pGroup->groupName, &pGroup->status);
+    if (!status) {
+      status = GroupPositionCurrentGet(pollSocket_, pGroup->groupName,
+                                       pGroup->numPositioners, pGroup->currentPosition);
+    }
+    if (!status) {
+      status = GroupPositionSetpointGet(pollSocket_, pGroup->groupName,
+                                        pGroup->numPositioners, pGroup->setpointPosition);
+    }
+    if (!status) {
+      status = GroupVelocityCurrentGet(pollSocket_, pGroup->groupName,
+                                       pGroup->numPositioners, pGroup->currentVelocity);
+    }
+    if (status) {
+      /* The axes of the group read their values on their own, and report the error */
+      asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: [%s]: error reading group %s status=%d\n",
+                driverName, functionName, portName, pGroup->groupName, status);
+      pGroup->due = false;
+    }
+  }
+
+  for (i=0; i<numAxes_; i++) {
+    pAxis = getAxis(i);
+    if (!pAxis || (pAxis->pollGroup_ < 0)) continue;
+    pAxis->pollCached_ = pollGroups_[pAxis->pollGroup_].due;
+  }
+}
+
+/** Returns the string of a group status code, like GroupStatusStringGet().
+  * The strings do not change, each one is read only once from the XPS.
+  * \param[in] groupStatus The group status code.
+  * \param[out] statusString The string, at least MAX_MESSAGE_LEN long. */
+int XPSController::groupStatusStringGet(int groupStatus, char *statusString)
+{
+  int status;
+  bool cacheable = (groupStatus >= 0) && (groupStatus < XPS_MAX_GROUP_STATUS);
+
+  if (cacheable && groupStatusStrings_[groupStatus][0]) {
+    strcpy(statusString, groupStatusStrings_[groupStatus]);
+    return 0;
+  }
+  status = GroupStatusStringGet(pollSocket_, groupStatus, statusString);
+  if (!status && cacheable) {
+    strncpy(groupStatusStrings_[groupStatus], statusString, MAX_MESSAGE_LEN-1);
+  }
+  return status;
+}
+
 asynStatus XPSController::abortProfile()
 {
   int status;
@@ -1167,15 +1614,10 @@ asynStatus XPSController::readbackProfile()
   char message[MAX_MESSAGE_LEN];
   bool readbackOK=true;
   int numPulses;
-  char* buffer=NULL;
-  char* bptr, *tptr;
-  int currentSamples, maxSamples;
-  double setpointPosition, actualPosition;
   int readbackStatus;
   int status;
-  int i, j;
-  int nitems;
-  int numRead=0, numInBuffer, numChars;
+  int j;
+  int numRead;
   static const char *functionName = "readbackProfile";
     
   asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
@@ -1190,80 +1632,24 @@ asynStatus XPSController::readbackProfile()
   
   status = getIntegerParam(profileNumPulses_, &numPulses);
 
-  /* Erase the readback and error arrays */
-  for (j=0; j<numAxes_; j++) {
-    memset(pAxes_[j]->profileReadbacks_,       0, maxProfilePoints_*sizeof(double));
-    memset(pAxes_[j]->profileFollowingErrors_, 0, maxProfilePoints_*sizeof(double));
-  }
-  /* Read the number of lines of gathering */
-  status = GatheringCurrentNumberGet(pollSocket_, &currentSamples, &maxSamples);
-  asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW, 
-            "%s:%s: GatheringCurrentNumberGet, status=%d, currentSamples=%d, maxSamples=%d\n", 
-            driverName, functionName, status, currentSamples, maxSamples);
-  if (status != 0) {
+  /* Read the lines of the gathering which the poller has not read
+   * while the profile was executing */
+  status = readGathering(true, message);
+  numRead = gatheringNumRead_;
+  if (status) {
     readbackOK = false;
-    sprintf(message, "Error calling GatherCurrentNumberGet, status=%d", status);
-    goto done;
-  }
-  if (currentSamples < numPulses) {
+  } else if (numRead < numPulses) {
     readbackOK = false;
-    sprintf(message, "Error, numPulses=%d, currentSamples=%d", numPulses, currentSamples);
-    //goto done;
-  } 
-  if (currentSamples > (int) maxProfilePoints_) {
-      currentSamples = maxProfilePoints_;
-  }
-  buffer = (char *)calloc(GATHERING_MAX_READ_LEN, sizeof(char));
-  numInBuffer = 0;
-  for (numRead=0; numRead<currentSamples;) {
-    /* Read the next buffer */
-    /* Try to read all the remaining points */
-    status = -1;
-    numInBuffer = currentSamples - numRead;
-    while (status && (numInBuffer > 0)) {
-      status = GatheringDataMultipleLinesGet(pollSocket_, numRead, numInBuffer, buffer);
-      asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW, 
-                "%s:%s: GatheringDataMultipleLinesGet, status=%d, numInBuffer=%d\n", 
-                driverName, functionName, status, numInBuffer);
-      if (status) numInBuffer /= 2;
-    }
-    if (numInBuffer == 0) {
-      readbackOK = false;
-      sprintf(message, "Error reading gathering data, numInBuffer = 0");
-      goto done;
-    }
-    bptr = buffer;
-    for (i=0; i<numInBuffer; i++) {
-      /* Find the next \n and replace with null */
-      tptr = strstr(bptr, "\n");
-      if (tptr) *tptr = 0;
-      for (j=0; j<numAxes_; j++) {
-        nitems = sscanf(bptr, "%lf;%lf%n", 
-                        &setpointPosition, &actualPosition, &numChars);
-        bptr += numChars+1;
-        if (nitems != NUM_GATHERING_ITEMS) {
-          readbackOK = false;
-          sprintf(message, "Error reading Gathering.dat file, nitems=%d, should be %d",
-                  nitems, NUM_GATHERING_ITEMS);
-          goto done;
-        }
-        // Note, these positions are in controller units, need to be converted to user units
-        pAxes_[j]->profileFollowingErrors_[numRead] = actualPosition - setpointPosition;
-        pAxes_[j]->profileReadbacks_[numRead] = actualPosition;
-      }
-      numRead++;
-      bptr = tptr + 1;
-    }
+    sprintf(message, "Error, numPulses=%d, currentSamples=%d", numPulses, numRead);
   }
   
-  done:
-  if (buffer) free(buffer);
   setIntegerParam(profileActualPulses_, numRead);
   setIntegerParam(profileNumReadbacks_, numRead);
-  /* Convert from controller to user units and post the arrays */
+  /* Post the arrays */
   for (j=0; j<numAxes_; j++) {
     pAxes_[j]->readbackProfile();
   }
+  postProfileReadbackBlock();
   readbackStatus = readbackOK ?  PROFILE_STATUS_SUCCESS : PROFILE_STATUS_FAILURE;
   setIntegerParam(profileReadbackStatus_, readbackStatus);
   setStringParam(profileReadbackMessage_, message);
@@ -1306,6 +1692,18 @@ asynStatus XPSController::enableMovingMode()
   return asynSuccess; 
 }
 
+/* Function to enable a mode where XPSController::poll() reads the status, the positions and
+   the velocities of each group with one request for all positioners in the group, and the axes
+   take them from there. This saves most of the requests of groups with more than one positioner.
+   The travel limits are not part of the group request, each axis reads them as a slow
+   poll item every 5 seconds, see XPSAxis::slowPoll(). */ 
+asynStatus XPSController::enableGroupPolling()
+{
+  enableGroupPolling_ = true;
+  pollGroupsValid_ = false;
+  return asynSuccess; 
+}
+
 
 
 /** The following functions have C linkage, and can be called directly or from iocsh */
@@ -1418,6 +1816,23 @@ asynStatus XPSEnableMovingMode(const char *XPSName)
   return pC->enableMovingMode();
 }
 
+asynStatus XPSEnableGroupPolling(const char *XPSName)
+{
+  XPSController *pC;
+  static const char *functionName = "XPSEnableGroupPolling";
+
+  pC = (XPSController*) findAsynPortDriver(XPSName);
+  if (!pC) {
+    printf("%s:%s: Error port %s not found\n", driverName, functionName, XPSName);
+    return asynError;
+  }
+
+  pC->lock();
+  pC->enableGroupPolling();
+  pC->unlock();
+  return asynSuccess;
+}
+
 
 
 
@@ -1515,6 +1930,16 @@ static void enableMovingModeCallFunc(const iocshArgBuf *args)
   XPSEnableMovingMode(args[0].sval);
 }
 
+/* XPSEnableGroupPolling */
+static const iocshArg XPSEnableGroupPollingArg0 = {"Controller port name", iocshArgString};
+static const iocshArg * const XPSEnableGroupPollingArgs[] = {&XPSEnableGroupPollingArg0};
+static const iocshFuncDef enableGroupPolling = {"XPSEnableGroupPolling", 1, XPSEnableGroupPollingArgs};
+
+static void enableGroupPollingCallFunc(const iocshArgBuf *args)
+{
+  XPSEnableGroupPolling(args[0].sval);
+}
+
 
 static void XPSRegister3(void)
 {
@@ -1524,6 +1949,7 @@ static void XPSRegister3(void)
   iocshRegister(&disableAutoEnable,    disableAutoEnableCallFunc);
   iocshRegister(&noDisableError,       noDisableErrorCallFunc);
   iocshRegister(&enableMovingMode,     enableMovingModeCallFunc);
+  iocshRegister(&enableGroupPolling,   enableGroupPollingCallFunc);
 }
 epicsExportRegistrar(XPSRegister3);
 
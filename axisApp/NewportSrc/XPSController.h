@@ -6,6 +6,8 @@ USAGE...        Newport XPS EPICS asyn motor device driver
 #ifndef XPSController_H
 #define XPSController_H
 
+#include <osiSock.h>
+
 #include "asynAxisController.h"
 #include "asynAxisAxis.h"
 #include "XPSAxis.h"
@@ -14,12 +16,28 @@ USAGE...        Newport XPS EPICS asyn motor device driver
 #define XPS_POLL_TIMEOUT 2.0
 #define XPS_MOVE_TIMEOUT 100000.0 // "Forever"
 #define XPS_MIN_PROFILE_ACCEL_TIME 0.25
+/* Minimum time between posting the partial readback arrays while a profile executes */
+#define XPS_GATHERING_PUBLISH_PERIOD 1.0
 
 /* Constants used for FTP to the XPS */
 #define TRAJECTORY_DIRECTORY "/Admin/Public/Trajectories"
 #define MAX_FILENAME_LEN  256
 #define MAX_MESSAGE_LEN   256
 #define MAX_GROUPNAME_LEN  64
+/* Initial size of the trajectory per element and axis, the buffer grows as needed */
+#define TRAJECTORY_ELEMENT_LEN 32
+
+/* Stages of buildProfile() which are timed */
+typedef enum {
+  XPSBuildStageParameters,   /* Read the SGamma parameters, compute the acceleration elements */
+  XPSBuildStageFile,         /* Format the trajectory */
+  XPSBuildStageUpload,       /* FTP the trajectory to the XPS */
+  XPSBuildStageVerify,       /* MultipleAxesPVTVerification and the checks of the results */
+  XPS_NUM_BUILD_STAGES
+} XPSBuildStage_t;
+
+/* Group status codes whose strings are cached, the XPS uses codes up to 83 */
+#define XPS_MAX_GROUP_STATUS 128
 
 #define MAX_PULSE_WIDTHS 4
 #define MAX_SETTLING_TIMES 4
@@ -31,7 +49,19 @@ typedef enum {
   XPSPositionCompareModeAquadBWindowed,
   XPSPositionCompareModeAquadBAlways
 } XPSPositionCompareMode_t;
-  
+
+/** Values of one group, which XPSController::poll() reads for all its positioners
+  * with one request each, when group polling is enabled. */
+typedef struct {
+  char *groupName;
+  int numPositioners;                    /**< Number of positioners in the group, from ObjectsListGet */
+  bool due;                              /**< An axis in the group is polled in this cycle */
+  int status;                            /**< GroupStatusGet */
+  double currentPosition[XPS_MAX_AXES];  /**< GroupPositionCurrentGet */
+  double setpointPosition[XPS_MAX_AXES]; /**< GroupPositionSetpointGet */
+  double currentVelocity[XPS_MAX_AXES];  /**< GroupVelocityCurrentGet */
+} XPSPollGroup_t;
+
 // drvInfo strings for extra parameters that the XPS controller supports
 #define XPSMinJerkString                      "XPS_MIN_JERK"
 #define XPSMaxJerkString                      "XPS_MAX_JERK"
@@ -92,6 +122,10 @@ class epicsShareClass XPSController : public asynAxisController {
    to determine motion done. */ 
   asynStatus enableMovingMode();
 
+  /* Function to enable a mode where XPSController::poll() reads the status, positions
+   and velocities of each group at once, rather than each axis separately. */
+  asynStatus enableGroupPolling();
+
 
   protected:
   XPSAxis **pAxes_;       /**< Array of pointers to axis objects */
@@ -118,6 +152,14 @@ class epicsShareClass XPSController : public asynAxisController {
   #define LAST_XPS_PARAM XPSTclScriptExecute_
 
   private:
+  void buildPollGroups();
+  void pollGroups();
+  int readGathering(bool readAll, char *message);
+  int parseGathering(const char *buffer, int firstLine, int numLines);
+  int groupStatusStringGet(int groupStatus, char *statusString);
+  int appendTrajectory(const char *format, ...);
+  int uploadTrajectory(char *fileName, char *message);
+
   bool enableSetPosition_;          /**< Enable/disable setting the position from EPICS */ 
   double setPositionSettlingTime_;  /**< The settling (sleep) time used when setting position. */
   char *IPAddress_;
@@ -132,6 +174,22 @@ class epicsShareClass XPSController : public asynAxisController {
   int autoEnable_;
   int noDisableError_;
   bool enableMovingMode_;
+  bool enableGroupPolling_;
+  bool pollGroupsValid_;            /**< pollGroups_ matches the axes, cleared when an axis is created */
+  XPSPollGroup_t *pollGroups_;      /**< One entry per group which has an axis */
+  int numPollGroups_;
+  char groupStatusStrings_[XPS_MAX_GROUP_STATUS][MAX_MESSAGE_LEN]; /**< GroupStatusStringGet, read once per code, "" if not read yet */
+  bool gatheringStreaming_;         /**< The gathering of the executing profile can be read */
+  int gatheringNumRead_;            /**< Lines of the gathering in the profile readback arrays */
+  int gatheringLinesPerRead_;       /**< Lines which fit into one GatheringDataMultipleLinesGet */
+  char *gatheringBuffer_;
+  epicsTimeStamp gatheringPublishTime_;
+  SOCKET ftpSocket_;                /**< FTP session which is kept open between profile builds */
+  bool ftpConnected_;
+  char *trajectoryBuffer_;          /**< The trajectory, stored on the XPS without a local file */
+  size_t trajectoryBufferSize_;
+  size_t trajectoryLength_;
+  double buildStageTimes_[XPS_NUM_BUILD_STAGES]; /**< Seconds of each stage of the last buildProfile() */
   
   friend class XPSAxis;
 };
@@ -0,0 +1,125 @@
+/* Program to measure the calls per second of the XPS_C8_drivers functions
+ * which the XPS driver calls in every poll.
+ * The XPS is replaced by a stand-in server on the loopback interface, which
+ * answers every request at once with the same reply, so that the time is
+ * spent in the API layer, asyn and the TCP stack rather than in the controller.
+ *
+ * Usage: XPSPollBench [numCalls [numPositioners]]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epicsThread.h>
+#include <epicsTime.h>
+#include <osiSock.h>
+
+#include <shareLib.h>
+#include "XPS_C8_drivers.h"
+#include "asynAxisStandIn.h"
+
+#define DEFAULT_NUM_CALLS 10000
+#define MAX_POSITIONERS 8
+#define POLL_TIMEOUT 1.0
+#define BUFFER_SIZE 1024
+
+/* One status code and enough values for a group of MAX_POSITIONERS */
+static const char *standInReply = "0,12,1.5,1.5,1.5,1.5,1.5,1.5,1.5,1.5,EndOfAPI";
+
+static void standInConnection(void *arg)
+{
+    SOCKET sock = (SOCKET)(size_t)arg;
+    char buffer[BUFFER_SIZE];
+    size_t replyLen = strlen(standInReply);
+
+    /* The requests have no terminator, each one arrives in one piece on loopback */
+    while (recv(sock, buffer, sizeof(buffer), 0) > 0) {
+        if (send(sock, standInReply, (int)replyLen, 0) != (int)replyLen) break;
+    }
+    epicsSocketDestroy(sock);
+}
+
+/* Each connection in its own thread, as the XPS serves several sockets of the driver */
+static void standInAccepted(SOCKET sock, void *userPvt)
+{
+    epicsThreadCreate("XPSStandInConn", epicsThreadPriorityMedium,
+                      epicsThreadGetStackSize(epicsThreadStackSmall),
+                      standInConnection, (void *)(size_t)sock);
+}
+
+static void report(const char *name, int numCalls, epicsTimeStamp *pStart)
+{
+    epicsTimeStamp now;
+    double elapsed;
+
+    epicsTimeGetCurrent(&now);
+    elapsed = epicsTimeDiffInSeconds(&now, pStart);
+    printf("%-32s %8d calls %8.3f s %10.0f calls/s\n",
+           name, numCalls, elapsed, elapsed > 0. ? numCalls/elapsed : 0.);
+}
+
+int main(int argc, char *argv[])
+{
+    int numCalls = DEFAULT_NUM_CALLS;
+    int numPositioners = MAX_POSITIONERS;
+    int port;
+    int pollSocket;
+    int groupStatus;
+    int positionerError;
+    double values[MAX_POSITIONERS];
+    double lowLimit, highLimit;
+    char statusString[BUFFER_SIZE];
+    char group[] = "GROUP1";
+    char positioner[] = "GROUP1.POSITIONER";
+    epicsTimeStamp start;
+    int i;
+
+    if (argc > 1) numCalls = atoi(argv[1]);
+    if (argc > 2) numPositioners = atoi(argv[2]);
+    if (numCalls < 1 || numPositioners < 1 || numPositioners > MAX_POSITIONERS) {
+        printf("Usage: %s [numCalls [numPositioners]], numPositioners 1 to %d\n",
+               argv[0], MAX_POSITIONERS);
+        return 1;
+    }
+
+    port = asynAxisStandInStart("XPSStandIn",
+                                epicsThreadGetStackSize(epicsThreadStackSmall),
+                                standInAccepted, NULL);
+    if (port < 0) {
+        printf("Error starting the stand-in server\n");
+        return 1;
+    }
+    pollSocket = TCP_ConnectToServer("127.0.0.1", port, POLL_TIMEOUT);
+    if (pollSocket < 0) {
+        printf("Error connecting to the stand-in server on port %d\n", port);
+        return 1;
+    }
+    printf("Stand-in server on port %d, %d positioners\n", port, numPositioners);
+
+    epicsTimeGetCurrent(&start);
+    for (i=0; i<numCalls; i++) GroupStatusGet(pollSocket, group, &groupStatus);
+    report("GroupStatusGet", numCalls, &start);
+
+    epicsTimeGetCurrent(&start);
+    for (i=0; i<numCalls; i++) GroupStatusStringGet(pollSocket, groupStatus, statusString);
+    report("GroupStatusStringGet", numCalls, &start);
+
+    epicsTimeGetCurrent(&start);
+    for (i=0; i<numCalls; i++) PositionerUserTravelLimitsGet(pollSocket, positioner, &lowLimit, &highLimit);
+    report("PositionerUserTravelLimitsGet", numCalls, &start);
+
+    epicsTimeGetCurrent(&start);
+    for (i=0; i<numCalls; i++) GroupPositionCurrentGet(pollSocket, group, numPositioners, values);
+    report("GroupPositionCurrentGet", numCalls, &start);
+
+    epicsTimeGetCurrent(&start);
+    for (i=0; i<numCalls; i++) PositionerErrorGet(pollSocket, positioner, &positionerError);
+    report("PositionerErrorGet", numCalls, &start);
+
+    epicsTimeGetCurrent(&start);
+    for (i=0; i<numCalls; i++) GroupMoveAbsolute(pollSocket, group, numPositioners, values);
+    report("GroupMoveAbsolute", numCalls, &start);
+
+    TCP_CloseSocket(pollSocket);
+    return 0;
+}
@@ -0,0 +1,272 @@
+/* Program to measure the time to create a trajectory for a profile move and
+ * store it on the XPS by FTP, as XPSController::buildProfile() does.
+ * Compares the old way, a local file which is stored in a new FTP session for
+ * each build, with the trajectory in memory which is stored in one session
+ * that is kept open.
+ * The FTP server of the XPS is replaced by a stand-in server on the loopback
+ * interface, which checks that it receives the trajectory unchanged.
+ *
+ * Usage: XPSTrajectoryBench [numBuilds [numPoints [numAxes]]]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epicsThread.h>
+#include <epicsTime.h>
+#include <epicsStdio.h>
+#include <osiSock.h>
+
+#include <shareLib.h>
+#include "xps_ftp.h"
+#include "asynAxisStandIn.h"
+
+#define DEFAULT_NUM_BUILDS 100
+#define DEFAULT_NUM_POINTS 1000
+#define DEFAULT_NUM_AXES 2
+#define MAX_AXES 8
+#define ELEMENT_LEN 32
+#define LINE_LEN 256
+#define TRAJECTORY_FILE "TrajectoryBench.trj"
+
+/* The last file which the stand-in server received */
+static char *storedBuffer;
+static int storedLength;
+static int storedSize;
+
+static int standInReply(SOCKET sock, const char *reply)
+{
+    int len = (int)strlen(reply);
+    return (send(sock, reply, len, 0) == len) ? 0 : -1;
+}
+
+/* Reads a command, returns its length or -1 when the connection is closed */
+static int standInCommand(SOCKET sock, char *line)
+{
+    int len = 0;
+
+    while (len < LINE_LEN-1) {
+        if (recv(sock, line+len, 1, 0) != 1) return -1;
+        if (line[len] == '\n') break;
+        len++;
+    }
+    if ((len > 0) && (line[len-1] == '\r')) len--;
+    line[len] = '\0';
+    return len;
+}
+
+/* Receives a file on the data connection */
+static void standInStore(SOCKET dataSock)
+{
+    int i;
+
+    storedLength = 0;
+    while (1) {
+        if (storedLength == storedSize) {
+            storedSize = storedSize ? 2*storedSize : 65536;
+            storedBuffer = realloc(storedBuffer, storedSize);
+        }
+        i = recv(dataSock, storedBuffer + storedLength, storedSize - storedLength, 0);
+        if (i <= 0) break;
+        storedLength += i;
+    }
+}
+
+/* The sessions are used one after the other, as by buildProfile() */
+static void standInConnection(SOCKET sock, void *userPvt)
+{
+    SOCKET pasvSock = INVALID_SOCKET;
+    SOCKET dataSock;
+    osiSockAddr addr;
+    osiSocklen_t addrLen;
+    char line[LINE_LEN];
+    char reply[LINE_LEN];
+    int port;
+    int flag = 1;
+
+    /* STOR has two replies, "150" and "226", without a command in between.
+     * Send them at once, so that this is not delayed until the client acknowledges "150" */
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (char *)&flag, sizeof(flag));
+    if (standInReply(sock, "220 XPS FTP stand-in\r\n")) goto done;
+    while (standInCommand(sock, line) >= 0) {
+        if (!strncmp(line, "USER", 4)) {
+            strcpy(reply, "331 Password required\r\n");
+        } else if (!strncmp(line, "PASS", 4)) {
+            strcpy(reply, "230 User logged in\r\n");
+        } else if (!strncmp(line, "TYPE", 4)) {
+            strcpy(reply, "200 Type set to I\r\n");
+        } else if (!strncmp(line, "CWD", 3)) {
+            strcpy(reply, "250 CWD command successful\r\n");
+        } else if (!strncmp(line, "PASV", 4)) {
+            /* A new data port for each transfer, as the XPS */
+            if (pasvSock != INVALID_SOCKET) epicsSocketDestroy(pasvSock);
+            pasvSock = epicsSocketCreate(AF_INET, SOCK_STREAM, 0);
+            memset(&addr, 0, sizeof(addr));
+            addr.ia.sin_family = AF_INET;
+            addr.ia.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addrLen = sizeof(addr.ia);
+            if (bind(pasvSock, &addr.sa, sizeof(addr.ia)) ||
+                listen(pasvSock, 1) ||
+                getsockname(pasvSock, &addr.sa, &addrLen)) break;
+            port = ntohs(addr.ia.sin_port);
+            sprintf(reply, "227 Entering Passive Mode (127,0,0,1,%d,%d)\r\n", port/256, port%256);
+        } else if (!strncmp(line, "STOR", 4)) {
+            if (pasvSock == INVALID_SOCKET) {
+                strcpy(reply, "425 Use PASV first\r\n");
+            } else {
+                if (standInReply(sock, "150 Opening BINARY mode data connection\r\n")) break;
+                addrLen = sizeof(addr.sa);
+                dataSock = epicsSocketAccept(pasvSock, &addr.sa, &addrLen);
+                epicsSocketDestroy(pasvSock);
+                pasvSock = INVALID_SOCKET;
+                if (dataSock == INVALID_SOCKET) break;
+                standInStore(dataSock);
+                epicsSocketDestroy(dataSock);
+                strcpy(reply, "226 Transfer complete\r\n");
+            }
+        } else if (!strncmp(line, "QUIT", 4)) {
+            standInReply(sock, "221 Goodbye\r\n");
+            break;
+        } else {
+            strcpy(reply, "502 Command not implemented\r\n");
+        }
+        if (standInReply(sock, reply)) break;
+    }
+done:
+    if (pasvSock != INVALID_SOCKET) epicsSocketDestroy(pasvSock);
+    epicsSocketDestroy(sock);
+}
+
+/* The trajectory as buildProfile() creates it, one element per line */
+static int writeTrajectory(FILE *fp, char *buffer, int size, int numPoints, int numAxes)
+{
+    int len = 0;
+    int i, j;
+
+    for (i=0; i<numPoints; i++) {
+        if (fp) fprintf(fp, "%f", 0.01);
+        else len += epicsSnprintf(buffer+len, size-len, "%f", 0.01);
+        for (j=0; j<numAxes; j++) {
+            if (fp) fprintf(fp, ", %f, %f", 0.001*(i+j), 0.1*(j+1));
+            else len += epicsSnprintf(buffer+len, size-len, ", %f, %f", 0.001*(i+j), 0.1*(j+1));
+        }
+        if (i == numPoints-1) break;
+        if (fp) fprintf(fp, "\n");
+        else len += epicsSnprintf(buffer+len, size-len, "\n");
+    }
+    return len;
+}
+
+static double elapsed(epicsTimeStamp *pStart)
+{
+    epicsTimeStamp now;
+
+    epicsTimeGetCurrent(&now);
+    return epicsTimeDiffInSeconds(&now, pStart);
+}
+
+static void report(const char *name, int numBuilds, double fileTime, double uploadTime)
+{
+    printf("%-24s file %8.3f ms upload %8.3f ms total %8.3f ms per build\n",
+           name, 1e3*fileTime/numBuilds, 1e3*uploadTime/numBuilds,
+           1e3*(fileTime+uploadTime)/numBuilds);
+}
+
+int main(int argc, char *argv[])
+{
+    int numBuilds = DEFAULT_NUM_BUILDS;
+    int numPoints = DEFAULT_NUM_POINTS;
+    int numAxes = DEFAULT_NUM_AXES;
+    int port;
+    int size;
+    int length = 0;
+    int status;
+    char *buffer;
+    char ip[] = "127.0.0.1";
+    char user[] = "Administrator";
+    char password[] = "Administrator";
+    char directory[] = "/Admin/Public/Trajectories";
+    char fileName[] = TRAJECTORY_FILE;
+    double fileTime, uploadTime;
+    epicsTimeStamp start;
+    FILE *fp;
+    SOCKET ftpSocket;
+    int i;
+
+    if (argc > 1) numBuilds = atoi(argv[1]);
+    if (argc > 2) numPoints = atoi(argv[2]);
+    if (argc > 3) numAxes = atoi(argv[3]);
+    if (numBuilds < 1 || numPoints < 1 || numAxes < 1 || numAxes > MAX_AXES) {
+        printf("Usage: %s [numBuilds [numPoints [numAxes]]], numAxes 1 to %d\n",
+               argv[0], MAX_AXES);
+        return 1;
+    }
+
+    port = asynAxisStandInStart("XPSFtpStandIn",
+                                epicsThreadGetStackSize(epicsThreadStackMedium),
+                                standInConnection, NULL);
+    if (port < 0) {
+        printf("Error starting the stand-in server\n");
+        return 1;
+    }
+    printf("Stand-in FTP server on port %d, %d points, %d axes\n", port, numPoints, numAxes);
+    size = numPoints * (numAxes*2 + 1) * ELEMENT_LEN;
+    buffer = calloc(size, 1);
+
+    /* A local file, in a new session for each build */
+    fileTime = uploadTime = 0.;
+    for (i=0; i<numBuilds; i++) {
+        epicsTimeGetCurrent(&start);
+        fp = fopen(fileName, "wb");
+        if (!fp) {
+            printf("Error creating %s\n", fileName);
+            return 1;
+        }
+        writeTrajectory(fp, NULL, 0, numPoints, numAxes);
+        fclose(fp);
+        fileTime += elapsed(&start);
+        epicsTimeGetCurrent(&start);
+        status = ftpConnectPort(ip, port, user, password, &ftpSocket);
+        if (!status) status = ftpChangeDir(ftpSocket, directory);
+        if (!status) status = ftpStoreFile(ftpSocket, fileName);
+        ftpDisconnect(ftpSocket);
+        uploadTime += elapsed(&start);
+        if (status) {
+            printf("Error storing %s, status=%d\n", fileName, status);
+            return 1;
+        }
+    }
+    remove(fileName);
+    report("file, new session", numBuilds, fileTime, uploadTime);
+
+    /* In memory, in one session */
+    fileTime = uploadTime = 0.;
+    status = ftpConnectPort(ip, port, user, password, &ftpSocket);
+    if (!status) status = ftpChangeDir(ftpSocket, directory);
+    if (status) {
+        printf("Error connecting, status=%d\n", status);
+        return 1;
+    }
+    for (i=0; i<numBuilds; i++) {
+        epicsTimeGetCurrent(&start);
+        length = writeTrajectory(NULL, buffer, size, numPoints, numAxes);
+        fileTime += elapsed(&start);
+        epicsTimeGetCurrent(&start);
+        status = ftpStoreBuffer(ftpSocket, fileName, buffer, length);
+        uploadTime += elapsed(&start);
+        if (status) {
+            printf("Error storing %s, status=%d\n", fileName, status);
+            return 1;
+        }
+    }
+    ftpDisconnect(ftpSocket);
+    report("memory, one session", numBuilds, fileTime, uploadTime);
+
+    if ((storedLength != length) || memcmp(storedBuffer, buffer, length)) {
+        printf("Error, the stand-in server received %d bytes, not the %d bytes of the trajectory\n",
+               storedLength, length);
+        return 1;
+    }
+    printf("The stand-in server received the trajectory unchanged, %d bytes\n", length);
+    return 0;
+}
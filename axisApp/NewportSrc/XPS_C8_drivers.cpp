@@ -7,6 +7,9 @@
 #include <stdlib.h> 
 #include <stdarg.h> 
 #include <string.h> 
+#include <epicsThread.h>
+#include <epicsExit.h>
+#include <epicsStdio.h>
 #include "Socket.h" 
 
 #define epicsExportSharedSymbols
@@ -24,6 +27,90 @@
 #define SIZE_EXECUTE_METHOD 1024
 
 #define SIZE_NAME    100
+
+/* Each thread reuses one buffer for the replies of the controller, so that the
+   functions below do not allocate memory on every call.  The reply is parsed after
+   SendAndReceive() has released the socket, and several threads share a socket,
+   so the buffer belongs to the thread rather than to the socket.  The functions
+   do not call each other, so one buffer per thread is enough. */
+typedef struct {
+	char *buffer;
+	int size;
+} ReturnBuffer_t;
+
+static epicsThreadOnceId ReturnBufferOnceId = EPICS_THREAD_ONCE_INIT;
+static epicsThreadPrivateId ReturnBufferId;
+
+static void ReturnBufferInit (void *arg)
+{
+	ReturnBufferId = epicsThreadPrivateCreate ();
+}
+
+/* Frees the reply buffer when its thread exits */
+static void ReturnBufferFree (void *arg)
+{
+	ReturnBuffer_t *pReturnBuffer = (ReturnBuffer_t *) arg;
+
+	epicsThreadPrivateSet (ReturnBufferId, NULL);
+	free (pReturnBuffer->buffer);
+	free (pReturnBuffer);
+}
+
+/* Returns the reply buffer of this thread, with at least size bytes,
+   or NULL if it cannot be allocated */
+static char * ReturnBufferGet (int size)
+{
+	ReturnBuffer_t *pReturnBuffer;
+
+	epicsThreadOnce (&ReturnBufferOnceId, ReturnBufferInit, NULL);
+	pReturnBuffer = (ReturnBuffer_t *) epicsThreadPrivateGet (ReturnBufferId);
+	if (pReturnBuffer == NULL)
+	{
+		pReturnBuffer = (ReturnBuffer_t *) calloc (1, sizeof(ReturnBuffer_t));
+		if (pReturnBuffer == NULL) return (NULL);
+		epicsThreadPrivateSet (ReturnBufferId, pReturnBuffer);
+		epicsAtThreadExit (ReturnBufferFree, pReturnBuffer);
+	}
+	if (pReturnBuffer->size < size)
+	{
+		free (pReturnBuffer->buffer);
+		pReturnBuffer->size = 0;
+		pReturnBuffer->buffer = (char *) malloc (size);
+		if (pReturnBuffer->buffer == NULL) return (NULL);
+		pReturnBuffer->size = size;
+	}
+	pReturnBuffer->buffer[0] = '\0';
+	return (pReturnBuffer->buffer);
+}
+
+/* Append to a request at its end pointer, rather than searching for the end of
+   the string on every call like strcat() does.  The request is truncated at pLimit.
+   They return the new end pointer */
+static char * AppendString (char *pEnd, const char *pLimit, const char *string)
+{
+	while (*string && (pEnd < pLimit - 1)) *pEnd++ = *string++;
+	*pEnd = '\0';
+	return (pEnd);
+}
+
+static char * AppendFormat (char *pEnd, const char *pLimit, const char *format, ...)
+{
+	va_list args;
+	int len;
+
+	if (pEnd >= pLimit - 1) return (pEnd);
+	va_start (args, format);
+	len = epicsVsnprintf (pEnd, pLimit - pEnd, format, args);
+	va_end (args);
+	if (len < 0)
+	{
+		*pEnd = '\0';
+		return (pEnd);
+	}
+	if (len >= pLimit - pEnd) return ((char *) pLimit - 1);
+	return (pEnd + len);
+}
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -75,7 +162,10 @@ int __stdcall ControllerMotionKernelTimeLoadGet (int SocketIndex, double * CPUTo
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ControllerMotionKernelTimeLoadGet (double *,double *,double *,double *)");
@@ -105,8 +195,6 @@ int __stdcall ControllerMotionKernelTimeLoadGet (int SocketIndex, double * CPUTo
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", CPUServitudesLoadRatio);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -125,7 +213,10 @@ int __stdcall ControllerStatusGet (int SocketIndex, int * ControllerStatus)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ControllerStatusGet (int *)");
@@ -146,8 +237,6 @@ int __stdcall ControllerStatusGet (int SocketIndex, int * ControllerStatus)
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", ControllerStatus);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -167,7 +256,10 @@ int __stdcall ControllerStatusStringGet (int SocketIndex, int ControllerStatusCo
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ControllerStatusStringGet (%d,char *)", ControllerStatusCode);
@@ -192,8 +284,6 @@ int __stdcall ControllerStatusStringGet (int SocketIndex, int ControllerStatusCo
 		ptNext = strchr (ControllerStatusString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -212,7 +302,10 @@ int __stdcall ElapsedTimeGet (int SocketIndex, double * ElapsedTime)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ElapsedTimeGet (double *)");
@@ -233,8 +326,6 @@ int __stdcall ElapsedTimeGet (int SocketIndex, double * ElapsedTime)
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", ElapsedTime);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -254,7 +345,10 @@ int __stdcall ErrorStringGet (int SocketIndex, int ErrorCode, char * ErrorString
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ErrorStringGet (%d,char *)", ErrorCode);
@@ -279,8 +373,6 @@ int __stdcall ErrorStringGet (int SocketIndex, int ErrorCode, char * ErrorString
 		ptNext = strchr (ErrorString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -299,7 +391,10 @@ int __stdcall FirmwareVersionGet (int SocketIndex, char * Version)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "FirmwareVersionGet (char *)");
@@ -324,8 +419,6 @@ int __stdcall FirmwareVersionGet (int SocketIndex, char * Version)
 		ptNext = strchr (Version, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -346,7 +439,10 @@ int __stdcall TCLScriptExecute (int SocketIndex, char * TCLFileName, char * Task
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "TCLScriptExecute (%s,%s,%s)", TCLFileName, TaskName, ParametersList);
@@ -358,8 +454,6 @@ int __stdcall TCLScriptExecute (int SocketIndex, char * TCLFileName, char * Task
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -381,7 +475,10 @@ int __stdcall TCLScriptExecuteAndWait (int SocketIndex, char * TCLFileName, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "TCLScriptExecuteAndWait (%s,%s,%s,char *)", TCLFileName, TaskName, InputParametersList);
@@ -406,8 +503,6 @@ int __stdcall TCLScriptExecuteAndWait (int SocketIndex, char * TCLFileName, char
 		ptNext = strchr (OutputParametersList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -429,7 +524,10 @@ int __stdcall TCLScriptExecuteWithPriority (int SocketIndex, char * TCLFileName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "TCLScriptExecuteWithPriority (%s,%s,%s,%s)", TCLFileName, TaskName, TaskPriorityLevel, ParametersList);
@@ -441,8 +539,6 @@ int __stdcall TCLScriptExecuteWithPriority (int SocketIndex, char * TCLFileName,
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -461,7 +557,10 @@ int __stdcall TCLScriptKill (int SocketIndex, char * TaskName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "TCLScriptKill (%s)", TaskName);
@@ -473,8 +572,6 @@ int __stdcall TCLScriptKill (int SocketIndex, char * TaskName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -494,7 +591,10 @@ int __stdcall TimerGet (int SocketIndex, char * TimerName, int * FrequencyTicks)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "TimerGet (%s,int *)", TimerName);
@@ -515,8 +615,6 @@ int __stdcall TimerGet (int SocketIndex, char * TimerName, int * FrequencyTicks)
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", FrequencyTicks);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -536,7 +634,10 @@ int __stdcall TimerSet (int SocketIndex, char * TimerName, int FrequencyTicks)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "TimerSet (%s,%d)", TimerName, FrequencyTicks);
@@ -548,8 +649,6 @@ int __stdcall TimerSet (int SocketIndex, char * TimerName, int FrequencyTicks)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -567,7 +666,10 @@ int __stdcall Reboot (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "Reboot ()");
@@ -579,8 +681,6 @@ int __stdcall Reboot (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -600,7 +700,10 @@ int __stdcall Login (int SocketIndex, char * Name, char * Password)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "Login (%s,%s)", Name, Password);
@@ -612,8 +715,6 @@ int __stdcall Login (int SocketIndex, char * Name, char * Password)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -631,7 +732,10 @@ int __stdcall CloseAllOtherSockets (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "CloseAllOtherSockets ()");
@@ -643,8 +747,6 @@ int __stdcall CloseAllOtherSockets (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -663,7 +765,10 @@ int __stdcall HardwareDateAndTimeGet (int SocketIndex, char * DateAndTime)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "HardwareDateAndTimeGet (char *)");
@@ -688,8 +793,6 @@ int __stdcall HardwareDateAndTimeGet (int SocketIndex, char * DateAndTime)
 		ptNext = strchr (DateAndTime, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -708,7 +811,10 @@ int __stdcall HardwareDateAndTimeSet (int SocketIndex, char * DateAndTime)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "HardwareDateAndTimeSet (%s)", DateAndTime);
@@ -720,8 +826,6 @@ int __stdcall HardwareDateAndTimeSet (int SocketIndex, char * DateAndTime)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -746,7 +850,10 @@ int __stdcall EventAdd (int SocketIndex, char * PositionerName, char * EventName
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventAdd (%s,%s,%s,%s,%s,%s,%s)", PositionerName, EventName, EventParameter, ActionName, ActionParameter1, ActionParameter2, ActionParameter3);
@@ -758,8 +865,6 @@ int __stdcall EventAdd (int SocketIndex, char * PositionerName, char * EventName
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -779,7 +884,10 @@ int __stdcall EventGet (int SocketIndex, char * PositionerName, char * EventsAnd
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventGet (%s,char *)", PositionerName);
@@ -804,8 +912,6 @@ int __stdcall EventGet (int SocketIndex, char * PositionerName, char * EventsAnd
 		ptNext = strchr (EventsAndActionsList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -826,7 +932,10 @@ int __stdcall EventRemove (int SocketIndex, char * PositionerName, char * EventN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventRemove (%s,%s,%s)", PositionerName, EventName, EventParameter);
@@ -838,8 +947,6 @@ int __stdcall EventRemove (int SocketIndex, char * PositionerName, char * EventN
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -860,7 +967,10 @@ int __stdcall EventWait (int SocketIndex, char * PositionerName, char * EventNam
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventWait (%s,%s,%s)", PositionerName, EventName, EventParameter);
@@ -872,8 +982,6 @@ int __stdcall EventWait (int SocketIndex, char * PositionerName, char * EventNam
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -897,8 +1005,11 @@ int __stdcall EventExtendedConfigurationTriggerSet (int SocketIndex, int NbEleme
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -974,17 +1085,13 @@ int __stdcall EventExtendedConfigurationTriggerSet (int SocketIndex, int NbEleme
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "EventExtendedConfigurationTriggerSet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "EventExtendedConfigurationTriggerSet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s,%s,%s,%s,%s", stringArray0[i], stringArray1[i], stringArray2[i], stringArray3[i], stringArray4[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%s,%s,%s,%s,%s", stringArray0[i], stringArray1[i], stringArray2[i], stringArray3[i], stringArray4[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -1000,8 +1107,6 @@ int __stdcall EventExtendedConfigurationTriggerSet (int SocketIndex, int NbEleme
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1020,7 +1125,10 @@ int __stdcall EventExtendedConfigurationTriggerGet (int SocketIndex, char * Even
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventExtendedConfigurationTriggerGet (char *)");
@@ -1045,8 +1153,6 @@ int __stdcall EventExtendedConfigurationTriggerGet (int SocketIndex, char * Even
 		ptNext = strchr (EventTriggerConfiguration, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1070,8 +1176,11 @@ int __stdcall EventExtendedConfigurationActionSet (int SocketIndex, int NbElemen
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -1147,17 +1256,13 @@ int __stdcall EventExtendedConfigurationActionSet (int SocketIndex, int NbElemen
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "EventExtendedConfigurationActionSet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "EventExtendedConfigurationActionSet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s,%s,%s,%s,%s", stringArray0[i], stringArray1[i], stringArray2[i], stringArray3[i], stringArray4[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%s,%s,%s,%s,%s", stringArray0[i], stringArray1[i], stringArray2[i], stringArray3[i], stringArray4[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -1173,8 +1278,6 @@ int __stdcall EventExtendedConfigurationActionSet (int SocketIndex, int NbElemen
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1193,7 +1296,10 @@ int __stdcall EventExtendedConfigurationActionGet (int SocketIndex, char * Actio
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventExtendedConfigurationActionGet (char *)");
@@ -1218,8 +1324,6 @@ int __stdcall EventExtendedConfigurationActionGet (int SocketIndex, char * Actio
 		ptNext = strchr (ActionConfiguration, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1238,7 +1342,10 @@ int __stdcall EventExtendedStart (int SocketIndex, int * ID)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventExtendedStart (int *)");
@@ -1259,8 +1366,6 @@ int __stdcall EventExtendedStart (int SocketIndex, int * ID)
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", ID);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1279,7 +1384,10 @@ int __stdcall EventExtendedAllGet (int SocketIndex, char * EventActionConfigurat
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventExtendedAllGet (char *)");
@@ -1304,8 +1412,6 @@ int __stdcall EventExtendedAllGet (int SocketIndex, char * EventActionConfigurat
 		ptNext = strchr (EventActionConfigurations, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1326,7 +1432,10 @@ int __stdcall EventExtendedGet (int SocketIndex, int ID, char * EventTriggerConf
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventExtendedGet (%d,char *,char *)", ID);
@@ -1356,8 +1465,6 @@ int __stdcall EventExtendedGet (int SocketIndex, int ID, char * EventTriggerConf
 		ptNext = strchr (ActionConfiguration, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1376,7 +1483,10 @@ int __stdcall EventExtendedRemove (int SocketIndex, int ID)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventExtendedRemove (%d)", ID);
@@ -1388,8 +1498,6 @@ int __stdcall EventExtendedRemove (int SocketIndex, int ID)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1407,7 +1515,10 @@ int __stdcall EventExtendedWait (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventExtendedWait ()");
@@ -1419,8 +1530,6 @@ int __stdcall EventExtendedWait (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1439,7 +1548,10 @@ int __stdcall GatheringConfigurationGet (int SocketIndex, char * Type)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringConfigurationGet (char *)");
@@ -1464,8 +1576,6 @@ int __stdcall GatheringConfigurationGet (int SocketIndex, char * Type)
 		ptNext = strchr (Type, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1485,8 +1595,11 @@ int __stdcall GatheringConfigurationSet (int SocketIndex, int NbElements, char *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -1510,17 +1623,13 @@ int __stdcall GatheringConfigurationSet (int SocketIndex, int NbElements, char *
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GatheringConfigurationSet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GatheringConfigurationSet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s", stringArray0[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, stringArray0[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -1532,8 +1641,6 @@ int __stdcall GatheringConfigurationSet (int SocketIndex, int NbElements, char *
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1553,7 +1660,10 @@ int __stdcall GatheringCurrentNumberGet (int SocketIndex, int * CurrentNumber, i
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringCurrentNumberGet (int *,int *)");
@@ -1577,8 +1687,6 @@ int __stdcall GatheringCurrentNumberGet (int SocketIndex, int * CurrentNumber, i
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", MaximumSamplesNumber);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1596,7 +1704,10 @@ int __stdcall GatheringStopAndSave (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringStopAndSave ()");
@@ -1608,8 +1719,6 @@ int __stdcall GatheringStopAndSave (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1627,7 +1736,10 @@ int __stdcall GatheringDataAcquire (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringDataAcquire ()");
@@ -1639,8 +1751,6 @@ int __stdcall GatheringDataAcquire (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1660,7 +1770,10 @@ int __stdcall GatheringDataGet (int SocketIndex, int IndexPoint, char * DataBuff
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringDataGet (%d,char *)", IndexPoint);
@@ -1685,8 +1798,6 @@ int __stdcall GatheringDataGet (int SocketIndex, int IndexPoint, char * DataBuff
 		ptNext = strchr (DataBufferLine, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1707,7 +1818,10 @@ int __stdcall GatheringDataMultipleLinesGet (int SocketIndex, int IndexPoint, in
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringDataMultipleLinesGet (%d,%d,char *)", IndexPoint, NumberOfLines);
@@ -1732,8 +1846,6 @@ int __stdcall GatheringDataMultipleLinesGet (int SocketIndex, int IndexPoint, in
 		ptNext = strchr (DataBufferLine, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	}
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1751,7 +1863,10 @@ int __stdcall GatheringReset (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringReset ()");
@@ -1763,8 +1878,6 @@ int __stdcall GatheringReset (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1784,7 +1897,10 @@ int __stdcall GatheringRun (int SocketIndex, int DataNumber, int Divisor)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringRun (%d,%d)", DataNumber, Divisor);
@@ -1796,8 +1912,6 @@ int __stdcall GatheringRun (int SocketIndex, int DataNumber, int Divisor)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1815,7 +1929,10 @@ int __stdcall GatheringRunAppend (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringRunAppend ()");
@@ -1827,8 +1944,6 @@ int __stdcall GatheringRunAppend (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1846,7 +1961,10 @@ int __stdcall GatheringStop (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringStop ()");
@@ -1858,8 +1976,6 @@ int __stdcall GatheringStop (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1879,8 +1995,11 @@ int __stdcall GatheringExternalConfigurationSet (int SocketIndex, int NbElements
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -1904,17 +2023,13 @@ int __stdcall GatheringExternalConfigurationSet (int SocketIndex, int NbElements
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GatheringExternalConfigurationSet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GatheringExternalConfigurationSet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s", stringArray0[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, stringArray0[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -1926,8 +2041,6 @@ int __stdcall GatheringExternalConfigurationSet (int SocketIndex, int NbElements
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1946,7 +2059,10 @@ int __stdcall GatheringExternalConfigurationGet (int SocketIndex, char * Type)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringExternalConfigurationGet (char *)");
@@ -1971,8 +2087,6 @@ int __stdcall GatheringExternalConfigurationGet (int SocketIndex, char * Type)
 		ptNext = strchr (Type, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -1992,7 +2106,10 @@ int __stdcall GatheringExternalCurrentNumberGet (int SocketIndex, int * CurrentN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringExternalCurrentNumberGet (int *,int *)");
@@ -2016,8 +2133,6 @@ int __stdcall GatheringExternalCurrentNumberGet (int SocketIndex, int * CurrentN
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", MaximumSamplesNumber);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2037,7 +2152,10 @@ int __stdcall GatheringExternalDataGet (int SocketIndex, int IndexPoint, char *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringExternalDataGet (%d,char *)", IndexPoint);
@@ -2062,8 +2180,6 @@ int __stdcall GatheringExternalDataGet (int SocketIndex, int IndexPoint, char *
 		ptNext = strchr (DataBufferLine, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2081,7 +2197,10 @@ int __stdcall GatheringExternalStopAndSave (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringExternalStopAndSave ()");
@@ -2093,8 +2212,6 @@ int __stdcall GatheringExternalStopAndSave (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2114,7 +2231,10 @@ int __stdcall GlobalArrayGet (int SocketIndex, int Number, char * ValueString)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GlobalArrayGet (%d,char *)", Number);
@@ -2139,8 +2259,6 @@ int __stdcall GlobalArrayGet (int SocketIndex, int Number, char * ValueString)
 		ptNext = strchr (ValueString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2160,7 +2278,10 @@ int __stdcall GlobalArraySet (int SocketIndex, int Number, char * ValueString)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GlobalArraySet (%d,%s)", Number, ValueString);
@@ -2172,8 +2293,6 @@ int __stdcall GlobalArraySet (int SocketIndex, int Number, char * ValueString)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2193,7 +2312,10 @@ int __stdcall DoubleGlobalArrayGet (int SocketIndex, int Number, double * Double
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "DoubleGlobalArrayGet (%d,double *)", Number);
@@ -2214,8 +2336,6 @@ int __stdcall DoubleGlobalArrayGet (int SocketIndex, int Number, double * Double
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", DoubleValue);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2235,7 +2355,10 @@ int __stdcall DoubleGlobalArraySet (int SocketIndex, int Number, double DoubleVa
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "DoubleGlobalArraySet (%d,%.13g)", Number, DoubleValue);
@@ -2247,8 +2370,6 @@ int __stdcall DoubleGlobalArraySet (int SocketIndex, int Number, double DoubleVa
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2269,8 +2390,11 @@ int __stdcall GPIOAnalogGet (int SocketIndex, int NbElements, char * GPIONameLis
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -2294,17 +2418,13 @@ int __stdcall GPIOAnalogGet (int SocketIndex, int NbElements, char * GPIONameLis
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GPIOAnalogGet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GPIOAnalogGet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s,double *", stringArray0[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%s,double *", stringArray0[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -2329,8 +2449,6 @@ int __stdcall GPIOAnalogGet (int SocketIndex, int NbElements, char * GPIONameLis
 			if (pt != NULL) sscanf (pt, "%lf", &AnalogValue[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2351,8 +2469,11 @@ int __stdcall GPIOAnalogSet (int SocketIndex, int NbElements, char * GPIONameLis
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -2376,17 +2497,13 @@ int __stdcall GPIOAnalogSet (int SocketIndex, int NbElements, char * GPIONameLis
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GPIOAnalogSet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GPIOAnalogSet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s,%.13g", stringArray0[i], AnalogOutputValue[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%s,%.13g", stringArray0[i], AnalogOutputValue[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -2398,8 +2515,6 @@ int __stdcall GPIOAnalogSet (int SocketIndex, int NbElements, char * GPIONameLis
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2420,8 +2535,11 @@ int __stdcall GPIOAnalogGainGet (int SocketIndex, int NbElements, char * GPIONam
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -2445,17 +2563,13 @@ int __stdcall GPIOAnalogGainGet (int SocketIndex, int NbElements, char * GPIONam
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GPIOAnalogGainGet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GPIOAnalogGainGet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s,int *", stringArray0[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%s,int *", stringArray0[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -2480,8 +2594,6 @@ int __stdcall GPIOAnalogGainGet (int SocketIndex, int NbElements, char * GPIONam
 			if (pt != NULL) sscanf (pt, "%d", &AnalogInputGainValue[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2502,8 +2614,11 @@ int __stdcall GPIOAnalogGainSet (int SocketIndex, int NbElements, char * GPIONam
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Split list */ 
 	char *token;
@@ -2527,17 +2642,13 @@ int __stdcall GPIOAnalogGainSet (int SocketIndex, int NbElements, char * GPIONam
 	}
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GPIOAnalogGainSet (");
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GPIOAnalogGainSet (");
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%s,%d", stringArray0[i], AnalogInputGainValue[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%s,%d", stringArray0[i], AnalogInputGainValue[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Clear memory */ 
 	delete [] stringArray0;
@@ -2549,8 +2660,6 @@ int __stdcall GPIOAnalogGainSet (int SocketIndex, int NbElements, char * GPIONam
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2570,7 +2679,10 @@ int __stdcall GPIODigitalGet (int SocketIndex, char * GPIOName, unsigned short *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GPIODigitalGet (%s,unsigned short *)", GPIOName);
@@ -2591,8 +2703,6 @@ int __stdcall GPIODigitalGet (int SocketIndex, char * GPIOName, unsigned short *
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%hu", DigitalValue);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2613,7 +2723,10 @@ int __stdcall GPIODigitalSet (int SocketIndex, char * GPIOName, unsigned short M
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GPIODigitalSet (%s,%hu,%hu)", GPIOName, Mask, DigitalOutputValue);
@@ -2625,8 +2738,6 @@ int __stdcall GPIODigitalSet (int SocketIndex, char * GPIOName, unsigned short M
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2647,21 +2758,20 @@ int __stdcall GroupAccelerationSetpointGet (int SocketIndex, char * GroupName, i
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupAccelerationSetpointGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupAccelerationSetpointGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -2683,8 +2793,6 @@ int __stdcall GroupAccelerationSetpointGet (int SocketIndex, char * GroupName, i
 			if (pt != NULL) sscanf (pt, "%lf", &SetpointAcceleration[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2704,7 +2812,10 @@ int __stdcall GroupAnalogTrackingModeEnable (int SocketIndex, char * GroupName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupAnalogTrackingModeEnable (%s,%s)", GroupName, Type);
@@ -2716,8 +2827,6 @@ int __stdcall GroupAnalogTrackingModeEnable (int SocketIndex, char * GroupName,
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2736,7 +2845,10 @@ int __stdcall GroupAnalogTrackingModeDisable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupAnalogTrackingModeDisable (%s)", GroupName);
@@ -2748,8 +2860,6 @@ int __stdcall GroupAnalogTrackingModeDisable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2770,21 +2880,20 @@ int __stdcall GroupCorrectorOutputGet (int SocketIndex, char * GroupName, int Nb
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupCorrectorOutputGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupCorrectorOutputGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -2806,8 +2915,6 @@ int __stdcall GroupCorrectorOutputGet (int SocketIndex, char * GroupName, int Nb
 			if (pt != NULL) sscanf (pt, "%lf", &CorrectorOutput[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2828,21 +2935,20 @@ int __stdcall GroupCurrentFollowingErrorGet (int SocketIndex, char * GroupName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupCurrentFollowingErrorGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupCurrentFollowingErrorGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -2864,8 +2970,6 @@ int __stdcall GroupCurrentFollowingErrorGet (int SocketIndex, char * GroupName,
 			if (pt != NULL) sscanf (pt, "%lf", &CurrentFollowingError[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2884,7 +2988,10 @@ int __stdcall GroupHomeSearch (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupHomeSearch (%s)", GroupName);
@@ -2896,8 +3003,6 @@ int __stdcall GroupHomeSearch (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2917,21 +3022,20 @@ int __stdcall GroupHomeSearchAndRelativeMove (int SocketIndex, char * GroupName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupHomeSearchAndRelativeMove (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupHomeSearchAndRelativeMove (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%.13g", TargetDisplacement[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%.13g", TargetDisplacement[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -2940,8 +3044,6 @@ int __stdcall GroupHomeSearchAndRelativeMove (int SocketIndex, char * GroupName,
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2960,7 +3062,10 @@ int __stdcall GroupInitialize (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupInitialize (%s)", GroupName);
@@ -2972,8 +3077,6 @@ int __stdcall GroupInitialize (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -2992,7 +3095,10 @@ int __stdcall GroupInitializeWithEncoderCalibration (int SocketIndex, char * Gro
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupInitializeWithEncoderCalibration (%s)", GroupName);
@@ -3004,8 +3110,6 @@ int __stdcall GroupInitializeWithEncoderCalibration (int SocketIndex, char * Gro
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3026,21 +3130,20 @@ int __stdcall GroupJogParametersSet (int SocketIndex, char * GroupName, int NbEl
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupJogParametersSet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupJogParametersSet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%.13g,%.13g", Velocity[i], Acceleration[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%.13g,%.13g", Velocity[i], Acceleration[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3049,8 +3152,6 @@ int __stdcall GroupJogParametersSet (int SocketIndex, char * GroupName, int NbEl
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3072,21 +3173,20 @@ int __stdcall GroupJogParametersGet (int SocketIndex, char * GroupName, int NbEl
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupJogParametersGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupJogParametersGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *,double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *,double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3111,8 +3211,6 @@ int __stdcall GroupJogParametersGet (int SocketIndex, char * GroupName, int NbEl
 			if (pt != NULL) sscanf (pt, "%lf", &Acceleration[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3134,21 +3232,20 @@ int __stdcall GroupJogCurrentGet (int SocketIndex, char * GroupName, int NbEleme
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupJogCurrentGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupJogCurrentGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *,double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *,double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3173,8 +3270,6 @@ int __stdcall GroupJogCurrentGet (int SocketIndex, char * GroupName, int NbEleme
 			if (pt != NULL) sscanf (pt, "%lf", &Acceleration[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3193,7 +3288,10 @@ int __stdcall GroupJogModeEnable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupJogModeEnable (%s)", GroupName);
@@ -3205,8 +3303,6 @@ int __stdcall GroupJogModeEnable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3225,7 +3321,10 @@ int __stdcall GroupJogModeDisable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupJogModeDisable (%s)", GroupName);
@@ -3237,8 +3336,6 @@ int __stdcall GroupJogModeDisable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3257,7 +3354,10 @@ int __stdcall GroupKill (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupKill (%s)", GroupName);
@@ -3269,8 +3369,6 @@ int __stdcall GroupKill (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3289,7 +3387,10 @@ int __stdcall GroupMoveAbort (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupMoveAbort (%s)", GroupName);
@@ -3301,8 +3402,6 @@ int __stdcall GroupMoveAbort (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3322,21 +3421,20 @@ int __stdcall GroupMoveAbsolute (int SocketIndex, char * GroupName, int NbElemen
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupMoveAbsolute (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupMoveAbsolute (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%.13g", TargetPosition[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%.13g", TargetPosition[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3345,8 +3443,6 @@ int __stdcall GroupMoveAbsolute (int SocketIndex, char * GroupName, int NbElemen
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3366,21 +3462,20 @@ int __stdcall GroupMoveRelative (int SocketIndex, char * GroupName, int NbElemen
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupMoveRelative (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupMoveRelative (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "%.13g", TargetDisplacement[i]);
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendFormat (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "%.13g", TargetDisplacement[i]);
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3389,8 +3484,6 @@ int __stdcall GroupMoveRelative (int SocketIndex, char * GroupName, int NbElemen
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3409,7 +3502,10 @@ int __stdcall GroupMotionDisable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupMotionDisable (%s)", GroupName);
@@ -3421,8 +3517,6 @@ int __stdcall GroupMotionDisable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3441,7 +3535,10 @@ int __stdcall GroupMotionEnable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupMotionEnable (%s)", GroupName);
@@ -3453,8 +3550,6 @@ int __stdcall GroupMotionEnable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3477,7 +3572,10 @@ int __stdcall GroupPositionCorrectedProfilerGet (int SocketIndex, char * GroupNa
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupPositionCorrectedProfilerGet (%s,%.13g,%.13g,double *,double *)", GroupName, PositionX, PositionY);
@@ -3501,8 +3599,6 @@ int __stdcall GroupPositionCorrectedProfilerGet (int SocketIndex, char * GroupNa
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", CorrectedProfilerPositionY);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3523,21 +3619,20 @@ int __stdcall GroupPositionCurrentGet (int SocketIndex, char * GroupName, int Nb
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupPositionCurrentGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupPositionCurrentGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3559,8 +3654,6 @@ int __stdcall GroupPositionCurrentGet (int SocketIndex, char * GroupName, int Nb
 			if (pt != NULL) sscanf (pt, "%lf", &CurrentEncoderPosition[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3583,7 +3676,10 @@ int __stdcall GroupPositionPCORawEncoderGet (int SocketIndex, char * GroupName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupPositionPCORawEncoderGet (%s,%.13g,%.13g,double *,double *)", GroupName, PositionX, PositionY);
@@ -3607,8 +3703,6 @@ int __stdcall GroupPositionPCORawEncoderGet (int SocketIndex, char * GroupName,
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", PCORawPositionY);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3629,21 +3723,20 @@ int __stdcall GroupPositionSetpointGet (int SocketIndex, char * GroupName, int N
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupPositionSetpointGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupPositionSetpointGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3665,8 +3758,6 @@ int __stdcall GroupPositionSetpointGet (int SocketIndex, char * GroupName, int N
 			if (pt != NULL) sscanf (pt, "%lf", &SetPointPosition[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3687,21 +3778,20 @@ int __stdcall GroupPositionTargetGet (int SocketIndex, char * GroupName, int NbE
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupPositionTargetGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupPositionTargetGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3723,8 +3813,6 @@ int __stdcall GroupPositionTargetGet (int SocketIndex, char * GroupName, int NbE
 			if (pt != NULL) sscanf (pt, "%lf", &TargetPosition[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3746,7 +3834,10 @@ int __stdcall GroupReferencingActionExecute (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupReferencingActionExecute (%s,%s,%s,%.13g)", PositionerName, ReferencingAction, ReferencingSensor, ReferencingParameter);
@@ -3758,8 +3849,6 @@ int __stdcall GroupReferencingActionExecute (int SocketIndex, char * PositionerN
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3778,7 +3867,10 @@ int __stdcall GroupReferencingStart (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupReferencingStart (%s)", GroupName);
@@ -3790,8 +3882,6 @@ int __stdcall GroupReferencingStart (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3810,7 +3900,10 @@ int __stdcall GroupReferencingStop (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupReferencingStop (%s)", GroupName);
@@ -3822,8 +3915,6 @@ int __stdcall GroupReferencingStop (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3843,7 +3934,10 @@ int __stdcall GroupStatusGet (int SocketIndex, char * GroupName, int * Status)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupStatusGet (%s,int *)", GroupName);
@@ -3864,8 +3958,6 @@ int __stdcall GroupStatusGet (int SocketIndex, char * GroupName, int * Status)
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", Status);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3885,7 +3977,10 @@ int __stdcall GroupStatusStringGet (int SocketIndex, int GroupStatusCode, char *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupStatusStringGet (%d,char *)", GroupStatusCode);
@@ -3910,8 +4005,6 @@ int __stdcall GroupStatusStringGet (int SocketIndex, int GroupStatusCode, char *
 		ptNext = strchr (GroupStatusString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3932,21 +4025,20 @@ int __stdcall GroupVelocityCurrentGet (int SocketIndex, char * GroupName, int Nb
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
-	char temp[SIZE_NOMINAL];
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+	char * pEnd;
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
-	sprintf (ExecuteMethod, "GroupVelocityCurrentGet (%s,", GroupName);
+	pEnd = ExecuteMethod + sprintf (ExecuteMethod, "GroupVelocityCurrentGet (%s,", GroupName);
 	for (int i = 0; i < NbElements; i++)
 	{
-		sprintf (temp, "double *");
-		strncat (ExecuteMethod, temp, SIZE_SMALL);
-		if ((i + 1) < NbElements) 
-		{
-			strncat (ExecuteMethod, ",", SIZE_SMALL);
-		}
+		if (i > 0) pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ",");
+		pEnd = AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, "double *");
 	}
-	strcat (ExecuteMethod, ")");
+	AppendString (pEnd, ExecuteMethod + SIZE_EXECUTE_METHOD, ")");
 
 	/* Send this string and wait return function from controller */ 
 	/* return function : ==0 -> OK ; < 0 -> NOK */ 
@@ -3968,8 +4060,6 @@ int __stdcall GroupVelocityCurrentGet (int SocketIndex, char * GroupName, int Nb
 			if (pt != NULL) sscanf (pt, "%lf", &CurrentVelocity[i]);
 		}
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -3987,7 +4077,10 @@ int __stdcall KillAll (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "KillAll ()");
@@ -3999,8 +4092,6 @@ int __stdcall KillAll (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4024,7 +4115,10 @@ int __stdcall PositionerAnalogTrackingPositionParametersGet (int SocketIndex, ch
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerAnalogTrackingPositionParametersGet (%s,char *,double *,double *,double *,double *)", PositionerName);
@@ -4061,8 +4155,6 @@ int __stdcall PositionerAnalogTrackingPositionParametersGet (int SocketIndex, ch
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Acceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4086,7 +4178,10 @@ int __stdcall PositionerAnalogTrackingPositionParametersSet (int SocketIndex, ch
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerAnalogTrackingPositionParametersSet (%s,%s,%.13g,%.13g,%.13g,%.13g)", PositionerName, GPIOName, Offset, Scale, Velocity, Acceleration);
@@ -4098,8 +4193,6 @@ int __stdcall PositionerAnalogTrackingPositionParametersSet (int SocketIndex, ch
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4125,7 +4218,10 @@ int __stdcall PositionerAnalogTrackingVelocityParametersGet (int SocketIndex, ch
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerAnalogTrackingVelocityParametersGet (%s,char *,double *,double *,double *,int *,double *,double *)", PositionerName);
@@ -4168,8 +4264,6 @@ int __stdcall PositionerAnalogTrackingVelocityParametersGet (int SocketIndex, ch
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Acceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4195,7 +4289,10 @@ int __stdcall PositionerAnalogTrackingVelocityParametersSet (int SocketIndex, ch
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerAnalogTrackingVelocityParametersSet (%s,%s,%.13g,%.13g,%.13g,%d,%.13g,%.13g)", PositionerName, GPIOName, Offset, Scale, DeadBandThreshold, Order, Velocity, Acceleration);
@@ -4207,8 +4304,6 @@ int __stdcall PositionerAnalogTrackingVelocityParametersSet (int SocketIndex, ch
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4229,7 +4324,10 @@ int __stdcall PositionerBacklashGet (int SocketIndex, char * PositionerName, dou
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerBacklashGet (%s,double *,char *)", PositionerName);
@@ -4257,8 +4355,6 @@ int __stdcall PositionerBacklashGet (int SocketIndex, char * PositionerName, dou
 		ptNext = strchr (BacklaskStatus, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4278,7 +4374,10 @@ int __stdcall PositionerBacklashSet (int SocketIndex, char * PositionerName, dou
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerBacklashSet (%s,%.13g)", PositionerName, BacklashValue);
@@ -4290,8 +4389,6 @@ int __stdcall PositionerBacklashSet (int SocketIndex, char * PositionerName, dou
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4310,7 +4407,10 @@ int __stdcall PositionerBacklashEnable (int SocketIndex, char * PositionerName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerBacklashEnable (%s)", PositionerName);
@@ -4322,8 +4422,6 @@ int __stdcall PositionerBacklashEnable (int SocketIndex, char * PositionerName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4342,7 +4440,10 @@ int __stdcall PositionerBacklashDisable (int SocketIndex, char * PositionerName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerBacklashDisable (%s)", PositionerName);
@@ -4354,8 +4455,6 @@ int __stdcall PositionerBacklashDisable (int SocketIndex, char * PositionerName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4380,7 +4479,10 @@ int __stdcall PositionerCorrectorNotchFiltersSet (int SocketIndex, char * Positi
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorNotchFiltersSet (%s,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g)", PositionerName, NotchFrequency1, NotchBandwith1, NotchGain1, NotchFrequency2, NotchBandwith2, NotchGain2);
@@ -4392,8 +4494,6 @@ int __stdcall PositionerCorrectorNotchFiltersSet (int SocketIndex, char * Positi
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4418,7 +4518,10 @@ int __stdcall PositionerCorrectorNotchFiltersGet (int SocketIndex, char * Positi
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorNotchFiltersGet (%s,double *,double *,double *,double *,double *,double *)", PositionerName);
@@ -4454,8 +4557,6 @@ int __stdcall PositionerCorrectorNotchFiltersGet (int SocketIndex, char * Positi
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", NotchGain2);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4486,7 +4587,10 @@ int __stdcall PositionerCorrectorPIDFFAccelerationSet (int SocketIndex, char * P
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIDFFAccelerationSet (%s,%d,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g)", PositionerName, ClosedLoopStatus, KP, KI, KD, KS, IntegrationTime, DerivativeFilterCutOffFrequency, GKP, GKI, GKD, KForm, FeedForwardGainAcceleration);
@@ -4498,8 +4602,6 @@ int __stdcall PositionerCorrectorPIDFFAccelerationSet (int SocketIndex, char * P
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4530,9 +4632,12 @@ int __stdcall PositionerCorrectorPIDFFAccelerationGet (int SocketIndex, char * P
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
 	int boolScanTmp = 0;
 
+	if (ReturnedValue == NULL) 
+		return (ret); 
+
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIDFFAccelerationGet (%s,bool *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *)", PositionerName);
 
@@ -4586,8 +4691,6 @@ int __stdcall PositionerCorrectorPIDFFAccelerationGet (int SocketIndex, char * P
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", FeedForwardGainAcceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4618,7 +4721,10 @@ int __stdcall PositionerCorrectorPIDFFVelocitySet (int SocketIndex, char * Posit
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIDFFVelocitySet (%s,%d,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g)", PositionerName, ClosedLoopStatus, KP, KI, KD, KS, IntegrationTime, DerivativeFilterCutOffFrequency, GKP, GKI, GKD, KForm, FeedForwardGainVelocity);
@@ -4630,8 +4736,6 @@ int __stdcall PositionerCorrectorPIDFFVelocitySet (int SocketIndex, char * Posit
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4662,9 +4766,12 @@ int __stdcall PositionerCorrectorPIDFFVelocityGet (int SocketIndex, char * Posit
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
 	int boolScanTmp = 0;
 
+	if (ReturnedValue == NULL) 
+		return (ret); 
+
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIDFFVelocityGet (%s,bool *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *)", PositionerName);
 
@@ -4718,8 +4825,6 @@ int __stdcall PositionerCorrectorPIDFFVelocityGet (int SocketIndex, char * Posit
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", FeedForwardGainVelocity);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4752,7 +4857,10 @@ int __stdcall PositionerCorrectorPIDDualFFVoltageSet (int SocketIndex, char * Po
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIDDualFFVoltageSet (%s,%d,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g,%.13g)", PositionerName, ClosedLoopStatus, KP, KI, KD, KS, IntegrationTime, DerivativeFilterCutOffFrequency, GKP, GKI, GKD, KForm, FeedForwardGainVelocity, FeedForwardGainAcceleration, Friction);
@@ -4764,8 +4872,6 @@ int __stdcall PositionerCorrectorPIDDualFFVoltageSet (int SocketIndex, char * Po
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4798,9 +4904,12 @@ int __stdcall PositionerCorrectorPIDDualFFVoltageGet (int SocketIndex, char * Po
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
 	int boolScanTmp;
 
+	if (ReturnedValue == NULL) 
+		return (ret); 
+
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIDDualFFVoltageGet (%s,bool *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *,double *)", PositionerName);
 
@@ -4860,8 +4969,6 @@ int __stdcall PositionerCorrectorPIDDualFFVoltageGet (int SocketIndex, char * Po
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Friction);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4884,7 +4991,10 @@ int __stdcall PositionerCorrectorPIPositionSet (int SocketIndex, char * Position
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIPositionSet (%s,%d,%.13g,%.13g,%.13g)", PositionerName, ClosedLoopStatus, KP, KI, IntegrationTime);
@@ -4896,8 +5006,6 @@ int __stdcall PositionerCorrectorPIPositionSet (int SocketIndex, char * Position
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4920,9 +5028,12 @@ int __stdcall PositionerCorrectorPIPositionGet (int SocketIndex, char * Position
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
 	int boolScanTmp;
 
+	if (ReturnedValue == NULL) 
+		return (ret); 
+
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorPIPositionGet (%s,bool *,double *,double *,double *)", PositionerName);
 
@@ -4952,8 +5063,6 @@ int __stdcall PositionerCorrectorPIPositionGet (int SocketIndex, char * Position
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", IntegrationTime);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -4973,7 +5082,10 @@ int __stdcall PositionerCorrectorTypeGet (int SocketIndex, char * PositionerName
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorTypeGet (%s,char *)", PositionerName);
@@ -4998,8 +5110,6 @@ int __stdcall PositionerCorrectorTypeGet (int SocketIndex, char * PositionerName
 		ptNext = strchr (CorrectorType, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5020,7 +5130,10 @@ int __stdcall PositionerCurrentVelocityAccelerationFiltersGet (int SocketIndex,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCurrentVelocityAccelerationFiltersGet (%s,double *,double *)", PositionerName);
@@ -5044,8 +5157,6 @@ int __stdcall PositionerCurrentVelocityAccelerationFiltersGet (int SocketIndex,
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", CurrentAccelerationCutOffFrequency);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5066,7 +5177,10 @@ int __stdcall PositionerCurrentVelocityAccelerationFiltersSet (int SocketIndex,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCurrentVelocityAccelerationFiltersSet (%s,%.13g,%.13g)", PositionerName, CurrentVelocityCutOffFrequency, CurrentAccelerationCutOffFrequency);
@@ -5078,8 +5192,6 @@ int __stdcall PositionerCurrentVelocityAccelerationFiltersSet (int SocketIndex,
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5103,7 +5215,10 @@ int __stdcall PositionerDriverFiltersGet (int SocketIndex, char * PositionerName
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDriverFiltersGet (%s,double *,double *,double *,double *,double *)", PositionerName);
@@ -5136,8 +5251,6 @@ int __stdcall PositionerDriverFiltersGet (int SocketIndex, char * PositionerName
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", LowpassFrequency);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5161,7 +5274,10 @@ int __stdcall PositionerDriverFiltersSet (int SocketIndex, char * PositionerName
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDriverFiltersSet (%s,%.13g,%.13g,%.13g,%.13g,%.13g)", PositionerName, KI, NotchFrequency, NotchBandwidth, NotchGain, LowpassFrequency);
@@ -5173,8 +5289,6 @@ int __stdcall PositionerDriverFiltersSet (int SocketIndex, char * PositionerName
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5195,7 +5309,10 @@ int __stdcall PositionerDriverPositionOffsetsGet (int SocketIndex, char * Positi
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDriverPositionOffsetsGet (%s,double *,double *)", PositionerName);
@@ -5219,8 +5336,6 @@ int __stdcall PositionerDriverPositionOffsetsGet (int SocketIndex, char * Positi
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", GagePositionOffset);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5240,7 +5355,10 @@ int __stdcall PositionerDriverStatusGet (int SocketIndex, char * PositionerName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDriverStatusGet (%s,int *)", PositionerName);
@@ -5261,8 +5379,6 @@ int __stdcall PositionerDriverStatusGet (int SocketIndex, char * PositionerName,
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", DriverStatus);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5282,7 +5398,10 @@ int __stdcall PositionerDriverStatusStringGet (int SocketIndex, int PositionerDr
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDriverStatusStringGet (%d,char *)", PositionerDriverStatus);
@@ -5307,8 +5426,6 @@ int __stdcall PositionerDriverStatusStringGet (int SocketIndex, int PositionerDr
 		ptNext = strchr (PositionerDriverStatusString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5331,7 +5448,10 @@ int __stdcall PositionerEncoderAmplitudeValuesGet (int SocketIndex, char * Posit
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerEncoderAmplitudeValuesGet (%s,double *,double *,double *,double *)", PositionerName);
@@ -5361,8 +5481,6 @@ int __stdcall PositionerEncoderAmplitudeValuesGet (int SocketIndex, char * Posit
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", CurrentCosinusAmplitude);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5385,7 +5503,10 @@ int __stdcall PositionerEncoderCalibrationParametersGet (int SocketIndex, char *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerEncoderCalibrationParametersGet (%s,double *,double *,double *,double *)", PositionerName);
@@ -5415,8 +5536,6 @@ int __stdcall PositionerEncoderCalibrationParametersGet (int SocketIndex, char *
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", PhaseCompensation);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5436,7 +5555,10 @@ int __stdcall PositionerErrorGet (int SocketIndex, char * PositionerName, int *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerErrorGet (%s,int *)", PositionerName);
@@ -5457,8 +5579,6 @@ int __stdcall PositionerErrorGet (int SocketIndex, char * PositionerName, int *
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", ErrorCode);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5478,7 +5598,10 @@ int __stdcall PositionerErrorRead (int SocketIndex, char * PositionerName, int *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerErrorRead (%s,int *)", PositionerName);
@@ -5499,8 +5622,6 @@ int __stdcall PositionerErrorRead (int SocketIndex, char * PositionerName, int *
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", ErrorCode);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5520,7 +5641,10 @@ int __stdcall PositionerErrorStringGet (int SocketIndex, int PositionerErrorCode
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerErrorStringGet (%d,char *)", PositionerErrorCode);
@@ -5545,8 +5669,6 @@ int __stdcall PositionerErrorStringGet (int SocketIndex, int PositionerErrorCode
 		ptNext = strchr (PositionerErrorString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5569,7 +5691,10 @@ int __stdcall PositionerExcitationSignalGet (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerExcitationSignalGet (%s,int *,double *,double *,double *)", PositionerName);
@@ -5599,8 +5724,6 @@ int __stdcall PositionerExcitationSignalGet (int SocketIndex, char * PositionerN
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Time);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5623,7 +5746,10 @@ int __stdcall PositionerExcitationSignalSet (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerExcitationSignalSet (%s,%d,%.13g,%.13g,%.13g)", PositionerName, Mode, Frequency, Amplitude, Time);
@@ -5635,8 +5761,6 @@ int __stdcall PositionerExcitationSignalSet (int SocketIndex, char * PositionerN
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5656,7 +5780,10 @@ int __stdcall PositionerExternalLatchPositionGet (int SocketIndex, char * Positi
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerExternalLatchPositionGet (%s,double *)", PositionerName);
@@ -5677,8 +5804,6 @@ int __stdcall PositionerExternalLatchPositionGet (int SocketIndex, char * Positi
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Position);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5698,7 +5823,10 @@ int __stdcall PositionerHardwareStatusGet (int SocketIndex, char * PositionerNam
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerHardwareStatusGet (%s,int *)", PositionerName);
@@ -5719,8 +5847,6 @@ int __stdcall PositionerHardwareStatusGet (int SocketIndex, char * PositionerNam
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", HardwareStatus);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5740,7 +5866,10 @@ int __stdcall PositionerHardwareStatusStringGet (int SocketIndex, int Positioner
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerHardwareStatusStringGet (%d,char *)", PositionerHardwareStatus);
@@ -5765,8 +5894,6 @@ int __stdcall PositionerHardwareStatusStringGet (int SocketIndex, int Positioner
 		ptNext = strchr (PositionerHardwareStatusString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5786,7 +5913,10 @@ int __stdcall PositionerHardInterpolatorFactorGet (int SocketIndex, char * Posit
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerHardInterpolatorFactorGet (%s,int *)", PositionerName);
@@ -5807,8 +5937,6 @@ int __stdcall PositionerHardInterpolatorFactorGet (int SocketIndex, char * Posit
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", InterpolationFactor);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5828,7 +5956,10 @@ int __stdcall PositionerHardInterpolatorFactorSet (int SocketIndex, char * Posit
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerHardInterpolatorFactorSet (%s,%d)", PositionerName, InterpolationFactor);
@@ -5840,8 +5971,6 @@ int __stdcall PositionerHardInterpolatorFactorSet (int SocketIndex, char * Posit
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5862,7 +5991,10 @@ int __stdcall PositionerMaximumVelocityAndAccelerationGet (int SocketIndex, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerMaximumVelocityAndAccelerationGet (%s,double *,double *)", PositionerName);
@@ -5886,8 +6018,6 @@ int __stdcall PositionerMaximumVelocityAndAccelerationGet (int SocketIndex, char
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", MaximumAcceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5911,7 +6041,10 @@ int __stdcall PositionerMotionDoneGet (int SocketIndex, char * PositionerName, d
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerMotionDoneGet (%s,double *,double *,double *,double *,double *)", PositionerName);
@@ -5944,8 +6077,6 @@ int __stdcall PositionerMotionDoneGet (int SocketIndex, char * PositionerName, d
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", TimeOut);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -5969,7 +6100,10 @@ int __stdcall PositionerMotionDoneSet (int SocketIndex, char * PositionerName, d
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerMotionDoneSet (%s,%.13g,%.13g,%.13g,%.13g,%.13g)", PositionerName, PositionWindow, VelocityWindow, CheckingTime, MeanPeriod, TimeOut);
@@ -5981,8 +6115,6 @@ int __stdcall PositionerMotionDoneSet (int SocketIndex, char * PositionerName, d
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6001,7 +6133,10 @@ int __stdcall PositionerPositionCompareAquadBAlwaysEnable (int SocketIndex, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionCompareAquadBAlwaysEnable (%s)", PositionerName);
@@ -6013,8 +6148,6 @@ int __stdcall PositionerPositionCompareAquadBAlwaysEnable (int SocketIndex, char
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6036,9 +6169,12 @@ int __stdcall PositionerPositionCompareAquadBWindowedGet (int SocketIndex, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
 	int boolScanTmp;
 
+	if (ReturnedValue == NULL) 
+		return (ret); 
+
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionCompareAquadBWindowedGet (%s,double *,double *,bool *)", PositionerName);
 
@@ -6065,8 +6201,6 @@ int __stdcall PositionerPositionCompareAquadBWindowedGet (int SocketIndex, char
 		if (pt != NULL) sscanf (pt, "%d", &boolScanTmp);
 		*EnableState = (bool) boolScanTmp;
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6087,7 +6221,10 @@ int __stdcall PositionerPositionCompareAquadBWindowedSet (int SocketIndex, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionCompareAquadBWindowedSet (%s,%.13g,%.13g)", PositionerName, MinimumPosition, MaximumPosition);
@@ -6099,8 +6236,6 @@ int __stdcall PositionerPositionCompareAquadBWindowedSet (int SocketIndex, char
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6123,9 +6258,12 @@ int __stdcall PositionerPositionCompareGet (int SocketIndex, char * PositionerNa
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
 	int boolScanTmp;
 
+	if (ReturnedValue == NULL) 
+		return (ret); 
+
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionCompareGet (%s,double *,double *,double *,bool *)", PositionerName);
 
@@ -6155,8 +6293,6 @@ int __stdcall PositionerPositionCompareGet (int SocketIndex, char * PositionerNa
 		if (pt != NULL) sscanf (pt, "%d", &boolScanTmp);
 		*EnableState = (bool) boolScanTmp;
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6178,7 +6314,10 @@ int __stdcall PositionerPositionCompareSet (int SocketIndex, char * PositionerNa
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionCompareSet (%s,%.13g,%.13g,%.13g)", PositionerName, MinimumPosition, MaximumPosition, PositionStep);
@@ -6190,8 +6329,6 @@ int __stdcall PositionerPositionCompareSet (int SocketIndex, char * PositionerNa
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6210,7 +6347,10 @@ int __stdcall PositionerPositionCompareEnable (int SocketIndex, char * Positione
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionCompareEnable (%s)", PositionerName);
@@ -6222,8 +6362,6 @@ int __stdcall PositionerPositionCompareEnable (int SocketIndex, char * Positione
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6242,7 +6380,10 @@ int __stdcall PositionerPositionCompareDisable (int SocketIndex, char * Position
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionCompareDisable (%s)", PositionerName);
@@ -6254,8 +6395,6 @@ int __stdcall PositionerPositionCompareDisable (int SocketIndex, char * Position
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6276,7 +6415,10 @@ int __stdcall PositionerPositionComparePulseParametersGet (int SocketIndex, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionComparePulseParametersGet (%s,double *,double *)", PositionerName);
@@ -6300,8 +6442,6 @@ int __stdcall PositionerPositionComparePulseParametersGet (int SocketIndex, char
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", EncoderSettlingTime);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6322,7 +6462,10 @@ int __stdcall PositionerPositionComparePulseParametersSet (int SocketIndex, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerPositionComparePulseParametersSet (%s,%.13g,%.13g)", PositionerName, PCOPulseWidth, EncoderSettlingTime);
@@ -6334,8 +6477,6 @@ int __stdcall PositionerPositionComparePulseParametersSet (int SocketIndex, char
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6356,7 +6497,10 @@ int __stdcall PositionerRawEncoderPositionGet (int SocketIndex, char * Positione
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerRawEncoderPositionGet (%s,%.13g,double *)", PositionerName, UserEncoderPosition);
@@ -6377,8 +6521,6 @@ int __stdcall PositionerRawEncoderPositionGet (int SocketIndex, char * Positione
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", RawEncoderPosition);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6398,7 +6540,10 @@ int __stdcall PositionersEncoderIndexDifferenceGet (int SocketIndex, char * Posi
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionersEncoderIndexDifferenceGet (%s,double *)", PositionerName);
@@ -6419,8 +6564,6 @@ int __stdcall PositionersEncoderIndexDifferenceGet (int SocketIndex, char * Posi
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", distance);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6441,7 +6584,10 @@ int __stdcall PositionerSGammaExactVelocityAjustedDisplacementGet (int SocketInd
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerSGammaExactVelocityAjustedDisplacementGet (%s,%.13g,double *)", PositionerName, DesiredDisplacement);
@@ -6462,8 +6608,6 @@ int __stdcall PositionerSGammaExactVelocityAjustedDisplacementGet (int SocketInd
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", AdjustedDisplacement);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6486,7 +6630,10 @@ int __stdcall PositionerSGammaParametersGet (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerSGammaParametersGet (%s,double *,double *,double *,double *)", PositionerName);
@@ -6516,8 +6663,6 @@ int __stdcall PositionerSGammaParametersGet (int SocketIndex, char * PositionerN
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", MaximumTjerkTime);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6540,7 +6685,10 @@ int __stdcall PositionerSGammaParametersSet (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerSGammaParametersSet (%s,%.13g,%.13g,%.13g,%.13g)", PositionerName, Velocity, Acceleration, MinimumTjerkTime, MaximumTjerkTime);
@@ -6552,8 +6700,6 @@ int __stdcall PositionerSGammaParametersSet (int SocketIndex, char * PositionerN
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6574,7 +6720,10 @@ int __stdcall PositionerSGammaPreviousMotionTimesGet (int SocketIndex, char * Po
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerSGammaPreviousMotionTimesGet (%s,double *,double *)", PositionerName);
@@ -6598,8 +6747,6 @@ int __stdcall PositionerSGammaPreviousMotionTimesGet (int SocketIndex, char * Po
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", SettlingTime);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6620,7 +6767,10 @@ int __stdcall PositionerStageParameterGet (int SocketIndex, char * PositionerNam
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerStageParameterGet (%s,%s,char *)", PositionerName, ParameterName);
@@ -6645,8 +6795,6 @@ int __stdcall PositionerStageParameterGet (int SocketIndex, char * PositionerNam
 		ptNext = strchr (ParameterValue, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6667,7 +6815,10 @@ int __stdcall PositionerStageParameterSet (int SocketIndex, char * PositionerNam
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerStageParameterSet (%s,%s,%s)", PositionerName, ParameterName, ParameterValue);
@@ -6679,8 +6830,6 @@ int __stdcall PositionerStageParameterSet (int SocketIndex, char * PositionerNam
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6703,9 +6852,12 @@ int __stdcall PositionerTimeFlasherGet (int SocketIndex, char * PositionerName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
 	int boolScanTmp;
 
+	if (ReturnedValue == NULL) 
+		return (ret); 
+
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerTimeFlasherGet (%s,double *,double *,double *,bool *)", PositionerName);
 
@@ -6735,8 +6887,6 @@ int __stdcall PositionerTimeFlasherGet (int SocketIndex, char * PositionerName,
 		if (pt != NULL) sscanf (pt, "%d", &boolScanTmp);
 		*EnableState = (bool) boolScanTmp;
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6758,7 +6908,10 @@ int __stdcall PositionerTimeFlasherSet (int SocketIndex, char * PositionerName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerTimeFlasherSet (%s,%.13g,%.13g,%.13g)", PositionerName, MinimumPosition, MaximumPosition, TimeInterval);
@@ -6770,8 +6923,6 @@ int __stdcall PositionerTimeFlasherSet (int SocketIndex, char * PositionerName,
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6790,7 +6941,10 @@ int __stdcall PositionerTimeFlasherEnable (int SocketIndex, char * PositionerNam
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerTimeFlasherEnable (%s)", PositionerName);
@@ -6802,8 +6956,6 @@ int __stdcall PositionerTimeFlasherEnable (int SocketIndex, char * PositionerNam
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6822,7 +6974,10 @@ int __stdcall PositionerTimeFlasherDisable (int SocketIndex, char * PositionerNa
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerTimeFlasherDisable (%s)", PositionerName);
@@ -6834,8 +6989,6 @@ int __stdcall PositionerTimeFlasherDisable (int SocketIndex, char * PositionerNa
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6856,7 +7009,10 @@ int __stdcall PositionerUserTravelLimitsGet (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerUserTravelLimitsGet (%s,double *,double *)", PositionerName);
@@ -6880,8 +7036,6 @@ int __stdcall PositionerUserTravelLimitsGet (int SocketIndex, char * PositionerN
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", UserMaximumTarget);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6902,7 +7056,10 @@ int __stdcall PositionerUserTravelLimitsSet (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerUserTravelLimitsSet (%s,%.13g,%.13g)", PositionerName, UserMinimumTarget, UserMaximumTarget);
@@ -6914,8 +7071,6 @@ int __stdcall PositionerUserTravelLimitsSet (int SocketIndex, char * PositionerN
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6936,7 +7091,10 @@ int __stdcall PositionerDACOffsetGet (int SocketIndex, char * PositionerName, sh
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDACOffsetGet (%s,short *,short *)", PositionerName);
@@ -6960,8 +7118,6 @@ int __stdcall PositionerDACOffsetGet (int SocketIndex, char * PositionerName, sh
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%hd", DACOffset2);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -6982,7 +7138,10 @@ int __stdcall PositionerDACOffsetSet (int SocketIndex, char * PositionerName, sh
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDACOffsetSet (%s,%d,%d)", PositionerName, DACOffset1, DACOffset2);
@@ -6994,8 +7153,6 @@ int __stdcall PositionerDACOffsetSet (int SocketIndex, char * PositionerName, sh
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7018,7 +7175,10 @@ int __stdcall PositionerDACOffsetDualGet (int SocketIndex, char * PositionerName
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDACOffsetDualGet (%s,short *,short *,short *,short *)", PositionerName);
@@ -7048,8 +7208,6 @@ int __stdcall PositionerDACOffsetDualGet (int SocketIndex, char * PositionerName
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%hd", SecondaryDACOffset2);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7072,7 +7230,10 @@ int __stdcall PositionerDACOffsetDualSet (int SocketIndex, char * PositionerName
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDACOffsetDualSet (%s,%d,%d,%d,%d)", PositionerName, PrimaryDACOffset1, PrimaryDACOffset2, SecondaryDACOffset1, SecondaryDACOffset2);
@@ -7084,8 +7245,6 @@ int __stdcall PositionerDACOffsetDualSet (int SocketIndex, char * PositionerName
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7108,7 +7267,10 @@ int __stdcall PositionerCorrectorAutoTuning (int SocketIndex, char * PositionerN
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerCorrectorAutoTuning (%s,%d,double *,double *,double *)", PositionerName, TuningMode);
@@ -7135,8 +7297,6 @@ int __stdcall PositionerCorrectorAutoTuning (int SocketIndex, char * PositionerN
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", KD);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7156,7 +7316,10 @@ int __stdcall PositionerAccelerationAutoScaling (int SocketIndex, char * Positio
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerAccelerationAutoScaling (%s,double *)", PositionerName);
@@ -7177,8 +7340,6 @@ int __stdcall PositionerAccelerationAutoScaling (int SocketIndex, char * Positio
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Scaling);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7198,7 +7359,10 @@ int __stdcall MultipleAxesPVTVerification (int SocketIndex, char * GroupName, ch
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "MultipleAxesPVTVerification (%s,%s)", GroupName, TrajectoryFileName);
@@ -7210,8 +7374,6 @@ int __stdcall MultipleAxesPVTVerification (int SocketIndex, char * GroupName, ch
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7235,7 +7397,10 @@ int __stdcall MultipleAxesPVTVerificationResultGet (int SocketIndex, char * Posi
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "MultipleAxesPVTVerificationResultGet (%s,char *,double *,double *,double *,double *)", PositionerName);
@@ -7272,8 +7437,6 @@ int __stdcall MultipleAxesPVTVerificationResultGet (int SocketIndex, char * Posi
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", MaximumAcceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7294,7 +7457,10 @@ int __stdcall MultipleAxesPVTExecution (int SocketIndex, char * GroupName, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "MultipleAxesPVTExecution (%s,%s,%d)", GroupName, TrajectoryFileName, ExecutionNumber);
@@ -7306,8 +7472,6 @@ int __stdcall MultipleAxesPVTExecution (int SocketIndex, char * GroupName, char
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7328,7 +7492,10 @@ int __stdcall MultipleAxesPVTParametersGet (int SocketIndex, char * GroupName, c
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "MultipleAxesPVTParametersGet (%s,char *,int *)", GroupName);
@@ -7356,8 +7523,6 @@ int __stdcall MultipleAxesPVTParametersGet (int SocketIndex, char * GroupName, c
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", CurrentElementNumber);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7379,7 +7544,10 @@ int __stdcall MultipleAxesPVTPulseOutputSet (int SocketIndex, char * GroupName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "MultipleAxesPVTPulseOutputSet (%s,%d,%d,%.13g)", GroupName, StartElement, EndElement, TimeInterval);
@@ -7391,8 +7559,6 @@ int __stdcall MultipleAxesPVTPulseOutputSet (int SocketIndex, char * GroupName,
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7414,7 +7580,10 @@ int __stdcall MultipleAxesPVTPulseOutputGet (int SocketIndex, char * GroupName,
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "MultipleAxesPVTPulseOutputGet (%s,int *,int *,double *)", GroupName);
@@ -7441,8 +7610,6 @@ int __stdcall MultipleAxesPVTPulseOutputGet (int SocketIndex, char * GroupName,
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", TimeInterval);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7461,7 +7628,10 @@ int __stdcall SingleAxisSlaveModeEnable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SingleAxisSlaveModeEnable (%s)", GroupName);
@@ -7473,8 +7643,6 @@ int __stdcall SingleAxisSlaveModeEnable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7493,7 +7661,10 @@ int __stdcall SingleAxisSlaveModeDisable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SingleAxisSlaveModeDisable (%s)", GroupName);
@@ -7505,8 +7676,6 @@ int __stdcall SingleAxisSlaveModeDisable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7527,7 +7696,10 @@ int __stdcall SingleAxisSlaveParametersSet (int SocketIndex, char * GroupName, c
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SingleAxisSlaveParametersSet (%s,%s,%.13g)", GroupName, PositionerName, Ratio);
@@ -7539,8 +7711,6 @@ int __stdcall SingleAxisSlaveParametersSet (int SocketIndex, char * GroupName, c
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7561,7 +7731,10 @@ int __stdcall SingleAxisSlaveParametersGet (int SocketIndex, char * GroupName, c
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SingleAxisSlaveParametersGet (%s,char *,double *)", GroupName);
@@ -7589,8 +7762,6 @@ int __stdcall SingleAxisSlaveParametersGet (int SocketIndex, char * GroupName, c
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Ratio);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7609,7 +7780,10 @@ int __stdcall SpindleSlaveModeEnable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SpindleSlaveModeEnable (%s)", GroupName);
@@ -7621,8 +7795,6 @@ int __stdcall SpindleSlaveModeEnable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7641,7 +7813,10 @@ int __stdcall SpindleSlaveModeDisable (int SocketIndex, char * GroupName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SpindleSlaveModeDisable (%s)", GroupName);
@@ -7653,8 +7828,6 @@ int __stdcall SpindleSlaveModeDisable (int SocketIndex, char * GroupName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7675,7 +7848,10 @@ int __stdcall SpindleSlaveParametersSet (int SocketIndex, char * GroupName, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SpindleSlaveParametersSet (%s,%s,%.13g)", GroupName, PositionerName, Ratio);
@@ -7687,8 +7863,6 @@ int __stdcall SpindleSlaveParametersSet (int SocketIndex, char * GroupName, char
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7709,7 +7883,10 @@ int __stdcall SpindleSlaveParametersGet (int SocketIndex, char * GroupName, char
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SpindleSlaveParametersGet (%s,char *,double *)", GroupName);
@@ -7737,8 +7914,6 @@ int __stdcall SpindleSlaveParametersGet (int SocketIndex, char * GroupName, char
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Ratio);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7759,7 +7934,10 @@ int __stdcall GroupSpinParametersSet (int SocketIndex, char * GroupName, double
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupSpinParametersSet (%s,%.13g,%.13g)", GroupName, Velocity, Acceleration);
@@ -7771,8 +7949,6 @@ int __stdcall GroupSpinParametersSet (int SocketIndex, char * GroupName, double
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7793,7 +7969,10 @@ int __stdcall GroupSpinParametersGet (int SocketIndex, char * GroupName, double
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupSpinParametersGet (%s,double *,double *)", GroupName);
@@ -7817,8 +7996,6 @@ int __stdcall GroupSpinParametersGet (int SocketIndex, char * GroupName, double
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Acceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7839,7 +8016,10 @@ int __stdcall GroupSpinCurrentGet (int SocketIndex, char * GroupName, double * V
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupSpinCurrentGet (%s,double *,double *)", GroupName);
@@ -7863,8 +8043,6 @@ int __stdcall GroupSpinCurrentGet (int SocketIndex, char * GroupName, double * V
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", Acceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7884,7 +8062,10 @@ int __stdcall GroupSpinModeStop (int SocketIndex, char * GroupName, double Accel
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupSpinModeStop (%s,%.13g)", GroupName, Acceleration);
@@ -7896,8 +8077,6 @@ int __stdcall GroupSpinModeStop (int SocketIndex, char * GroupName, double Accel
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7917,7 +8096,10 @@ int __stdcall XYLineArcVerification (int SocketIndex, char * GroupName, char * T
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYLineArcVerification (%s,%s)", GroupName, TrajectoryFileName);
@@ -7929,8 +8111,6 @@ int __stdcall XYLineArcVerification (int SocketIndex, char * GroupName, char * T
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -7954,7 +8134,10 @@ int __stdcall XYLineArcVerificationResultGet (int SocketIndex, char * Positioner
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYLineArcVerificationResultGet (%s,char *,double *,double *,double *,double *)", PositionerName);
@@ -7991,8 +8174,6 @@ int __stdcall XYLineArcVerificationResultGet (int SocketIndex, char * Positioner
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", MaximumAcceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8015,7 +8196,10 @@ int __stdcall XYLineArcExecution (int SocketIndex, char * GroupName, char * Traj
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYLineArcExecution (%s,%s,%.13g,%.13g,%d)", GroupName, TrajectoryFileName, Velocity, Acceleration, ExecutionNumber);
@@ -8027,8 +8211,6 @@ int __stdcall XYLineArcExecution (int SocketIndex, char * GroupName, char * Traj
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8051,7 +8233,10 @@ int __stdcall XYLineArcParametersGet (int SocketIndex, char * GroupName, char *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYLineArcParametersGet (%s,char *,double *,double *,int *)", GroupName);
@@ -8085,8 +8270,6 @@ int __stdcall XYLineArcParametersGet (int SocketIndex, char * GroupName, char *
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", CurrentElementNumber);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8108,7 +8291,10 @@ int __stdcall XYLineArcPulseOutputSet (int SocketIndex, char * GroupName, double
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYLineArcPulseOutputSet (%s,%.13g,%.13g,%.13g)", GroupName, StartLength, EndLength, PathLengthInterval);
@@ -8120,8 +8306,6 @@ int __stdcall XYLineArcPulseOutputSet (int SocketIndex, char * GroupName, double
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8143,7 +8327,10 @@ int __stdcall XYLineArcPulseOutputGet (int SocketIndex, char * GroupName, double
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYLineArcPulseOutputGet (%s,double *,double *,double *)", GroupName);
@@ -8170,8 +8357,6 @@ int __stdcall XYLineArcPulseOutputGet (int SocketIndex, char * GroupName, double
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", PathLengthInterval);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8196,7 +8381,10 @@ int __stdcall XYZGroupPositionCorrectedProfilerGet (int SocketIndex, char * Grou
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYZGroupPositionCorrectedProfilerGet (%s,%.13g,%.13g,%.13g,double *,double *,double *)", GroupName, PositionX, PositionY, PositionZ);
@@ -8223,8 +8411,6 @@ int __stdcall XYZGroupPositionCorrectedProfilerGet (int SocketIndex, char * Grou
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", CorrectedProfilerPositionZ);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8244,7 +8430,10 @@ int __stdcall XYZSplineVerification (int SocketIndex, char * GroupName, char * T
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYZSplineVerification (%s,%s)", GroupName, TrajectoryFileName);
@@ -8256,8 +8445,6 @@ int __stdcall XYZSplineVerification (int SocketIndex, char * GroupName, char * T
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8281,7 +8468,10 @@ int __stdcall XYZSplineVerificationResultGet (int SocketIndex, char * Positioner
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYZSplineVerificationResultGet (%s,char *,double *,double *,double *,double *)", PositionerName);
@@ -8318,8 +8508,6 @@ int __stdcall XYZSplineVerificationResultGet (int SocketIndex, char * Positioner
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", MaximumAcceleration);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8341,7 +8529,10 @@ int __stdcall XYZSplineExecution (int SocketIndex, char * GroupName, char * Traj
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYZSplineExecution (%s,%s,%.13g,%.13g)", GroupName, TrajectoryFileName, Velocity, Acceleration);
@@ -8353,8 +8544,6 @@ int __stdcall XYZSplineExecution (int SocketIndex, char * GroupName, char * Traj
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8377,7 +8566,10 @@ int __stdcall XYZSplineParametersGet (int SocketIndex, char * GroupName, char *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "XYZSplineParametersGet (%s,char *,double *,double *,int *)", GroupName);
@@ -8411,8 +8603,6 @@ int __stdcall XYZSplineParametersGet (int SocketIndex, char * GroupName, char *
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%d", CurrentElementNumber);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8432,7 +8622,10 @@ int __stdcall OptionalModuleExecute (int SocketIndex, char * ModuleFileName, cha
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "OptionalModuleExecute (%s,%s)", ModuleFileName, TaskName);
@@ -8444,8 +8637,6 @@ int __stdcall OptionalModuleExecute (int SocketIndex, char * ModuleFileName, cha
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8464,7 +8655,10 @@ int __stdcall OptionalModuleKill (int SocketIndex, char * TaskName)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "OptionalModuleKill (%s)", TaskName);
@@ -8476,8 +8670,6 @@ int __stdcall OptionalModuleKill (int SocketIndex, char * TaskName)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8497,7 +8689,10 @@ int __stdcall EEPROMCIESet (int SocketIndex, int CardNumber, char * ReferenceStr
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EEPROMCIESet (%d,%s)", CardNumber, ReferenceString);
@@ -8509,8 +8704,6 @@ int __stdcall EEPROMCIESet (int SocketIndex, int CardNumber, char * ReferenceStr
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8531,7 +8724,10 @@ int __stdcall EEPROMDACOffsetCIESet (int SocketIndex, int PlugNumber, double DAC
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EEPROMDACOffsetCIESet (%d,%.13g,%.13g)", PlugNumber, DAC1Offset, DAC2Offset);
@@ -8543,8 +8739,6 @@ int __stdcall EEPROMDACOffsetCIESet (int SocketIndex, int PlugNumber, double DAC
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8564,7 +8758,10 @@ int __stdcall EEPROMDriverSet (int SocketIndex, int PlugNumber, char * Reference
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EEPROMDriverSet (%d,%s)", PlugNumber, ReferenceString);
@@ -8576,8 +8773,6 @@ int __stdcall EEPROMDriverSet (int SocketIndex, int PlugNumber, char * Reference
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8597,7 +8792,10 @@ int __stdcall EEPROMINTSet (int SocketIndex, int CardNumber, char * ReferenceStr
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EEPROMINTSet (%d,%s)", CardNumber, ReferenceString);
@@ -8609,8 +8807,6 @@ int __stdcall EEPROMINTSet (int SocketIndex, int CardNumber, char * ReferenceStr
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8636,7 +8832,10 @@ int __stdcall CPUCoreAndBoardSupplyVoltagesGet (int SocketIndex, double * Voltag
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "CPUCoreAndBoardSupplyVoltagesGet (double *,double *,double *,double *,double *,double *,double *,double *)");
@@ -8678,8 +8877,6 @@ int __stdcall CPUCoreAndBoardSupplyVoltagesGet (int SocketIndex, double * Voltag
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", SupplyVoltage5VSB);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8699,7 +8896,10 @@ int __stdcall CPUTemperatureAndFanSpeedGet (int SocketIndex, double * CPUTempera
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "CPUTemperatureAndFanSpeedGet (double *,double *)");
@@ -8723,8 +8923,6 @@ int __stdcall CPUTemperatureAndFanSpeedGet (int SocketIndex, double * CPUTempera
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", CPUFanSpeed);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8743,7 +8941,10 @@ int __stdcall ActionListGet (int SocketIndex, char * ActionList)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ActionListGet (char *)");
@@ -8768,8 +8969,6 @@ int __stdcall ActionListGet (int SocketIndex, char * ActionList)
 		ptNext = strchr (ActionList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8788,7 +8987,10 @@ int __stdcall ActionExtendedListGet (int SocketIndex, char * ActionList)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ActionExtendedListGet (char *)");
@@ -8813,8 +9015,6 @@ int __stdcall ActionExtendedListGet (int SocketIndex, char * ActionList)
 		ptNext = strchr (ActionList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8833,7 +9033,10 @@ int __stdcall APIExtendedListGet (int SocketIndex, char * Method)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "APIExtendedListGet (char *)");
@@ -8858,8 +9061,6 @@ int __stdcall APIExtendedListGet (int SocketIndex, char * Method)
 		ptNext = strchr (Method, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8878,7 +9079,10 @@ int __stdcall APIListGet (int SocketIndex, char * Method)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "APIListGet (char *)");
@@ -8903,8 +9107,6 @@ int __stdcall APIListGet (int SocketIndex, char * Method)
 		ptNext = strchr (Method, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8923,7 +9125,10 @@ int __stdcall ControllerStatusListGet (int SocketIndex, char * ControllerStatusL
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ControllerStatusListGet (char *)");
@@ -8948,8 +9153,6 @@ int __stdcall ControllerStatusListGet (int SocketIndex, char * ControllerStatusL
 		ptNext = strchr (ControllerStatusList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -8968,7 +9171,10 @@ int __stdcall ErrorListGet (int SocketIndex, char * ErrorsList)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ErrorListGet (char *)");
@@ -8993,8 +9199,6 @@ int __stdcall ErrorListGet (int SocketIndex, char * ErrorsList)
 		ptNext = strchr (ErrorsList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9013,7 +9217,10 @@ int __stdcall EventListGet (int SocketIndex, char * EventList)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "EventListGet (char *)");
@@ -9038,8 +9245,6 @@ int __stdcall EventListGet (int SocketIndex, char * EventList)
 		ptNext = strchr (EventList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9058,7 +9263,10 @@ int __stdcall GatheringListGet (int SocketIndex, char * list)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringListGet (char *)");
@@ -9083,8 +9291,6 @@ int __stdcall GatheringListGet (int SocketIndex, char * list)
 		ptNext = strchr (list, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9103,7 +9309,10 @@ int __stdcall GatheringExtendedListGet (int SocketIndex, char * list)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringExtendedListGet (char *)");
@@ -9128,8 +9337,6 @@ int __stdcall GatheringExtendedListGet (int SocketIndex, char * list)
 		ptNext = strchr (list, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9148,7 +9355,10 @@ int __stdcall GatheringExternalListGet (int SocketIndex, char * list)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringExternalListGet (char *)");
@@ -9173,8 +9383,6 @@ int __stdcall GatheringExternalListGet (int SocketIndex, char * list)
 		ptNext = strchr (list, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9193,7 +9401,10 @@ int __stdcall GroupStatusListGet (int SocketIndex, char * GroupStatusList)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GroupStatusListGet (char *)");
@@ -9218,8 +9429,6 @@ int __stdcall GroupStatusListGet (int SocketIndex, char * GroupStatusList)
 		ptNext = strchr (GroupStatusList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9238,7 +9447,10 @@ int __stdcall HardwareInternalListGet (int SocketIndex, char * InternalHardwareL
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "HardwareInternalListGet (char *)");
@@ -9263,8 +9475,6 @@ int __stdcall HardwareInternalListGet (int SocketIndex, char * InternalHardwareL
 		ptNext = strchr (InternalHardwareList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9285,7 +9495,10 @@ int __stdcall HardwareDriverAndStageGet (int SocketIndex, int PlugNumber, char *
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_NOMINAL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_NOMINAL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "HardwareDriverAndStageGet (%d,char *,char *)", PlugNumber);
@@ -9315,8 +9528,6 @@ int __stdcall HardwareDriverAndStageGet (int SocketIndex, int PlugNumber, char *
 		ptNext = strchr (StageName, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9335,7 +9546,10 @@ int __stdcall ObjectsListGet (int SocketIndex, char * ObjectsList)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_HUGE); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_HUGE); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ObjectsListGet (char *)");
@@ -9360,8 +9574,6 @@ int __stdcall ObjectsListGet (int SocketIndex, char * ObjectsList)
 		ptNext = strchr (ObjectsList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9380,7 +9592,10 @@ int __stdcall PositionerErrorListGet (int SocketIndex, char * PositionerErrorLis
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerErrorListGet (char *)");
@@ -9405,8 +9620,6 @@ int __stdcall PositionerErrorListGet (int SocketIndex, char * PositionerErrorLis
 		ptNext = strchr (PositionerErrorList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9425,7 +9638,10 @@ int __stdcall PositionerHardwareStatusListGet (int SocketIndex, char * Positione
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerHardwareStatusListGet (char *)");
@@ -9450,8 +9666,6 @@ int __stdcall PositionerHardwareStatusListGet (int SocketIndex, char * Positione
 		ptNext = strchr (PositionerHardwareStatusList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9470,7 +9684,10 @@ int __stdcall PositionerDriverStatusListGet (int SocketIndex, char * PositionerD
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "PositionerDriverStatusListGet (char *)");
@@ -9495,8 +9712,6 @@ int __stdcall PositionerDriverStatusListGet (int SocketIndex, char * PositionerD
 		ptNext = strchr (PositionerDriverStatusList, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9515,7 +9730,10 @@ int __stdcall ReferencingActionListGet (int SocketIndex, char * list)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ReferencingActionListGet (char *)");
@@ -9540,8 +9758,6 @@ int __stdcall ReferencingActionListGet (int SocketIndex, char * list)
 		ptNext = strchr (list, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9560,7 +9776,10 @@ int __stdcall ReferencingSensorListGet (int SocketIndex, char * list)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_BIG); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_BIG); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ReferencingSensorListGet (char *)");
@@ -9585,8 +9804,6 @@ int __stdcall ReferencingSensorListGet (int SocketIndex, char * list)
 		ptNext = strchr (list, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9612,7 +9829,10 @@ int __stdcall GatheringUserDatasGet (int SocketIndex, double * UserData1, double
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "GatheringUserDatasGet (double *,double *,double *,double *,double *,double *,double *,double *)");
@@ -9654,8 +9874,6 @@ int __stdcall GatheringUserDatasGet (int SocketIndex, double * UserData1, double
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", UserData8);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9679,7 +9897,10 @@ int __stdcall ControllerMotionKernelPeriodMinMaxGet (int SocketIndex, double * M
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ControllerMotionKernelPeriodMinMaxGet (double *,double *,double *,double *,double *,double *)");
@@ -9715,8 +9936,6 @@ int __stdcall ControllerMotionKernelPeriodMinMaxGet (int SocketIndex, double * M
 		if (pt != NULL) pt++;
 		if (pt != NULL) sscanf (pt, "%lf", MaximumServitudesPeriod);
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9734,7 +9953,10 @@ int __stdcall ControllerMotionKernelPeriodMinMaxReset (int SocketIndex)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "ControllerMotionKernelPeriodMinMaxReset ()");
@@ -9746,8 +9968,6 @@ int __stdcall ControllerMotionKernelPeriodMinMaxReset (int SocketIndex)
 		sscanf (ReturnedValue, "%i", &ret); 
 
 	/* Get the returned values in the out parameters */ 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9766,7 +9986,10 @@ int __stdcall SocketsStatusGet (int SocketIndex, char * SocketsStatus)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "SocketsStatusGet (char *)");
@@ -9791,8 +10014,6 @@ int __stdcall SocketsStatusGet (int SocketIndex, char * SocketsStatus)
 		ptNext = strchr (SocketsStatus, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -9812,7 +10033,10 @@ int __stdcall TestTCP (int SocketIndex, char * InputString, char * ReturnString)
 { 
 	int ret = -1; 
 	char ExecuteMethod[SIZE_EXECUTE_METHOD]; 
-	char *ReturnedValue = (char *) malloc (sizeof(char) * SIZE_SMALL); 
+	char *ReturnedValue = ReturnBufferGet (SIZE_SMALL); 
+
+	if (ReturnedValue == NULL) 
+		return (ret); 
 
 	/* Convert to string */ 
 	sprintf (ExecuteMethod, "TestTCP (%s,char *)", InputString);
@@ -9837,8 +10061,6 @@ int __stdcall TestTCP (int SocketIndex, char * InputString, char * ReturnString)
 		ptNext = strchr (ReturnString, ',');
 		if (ptNext != NULL) *ptNext = '\0';
 	} 
-	if (NULL != ReturnedValue)
-		free (ReturnedValue);
 
 	return (ret); 
 }
@@ -31,25 +31,44 @@ static void printRecv (char*, int);
 
 /******[ ftpConnect ]************************************************/
 epicsShareFunc int ftpConnect (char* ip, char* login, char* password, SOCKET* socketFD)
+{
+  return ftpConnectPort(ip, FTP_PORT, login, password, socketFD);
+}
+
+
+/******[ ftpConnectPort ]********************************************/
+epicsShareFunc int ftpConnectPort (char* ip, int port, char* login, char* password, SOCKET* socketFD)
 {
   char command[COMMAND_SIZE];
   char returnString[RETURN_SIZE];
   struct sockaddr_in sockAddr;
   SOCKET sockFD;
+  int i;
 
   memset(&sockAddr, 0, sizeof(sockAddr));
 
   sockFD = socket(AF_INET, SOCK_STREAM, 0);
 
   sockAddr.sin_family = AF_INET;
-  sockAddr.sin_port = htons(21);
+#ifdef _WIN32
+  sockAddr.sin_port = htons((u_short)port);
+#else
+  sockAddr.sin_port = htons(port);
+#endif
   sockAddr.sin_addr.s_addr = inet_addr(ip);
 
-  if (connect(sockFD, (struct sockaddr *)&sockAddr, sizeof(sockAddr)) < 0) 
+  if (connect(sockFD, (struct sockaddr *)&sockAddr, sizeof(sockAddr)) < 0) {
+    ftpDisconnect(sockFD);
     return -1;
+  }
 
   do {
-    recv(sockFD, returnString, RETURN_SIZE, 0);
+    i = recv(sockFD, returnString, RETURN_SIZE-1, 0);
+    if (i <= 0) {                 /* closed before the welcome message */
+      ftpDisconnect(sockFD);
+      return -1;
+    }
+    returnString[i] = '\0';
   }
   while (strchr(returnString,'\n')==NULL);
 
@@ -112,6 +131,8 @@ epicsShareFunc int ftpRetrieveFile(SOCKET socketFD, char *filename)
   memset(&adr_rcv, 0, sizeof(adr_rcv));
      
   port_rcv = getPort(socketFD, ip); 
+  if (port_rcv < 0)
+    return -1;
   
   socketFDReceive = socket (AF_INET, SOCK_STREAM, 0);
   
@@ -186,6 +207,8 @@ epicsShareFunc int ftpStoreFile(SOCKET socketFD, char *filename)
   memset(&adr_snd, 0, sizeof(adr_snd));
      
   port_snd = getPort(socketFD, ip); 
+  if (port_snd < 0)
+    return -1;
   
   socketFDSend = socket (AF_INET, SOCK_STREAM, 0);
   
@@ -242,11 +265,84 @@ epicsShareFunc int ftpStoreFile(SOCKET socketFD, char *filename)
 }
 
 
+/******[ ftpStoreBuffer ]********************************************/
+/* Stores the contents of a buffer as a file, without a file on the local host.
+ * Unlike ftpStoreFile() every reply is checked, so that a session which the
+ * server has closed is reported, and the caller can connect again. */
+epicsShareFunc int ftpStoreBuffer(SOCKET socketFD, char *filename, const char *buffer, int length)
+{
+  int port_snd, i, sent;
+  SOCKET socketFDSend;
+  struct sockaddr_in adr_snd;
+  char ip[IP_SIZE];
+  char command[COMMAND_SIZE];
+  char returnString[RETURN_SIZE];
+
+  memset(&adr_snd, 0, sizeof(adr_snd));
+     
+  port_snd = getPort(socketFD, ip); 
+  if (port_snd < 0)
+    return -1;
+  
+  socketFDSend = socket (AF_INET, SOCK_STREAM, 0);
+  
+  adr_snd.sin_family = AF_INET;
+  adr_snd.sin_addr.s_addr = inet_addr(ip);
+#ifdef _WIN32
+  adr_snd.sin_port = htons((u_short)port_snd);
+#else
+  adr_snd.sin_port = htons(port_snd);
+#endif
+
+  if (0 > connect (socketFDSend, (struct sockaddr *) &adr_snd, sizeof(adr_snd)))
+    { 
+      fprintf(stderr,"Cound not connect to FTP server to store file %s\n", filename);
+      ftpDisconnect(socketFDSend);
+      return -1;
+    }
+  
+  /* send command */
+  sprintf(command, "STOR %s", filename);
+  if ((-1 == sendFtpCommandAndReceive (socketFD, command, returnString)) ||
+      (code(returnString) >= 400))
+    {
+      ftpDisconnect(socketFDSend);
+      return -1;
+    }
+
+  for (sent = 0; sent < length; sent += i)
+    {
+      i = send(socketFDSend, buffer + sent, length - sent, 0);
+      if (i <= 0)
+        break;
+    }
+
+  ftpDisconnect(socketFDSend);
+  if (sent < length)
+    return -1;
+
+  i = recv(socketFD, returnString, RETURN_SIZE-1, 0);     /* read "226 Transfer complete." */
+  if (i <= 0)
+    return -1;
+  returnString[i] = '\0';
+
+#ifdef DEBUG
+  printf(" -> ");
+  printRecv(returnString, i);
+#endif
+
+  if (code(returnString) >= 400)
+    return -1;
+  return 0;
+}
+
+
 /******[ code ]******************************************************/
 static int code (char *str)
 {
-  char tmp[3];
+  char tmp[4];
   strncpy(tmp, str, 3);
+  tmp[3] = '\0';
   return atoi(tmp);
 }
 
@@ -264,7 +360,9 @@ static int sendFtpCommandAndReceive (SOCKET socketFD, char* command, char* retur
 	sprintf(command, "%s\n", command);
 
 	send (socketFD, command, (int)strlen(command), 0);
-	receivedBytes = recv(socketFD, str_rec, RETURN_SIZE, 0);
+	receivedBytes = recv(socketFD, str_rec, RETURN_SIZE-1, 0);
+	if (receivedBytes <= 0)       /* The server has closed the connection */
+		return -1;
    
 #ifdef DEBUG
 	printf(" -> ");
@@ -313,7 +411,9 @@ static int sendFtpCommandAndReceive (SOCKET socketFD, char* command, char* retur
 			}
 
 			if ((j+4) >= strlen(str_rec)) {       /* Last line not found yet, keep going */
-				i = recv(socketFD, str_rec, RETURN_SIZE, 0);
+				i = recv(socketFD, str_rec, RETURN_SIZE-1, 0);
+				if (i <= 0)
+					return -1;
 				str_rec[i] = '\0';
 			}
 		}
@@ -331,7 +431,9 @@ static int  getPort (SOCKET socketFD, char* ip)
   int count, i, j, port;
 
   strcpy(command, "PASV");
-  sendFtpCommandAndReceive (socketFD, command, returnString);
+  if ((-1 == sendFtpCommandAndReceive (socketFD, command, returnString)) ||
+      (code(returnString) != 227))
+    return -1;
   
   i = 27;
   count = 0;
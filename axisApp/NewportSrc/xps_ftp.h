@@ -35,6 +35,7 @@
 #define COMMAND_SIZE 256   /* size of a FTP command string */
 #define RETURN_SIZE  1500  /* size of a return (size of standard IP package) */
 #define PATH_SIZE    256   /* size of path */
+#define FTP_PORT     21    /* port of the FTP server */
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,10 +44,12 @@ extern "C" {
 /******[ prototypes ]************************************************/
 /* FTP commands */
 epicsShareFunc int ftpConnect (char*, char*, char*, SOCKET*);
+epicsShareFunc int ftpConnectPort (char*, int, char*, char*, SOCKET*);
 epicsShareFunc int ftpDisconnect (SOCKET);
 epicsShareFunc int ftpChangeDir (SOCKET, char*);
 epicsShareFunc int ftpRetrieveFile (SOCKET, char*);
 epicsShareFunc int ftpStoreFile(SOCKET, char*);
+epicsShareFunc int ftpStoreBuffer(SOCKET, char*, const char*, int);
 
 #ifdef __cplusplus
 }
@@ -603,6 +603,8 @@ void omsBaseController::omsPoller()
     lock();
     movingPollPeriod = movingPollPeriod_;
     idlePollPeriod = idlePollPeriod_;
+    /* in push mode the controller notifies us when a move is done */
+    if (watchdogPollPeriod_ > 0.0) idlePollPeriod = watchdogPollPeriod_;
     forcedFastPolls = forcedFastPolls_;
     for (int i=0; (i < numAxes); i++) {
         getIntegerParam(i, motorStatusHasEncoder_, &haveEncoder);
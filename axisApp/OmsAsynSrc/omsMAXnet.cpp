@@ -56,11 +56,11 @@ void omsMAXnet::asynCallback(void *drvPvt, asynUser *pasynUser, char *data, size
     omsMAXnet* pController = (omsMAXnet*)drvPvt;
 
 /* If the string has a "%", it is a notification, increment counter and
- * send a signal to the poller task which will trigger a poll */
+ * wake up the poller task which will trigger a poll */
 
     if ((len >= 1) && (strchr(data, '%') != NULL)){
         char* pos = strchr(data, '%');
-        epicsEventSignal(pController->pollEventId_);
+        pController->wakeupPoller();
         while (pos != NULL){
             Debug(2, "omsMAXnet::asynCallback: %s (%d)\n", data, len);
             pController->notificationMutex->lock();
@@ -312,7 +312,7 @@ int omsMAXnet::isNotification (char *buffer) {
         else {
             Debug(2,"%s:%s:%s: Interrupt notification: %s\n",
             		driverName, functionName, portName, buffer);
-            epicsEventSignal(pollEventId_);
+            wakeupPoller();
         }
         return 1;
     }
@@ -348,12 +348,15 @@ extern "C" int omsMAXnetConfig(
               const char *serialPortName,/* MAXnet Serial Asyn Port name */
               int movingPollPeriod,      /* Time to poll (msec) when an axis is in motion */
               int idlePollPeriod,        /* Time to poll (msec) when an axis is idle. 0 for no polling */
-              const char *initString)    /* Init String sent to card */
+              const char *initString,    /* Init String sent to card */
+              int watchdogPollPeriod)    /* Time to poll (msec) when an axis is idle and
+                                            notifications are used. 0 to use idlePollPeriod */
 {
     // for now priority and stacksize are hardcoded here, should they be configurable in omsMAXnetConfig?
     int priority = epicsThreadPriorityMedium;
     int stackSize = epicsThreadGetStackSize(epicsThreadStackMedium);
     omsMAXnet *pController = new omsMAXnet(portName, numAxes, serialPortName, initString, priority, stackSize);
+    if (watchdogPollPeriod > 0) pController->setPushMode((double)watchdogPollPeriod/1000.);
     pController->startPoller((double)movingPollPeriod, (double)idlePollPeriod, 10);
     return(asynSuccess);
 }
@@ -367,16 +370,18 @@ static const iocshArg omsMAXnetConfigArg2 = {"asyn serial/tcp port name", iocshA
 static const iocshArg omsMAXnetConfigArg3 = {"moving poll rate", iocshArgInt};
 static const iocshArg omsMAXnetConfigArg4 = {"idle poll rate", iocshArgInt};
 static const iocshArg omsMAXnetConfigArg5 = {"initstring", iocshArgString};
-static const iocshArg * const omsMAXnetConfigArgs[6] = {&omsMAXnetConfigArg0,
+static const iocshArg omsMAXnetConfigArg6 = {"watchdog poll rate", iocshArgInt};
+static const iocshArg * const omsMAXnetConfigArgs[7] = {&omsMAXnetConfigArg0,
                                                   &omsMAXnetConfigArg1,
                                                   &omsMAXnetConfigArg2,
                                                   &omsMAXnetConfigArg3,
                                                   &omsMAXnetConfigArg4,
-                                                  &omsMAXnetConfigArg5 };
-static const iocshFuncDef configOmsMAXnet = {"omsMAXnetConfig", 6, omsMAXnetConfigArgs};
+                                                  &omsMAXnetConfigArg5,
+                                                  &omsMAXnetConfigArg6 };
+static const iocshFuncDef configOmsMAXnet = {"omsMAXnetConfig", 7, omsMAXnetConfigArgs};
 static void configOmsMAXnetCallFunc(const iocshArgBuf *args)
 {
-    omsMAXnetConfig(args[0].sval, args[1].ival, args[2].sval, args[3].ival, args[4].ival, args[5].sval);
+    omsMAXnetConfig(args[0].sval, args[1].ival, args[2].sval, args[3].ival, args[4].ival, args[5].sval, args[6].ival);
 }
 
 static void OmsMAXnetAsynRegister(void)
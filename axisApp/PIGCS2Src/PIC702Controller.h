@@ -31,6 +31,11 @@ public:
 	~PIC702Controller() {}
 
     virtual asynStatus getStatus(PIasynAxis* pAxis, int& homing, int& moving, int& negLimit, int& posLimit, int& servoControl);
+    /// no status register, only the positions are read for all axes
+    virtual asynStatus getAllAxesState(asynAxisAxis** pAxes, int numAxes)
+    {
+    	return PIGCSController::getAllAxesState(pAxes, numAxes);
+    }
 	virtual asynStatus getMaxAcceleration( PIasynAxis* pAxis );
     virtual asynStatus hasReferenceSensor(PIasynAxis* pAxis);
     virtual asynStatus getReferencedState(PIasynAxis* axis);
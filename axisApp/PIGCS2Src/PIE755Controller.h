@@ -40,6 +40,11 @@ public:
 	virtual asynStatus setAccelerationCts( PIasynAxis* pAxis, double acceleration)	{ return asynSuccess; }
 	virtual asynStatus setAcceleration( PIasynAxis* pAxis, double acceleration)	{ return asynSuccess; }
     virtual asynStatus getStatus(PIasynAxis* pAxis, int& homing, int& moving, int& negLimit, int& posLimit, int& servoControl);
+    /// no status register, only the positions are read for all axes
+    virtual asynStatus getAllAxesState(asynAxisAxis** pAxes, int numAxes)
+    {
+    	return PIGCSController::getAllAxesState(pAxes, numAxes);
+    }
 
 private:
 
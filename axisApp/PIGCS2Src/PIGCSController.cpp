@@ -286,6 +286,13 @@ asynStatus PIGCSController::haltAxis(PIasynAxis* pAxis)
  */
 asynStatus PIGCSController::getAxisPosition(PIasynAxis* pAxis, double& position)
 {
+	int axisNo = pAxis->getAxisNo();
+	if (axisNo >= 0 && axisNo < int(MAX_NR_AXES) && m_positionCached[axisNo])
+	{
+		m_positionCached[axisNo] = false;
+		position = m_cachedPositions[axisNo];
+		return asynSuccess;
+	}
 	char cmd[100];
 	char buf[255];
 	sprintf(cmd, "POS? %s", pAxis->m_szAxisName);
@@ -485,6 +492,13 @@ asynStatus PIGCSController::setServo(PIasynAxis* pAxis, int servoState)
 
 asynStatus PIGCSController::getMoving(PIasynAxis* pAxis, int& moving)
 {
+	int axisNo = pAxis->getAxisNo();
+	if (axisNo >= 0 && axisNo < int(MAX_NR_AXES) && m_movingStateCached[axisNo])
+	{
+		m_movingStateCached[axisNo] = false;
+		moving = (m_cachedMovingState & pAxis->m_movingStateMask) != 0 ? 1 : 0;
+		return asynSuccess;
+	}
 	char buf[255];
     asynStatus status = m_pInterface->sendAndReceive(char(5), buf, 99);;
     if (status != asynSuccess)
@@ -549,6 +563,25 @@ PIGCSController::PIGCSController(PIInterface* pInterface, const char* szIDN)
 , m_LastError(0)
 {
 	strncpy(szIdentification, szIDN, 199);
+	m_cachedMovingState = 0;
+	for (size_t i=0; i<MAX_NR_AXES; i++)
+	{
+		m_positionCached[i] = false;
+		m_movingStateCached[i] = false;
+	}
+}
+
+/**
+ *  Discard the values of getAllAxesState() which the axes have not used,
+ *  called at the end of each poll cycle.
+ */
+void PIGCSController::clearCachedState()
+{
+	for (size_t i=0; i<MAX_NR_AXES; i++)
+	{
+		m_positionCached[i] = false;
+		m_movingStateCached[i] = false;
+	}
 }
 
 PIGCSController::~PIGCSController()
@@ -621,6 +654,110 @@ asynStatus PIGCSController::findConnectedAxes()
 	return status;
 }
 
+/**
+ *  Read the state of all axes with as few queries as possible, called once per
+ *  poll cycle from PIasynController::poll() before the axes are polled.
+ *  The positions of all axes are read with a single "POS?", the next
+ *  getAxisPosition() of each axis takes its value from the cache.
+ */
+asynStatus PIGCSController::getAllAxesState(asynAxisAxis** pAxes, int numAxes)
+{
+	if (!IsGCS2())
+	{
+		return asynSuccess;
+	}
+	return queryAllAxes("POS?", NULL, pAxes, numAxes, m_cachedPositions, m_positionCached);
+}
+
+/**
+ *  Send one query for all axes, e.g. "POS? 1 2 3" or "SRG? 1 1 2 1 3 1",
+ *  and parse the answer with one line "<axis>[ <arg>]=<value>" per axis.
+ *  Hexadecimal values like "0x9000" are accepted.
+ *  \param[in] szCmd The GCS query.
+ *  \param[in] szArg Added after each axis name if not NULL.
+ *  \param[in] pAxes The axes of the controller, may contain NULL.
+ *  \param[in] numAxes The number of entries in pAxes.
+ *  \param[out] values The values, indexed by the axis number.
+ *  \param[out] valid Set for every axis which is in the answer.
+ */
+asynStatus PIGCSController::queryAllAxes(const char* szCmd, const char* szArg, asynAxisAxis** pAxes, int numAxes, double* values, bool* valid)
+{
+	char cmd[MAX_NR_AXES * 24];
+	char buf[MAX_NR_AXES * 40];
+	size_t len;
+	int i;
+
+	if (numAxes > int(MAX_NR_AXES))
+	{
+		numAxes = MAX_NR_AXES;
+	}
+	len = sprintf(cmd, "%s", szCmd);
+	for (i=0; i<numAxes; i++)
+	{
+		PIasynAxis* pAxis = (PIasynAxis*)pAxes[i];
+		if (pAxis == NULL || pAxis->m_szAxisName == NULL || pAxis->getAxisNo() >= int(MAX_NR_AXES))
+		{
+			continue;
+		}
+		valid[pAxis->getAxisNo()] = false;
+		len += sprintf(cmd+len, " %s", pAxis->m_szAxisName);
+		if (szArg != NULL)
+		{
+			len += sprintf(cmd+len, " %s", szArg);
+		}
+	}
+	if (len == strlen(szCmd))
+	{
+		return asynSuccess;
+	}
+	memset(buf, 0, sizeof(buf));
+	asynStatus status = m_pInterface->sendAndReceive(cmd, buf, sizeof(buf)-1);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+
+	char* szLine = buf;
+	while (szLine != NULL && *szLine != '\0')
+	{
+		char* szNext = strchr(szLine, '\n');
+		if (szNext != NULL)
+		{
+			*szNext++ = '\0';
+		}
+		char* szValue = strchr(szLine, '=');
+		if (szValue != NULL)
+		{
+			*szValue++ = '\0';
+			// the axis name is the first word before '='
+			size_t nameLen = strcspn(szLine, " ");
+			for (i=0; i<numAxes; i++)
+			{
+				PIasynAxis* pAxis = (PIasynAxis*)pAxes[i];
+				if (pAxis == NULL || pAxis->m_szAxisName == NULL || pAxis->getAxisNo() >= int(MAX_NR_AXES))
+				{
+					continue;
+				}
+				if (strlen(pAxis->m_szAxisName) == nameLen && !strncmp(pAxis->m_szAxisName, szLine, nameLen))
+				{
+					if (!strncmp(szValue, "0x", 2) || !strncmp(szValue, "0X", 2))
+					{
+						values[pAxis->getAxisNo()] = double(strtol(szValue, NULL, 16));
+					}
+					else
+					{
+						values[pAxis->getAxisNo()] = atof(szValue);
+					}
+					valid[pAxis->getAxisNo()] = true;
+					break;
+				}
+			}
+		}
+		szLine = szNext;
+	}
+	return status;
+}
+
 asynStatus PIGCSController::getReferencedState(PIasynAxis* pAxis)
 {
 	char cmd[100];
@@ -676,6 +813,218 @@ asynStatus PIGCSController::SetPivotZ(double value)
 	return asynSuccess;
 }
 
+/**
+ *  Read the servo update time of the controller in seconds.
+ *  The wave generator outputs one point of the wave table every
+ *  WTR servo cycles.
+ */
+asynStatus PIGCSController::getServoCycleTime(double& cycleTime)
+{
+	char cmd[100];
+	char buf[255];
+	sprintf(cmd, "SPA? %s 0x%X", m_axesIDs[0], PI_PARA_SERVO_UPDATE_TIME);
+	asynStatus status = m_pInterface->sendAndReceive(cmd, buf, 99);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	if (!getValue(buf, cycleTime) || cycleTime <= 0.0)
+	{
+		return asynError;
+	}
+	return status;
+}
+
+/**
+ *  Store the positions of a profile move in the wave table of an axis.
+ *  The wave table, wave generator and data recorder table of an axis all use
+ *  the axis number + 1.  The positions are in physical units (EGU) as defined on
+ *  the controller, they are sent in several WAV commands, the first one clears
+ *  the wave table ("X"), the others append to it ("&").
+ */
+asynStatus PIGCSController::defineWaveTable(PIasynAxis* pAxis, const double* positions, int numPoints)
+{
+	char cmd[WAVE_POINTS_PER_COMMAND*20 + 100];
+	int table = pAxis->getAxisNo() + 1;
+	asynStatus status = asynSuccess;
+
+	for (int first=0; first<numPoints; first+=WAVE_POINTS_PER_COMMAND)
+	{
+		int num = numPoints - first;
+		if (num > WAVE_POINTS_PER_COMMAND)
+		{
+			num = WAVE_POINTS_PER_COMMAND;
+		}
+		int len = sprintf(cmd, "WAV %d %s PNT 1 %d", table, (first == 0) ? "X" : "&", num);
+		for (int i=0; i<num; i++)
+		{
+			len += sprintf(cmd+len, " %.9g", positions[first+i]);
+		}
+		status = m_pInterface->sendOnly(cmd);
+		if (status != asynSuccess)
+		{
+			return status;
+		}
+	}
+	int errorCode = getGCSError();
+	if (errorCode != 0)
+	{
+		asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
+				"PIGCSController::defineWaveTable() axis %s failed, GCS error %d\n", pAxis->m_szAxisName, errorCode);
+		return asynError;
+	}
+	return status;
+}
+
+/**
+ *  Start the wave generators of the axes at the same time, each one outputs its
+ *  wave table once.  The data recorder records the actual position of each axis
+ *  once per wave table point, starting with the wave generators.
+ *  \param[in] pAxesArray The axes of the profile move.
+ *  \param[in] offsets The wave offset of each axis in EGU, which is added to the wave table.
+ *  \param[in] numAxes The number of axes.
+ *  \param[in] tableRate The number of servo cycles per wave table point.
+ */
+asynStatus PIGCSController::startWaveGenerators(PIasynAxis** pAxesArray, const double* offsets, int numAxes, int tableRate)
+{
+	char cmd[100];
+	char wgoCmd[MAX_NR_AXES*10 + 10] = "WGO";
+	asynStatus status;
+
+	sprintf(cmd, "RTR %d", tableRate);
+	status = m_pInterface->sendOnly(cmd);
+	for (int i=0; i<numAxes && status == asynSuccess; i++)
+	{
+		int id = pAxesArray[i]->getAxisNo() + 1;
+		sprintf(cmd, "WSL %d %d", id, id);
+		status = m_pInterface->sendOnly(cmd);
+		if (status != asynSuccess) break;
+		sprintf(cmd, "WGC %d 1", id);
+		status = m_pInterface->sendOnly(cmd);
+		if (status != asynSuccess) break;
+		sprintf(cmd, "WOS %d %.9g", id, offsets[i]);
+		status = m_pInterface->sendOnly(cmd);
+		if (status != asynSuccess) break;
+		// linear interpolation between the points of the wave table
+		sprintf(cmd, "WTR %d %d 1", id, tableRate);
+		status = m_pInterface->sendOnly(cmd);
+		if (status != asynSuccess) break;
+		// record the actual position of the axis
+		sprintf(cmd, "DRC %d %s 2", id, pAxesArray[i]->m_szAxisName);
+		status = m_pInterface->sendOnly(cmd);
+		if (status != asynSuccess) break;
+		sprintf(wgoCmd+strlen(wgoCmd), " %d 1", id);
+	}
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	// start the recording with the next command which changes a position, i.e. WGO
+	status = m_pInterface->sendOnly("DRT 0 1 0");
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	int errorCode = getGCSError();
+	if (errorCode != 0)
+	{
+		asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
+				"PIGCSController::startWaveGenerators() configuration failed, GCS error %d\n", errorCode);
+		return asynError;
+	}
+	status = m_pInterface->sendOnly(wgoCmd);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	errorCode = getGCSError();
+	if (errorCode != 0)
+	{
+		asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
+				"PIGCSController::startWaveGenerators() \"%s\" failed, GCS error %d\n", wgoCmd, errorCode);
+		return asynError;
+	}
+	return status;
+}
+
+asynStatus PIGCSController::stopWaveGenerators(PIasynAxis** pAxesArray, int numAxes)
+{
+	char cmd[MAX_NR_AXES*10 + 10] = "WGO";
+	for (int i=0; i<numAxes; i++)
+	{
+		sprintf(cmd+strlen(cmd), " %d 0", pAxesArray[i]->getAxisNo() + 1);
+	}
+	asynStatus status = m_pInterface->sendOnly(cmd);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	int errorCode = getGCSError();
+	if (errorCode != 0)
+	{
+		asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
+				"PIGCSController::stopWaveGenerators() failed, GCS error %d\n", errorCode);
+		return asynError;
+	}
+	return status;
+}
+
+/**
+ *  Check with "#9" whether any of the wave generators of the axes is running.
+ */
+asynStatus PIGCSController::getWaveGeneratorsRunning(PIasynAxis** pAxesArray, int numAxes, bool& running)
+{
+	char buf[255];
+	asynStatus status = m_pInterface->sendAndReceive(char(9), buf, 99);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	long mask = strtol(buf, NULL, 16);
+	running = false;
+	for (int i=0; i<numAxes; i++)
+	{
+		if (mask & (1L << pAxesArray[i]->getAxisNo()))
+		{
+			running = true;
+		}
+	}
+	return status;
+}
+
+/**
+ *  Read the positions which the data recorder recorded during a profile move,
+ *  with one "DRR?" for all axes, which PIInterface::sendAndReceiveValues() reads line by line.
+ *  \param[in] pAxesArray The axes of the profile move.
+ *  \param[in] numAxes The number of axes.
+ *  \param[in] firstPoint The first point to read, starting at 0.
+ *  \param[in] numPoints The number of points to read.
+ *  \param[out] positions Per axis, the array for the positions in EGU, starting with firstPoint.
+ */
+asynStatus PIGCSController::readRecordedPositions(PIasynAxis** pAxesArray, int numAxes, int firstPoint, int numPoints, double** positions)
+{
+	char cmd[MAX_NR_AXES*10 + 100];
+	double* columns[MAX_NR_AXES];
+	int numRead = 0;
+
+	// the points of the data recorder start at 1
+	int len = sprintf(cmd, "DRR? %d %d", firstPoint+1, numPoints);
+	for (int i=0; i<numAxes; i++)
+	{
+		len += sprintf(cmd+len, " %d", pAxesArray[i]->getAxisNo() + 1);
+		columns[i] = positions[i];
+	}
+	// a header with lines starting with '#', then one line per point with a column per axis
+	asynStatus status = m_pInterface->sendAndReceiveValues(cmd, columns, numAxes, numPoints, numRead);
+	if (status == asynSuccess && numRead != numPoints)
+	{
+		asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
+				"PIGCSController::readRecordedPositions() \"%s\" returned %d of %d points\n", cmd, numRead, numPoints);
+		status = asynError;
+	}
+	return status;
+}
+
 bool PIGCSController::getValue(const char* szMsg, double& value)
 {
 	const char* p = strstr(szMsg, "=");
@@ -65,6 +65,8 @@ public:
     virtual asynStatus getResolution(PIasynAxis* pAxis, double& resolution );
     virtual asynStatus getStatus(PIasynAxis* pAxis, int& homing, int& moving, int& negLimit, int& posLimit, int& servoControl) = 0;
     virtual asynStatus getGlobalState( asynAxisAxis** Axes, int numAxes ) { return asynSuccess; }
+    virtual asynStatus getAllAxesState( asynAxisAxis** Axes, int numAxes );
+    virtual void clearCachedState();
     virtual asynStatus getMoving(PIasynAxis* pAxis, int& homing);
     virtual asynStatus getBusy(PIasynAxis* pAxis, int& busy);
     virtual asynStatus getTravelLimits(PIasynAxis* pAxis, double& negLimit, double& posLimit);
@@ -80,6 +82,14 @@ public:
     virtual double GetPivotY() { return 0.0; }
     virtual double GetPivotZ() { return 0.0; }
 
+    virtual bool HasWaveGenerator() { return false; }
+    virtual asynStatus getServoCycleTime(double& cycleTime);
+    virtual asynStatus defineWaveTable(PIasynAxis* pAxis, const double* positions, int numPoints);
+    virtual asynStatus startWaveGenerators(PIasynAxis** pAxesArray, const double* offsets, int numAxes, int tableRate);
+    virtual asynStatus stopWaveGenerators(PIasynAxis** pAxesArray, int numAxes);
+    virtual asynStatus getWaveGeneratorsRunning(PIasynAxis** pAxesArray, int numAxes, bool& running);
+    virtual asynStatus readRecordedPositions(PIasynAxis** pAxesArray, int numAxes, int firstPoint, int numPoints, double** positions);
+
     virtual bool AcceptsNewTarget() { return true; }
     virtual bool CanCommunicateWhileHoming() { return true; }
 
@@ -96,11 +106,19 @@ public:
     static const size_t MAX_NR_AXES = 64;
 	bool m_bAnyAxisMoving;
 protected:
+    enum
+    {
+    	PI_PARA_SERVO_UPDATE_TIME	= 0x0E000200UL
+    };
+    static const int WAVE_POINTS_PER_COMMAND = 50;	///< points of the wave table per WAV command
+
     asynStatus setGCSParameter(PIasynAxis* pAxis, unsigned int paramID, double value);
     asynStatus getGCSParameter(PIasynAxis* pAxis, unsigned int paramID, double& value);
 
     virtual asynStatus findConnectedAxes();
 
+    asynStatus queryAllAxes(const char* szCmd, const char* szArg, asynAxisAxis** pAxes, int numAxes, double* values, bool* valid);
+
     static bool IsGCS2(PIInterface* pInterface);
 
 	char szIdentification[200];
@@ -109,6 +127,12 @@ protected:
 	size_t m_nrFoundAxes;
 	char m_allAxesIDs[255];
 	int m_LastError;
+
+	/// Filled by getAllAxesState() for every axis number, used once by the next poll of the axis
+	double m_cachedPositions[MAX_NR_AXES];
+	bool m_positionCached[MAX_NR_AXES];
+	long m_cachedMovingState;
+	bool m_movingStateCached[MAX_NR_AXES];
 };
 
 #endif /* PIGCSCONTROLLER_H_ */
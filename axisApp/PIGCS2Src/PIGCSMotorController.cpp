@@ -133,30 +133,86 @@ asynStatus PIGCSMotorController::getResolution(PIasynAxis* pAxis, double& resolu
 
 }
 
+/**
+ *  Read the positions and the status registers of all axes with one "POS?"
+ *  and one "SRG?" query, the next getStatus() of each axis takes its
+ *  status register from the cache.
+ */
+asynStatus PIGCSMotorController::getAllAxesState(asynAxisAxis** pAxes, int numAxes)
+{
+	asynStatus status = PIGCSController::getAllAxesState(pAxes, numAxes);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	if (!m_bCanReadStatusRegister)
+	{
+		return status;
+	}
+	status = queryAllAxes("SRG?", "1", pAxes, numAxes, m_cachedStatusRegister, m_statusRegisterCached);
+	if (status != asynSuccess)
+	{
+		int err = getGCSError();
+		if (err == PI_CNTR_UNKNOWN_COMMAND)
+		{
+			// older firmware without "SRG?", do not wait for the timeout in every poll
+			m_bCanReadStatusRegister = false;
+			asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_ERROR,
+					"PIGCSMotorController::getAllAxesState() \"SRG?\" not known, using \"#4\"\n");
+		}
+		else
+		{
+			asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_ERROR,
+					"PIGCSMotorController::getAllAxesState() \"SRG?\" failed, status %d, error %d\n", status, err);
+		}
+	}
+	return status;
+}
+
+void PIGCSMotorController::clearCachedState()
+{
+	PIGCSController::clearCachedState();
+	for (size_t i=0; i<MAX_NR_AXES; i++)
+	{
+		m_statusRegisterCached[i] = false;
+	}
+}
+
 asynStatus PIGCSMotorController::getStatus(PIasynAxis* pAxis, int& homing, int& moving, int& negLimit, int& posLimit, int& servoControl)
 {
 	char buf[255];
-    asynStatus status = m_pInterface->sendAndReceive(char(4), buf, 99);
-    if (status != asynSuccess)
+	long mask;
+    asynStatus status = asynSuccess;
+    int axisNo = pAxis->getAxisNo();
+    if (axisNo >= 0 && axisNo < int(MAX_NR_AXES) && m_statusRegisterCached[axisNo])
     {
-    	return status;
+    	m_statusRegisterCached[axisNo] = false;
+    	mask = long(m_cachedStatusRegister[axisNo]);
+    }
+    else
+    {
+		status = m_pInterface->sendAndReceive(char(4), buf, 99);
+		if (status != asynSuccess)
+		{
+			return status;
+		}
+		// TODO this is for a single axis C-863/867 controller!!!!
+		// TODO a) change it to multi-axis code.
+		// TODO b) support other controllers which do not understand #4 or have different bit masks
+
+		int idx = 2 + pAxis->getAxisNo()*4;
+		buf[idx+4] = '\0';
+		char* szMask = buf+idx;
+		mask = strtol(szMask, NULL, 16);
     }
-    // TODO this is for a single axis C-863/867 controller!!!!
-    // TODO a) change it to multi-axis code.
-    // TODO b) support other controllers which do not understand #4 or have different bit masks
-
-    int idx = 2 + pAxis->getAxisNo()*4;
-    buf[idx+4] = '\0';
-    char* szMask = buf+idx;
-    long mask = strtol(szMask, NULL, 16);
     moving = (mask & 0x2000) ? 1 : 0;
     homing = (mask & 0x4000) ? 1 : 0;
     negLimit = (mask & 0x0001) ? 1 : 0;
     posLimit = (mask & 0x0004) ? 1 : 0;
     servoControl = (mask & 0x1000) ? 1 : 0;
     asynPrint(m_pInterface->m_pCurrentLogSink, ASYN_TRACE_FLOW,
-               "PIGCSMotorController::getStatus() buf:%s moving %d, svo: %d\n",
-               buf, moving, servoControl);
+               "PIGCSMotorController::getStatus() mask:0x%lx moving %d, svo: %d\n",
+               mask, moving, servoControl);
 
     return status;
 }
@@ -29,7 +29,12 @@ class PIGCSMotorController : public PIGCSController
 public:
 	PIGCSMotorController(PIInterface* pInterface, const char* szIDN)
 	: PIGCSController(pInterface, szIDN)
+	, m_bCanReadStatusRegister(true)
 	{
+		for (size_t i=0; i<MAX_NR_AXES; i++)
+		{
+			m_statusRegisterCached[i] = false;
+		}
 	}
 	~PIGCSMotorController() {}
 	virtual asynStatus initAxis(PIasynAxis* pAxis);
@@ -40,6 +45,8 @@ public:
 	virtual asynStatus referenceVelCts( PIasynAxis* pAxis, double velocity, int forwards);
     virtual asynStatus getResolution(PIasynAxis* pAxis, double& resolution );
     virtual asynStatus getStatus(PIasynAxis* pAxis, int& homing, int& moving, int& negLimit, int& posLimit, int& servoControl);
+    virtual asynStatus getAllAxesState(asynAxisAxis** pAxes, int numAxes);
+    virtual void clearCachedState();
 
 protected:
     enum
@@ -54,7 +61,10 @@ protected:
     };
 
 private:
-
+    /// Status registers read by getAllAxesState() with "SRG?", used once by getStatus()
+    double m_cachedStatusRegister[MAX_NR_AXES];
+    bool m_statusRegisterCached[MAX_NR_AXES];
+    bool m_bCanReadStatusRegister;   ///< cleared when "SRG?" fails, getStatus() then uses "#4"
 };
 
 #endif /* PIGCSMOTORCONTROLLER_H_ */
@@ -37,6 +37,35 @@ asynStatus PIGCSPiezoController::getStatus(PIasynAxis* pAxis, int& homing, int&
     return status;
 }
 
+/**
+ *  Read the positions of all axes with one "POS?", and the motion state of
+ *  all axes with one "#5", which getStatus() of each axis takes from the cache.
+ */
+asynStatus PIGCSPiezoController::getAllAxesState(asynAxisAxis** pAxes, int numAxes)
+{
+	asynStatus status = PIGCSController::getAllAxesState(pAxes, numAxes);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	char buf[255];
+	status = m_pInterface->sendAndReceive(char(5), buf, 99);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	m_cachedMovingState = strtol(buf, NULL, 16);
+	for (int i=0; i<numAxes; i++)
+	{
+		PIasynAxis* pAxis = (PIasynAxis*)pAxes[i];
+		if (pAxis != NULL && pAxis->getAxisNo() < int(MAX_NR_AXES))
+		{
+			m_movingStateCached[pAxis->getAxisNo()] = true;
+		}
+	}
+	return status;
+}
+
 asynStatus PIGCSPiezoController::getReferencedState(PIasynAxis* pAxis)
 {
 	pAxis->m_homed = 1;
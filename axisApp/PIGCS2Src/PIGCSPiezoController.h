@@ -38,6 +38,9 @@ public:
 
     virtual asynStatus getStatus(PIasynAxis* pAxis, int& homing, int& moving, int& negLimit, int& posLimit, int& servoControl);
     virtual asynStatus getReferencedState(PIasynAxis* pAxis);
+    virtual asynStatus getAllAxesState(asynAxisAxis** pAxes, int numAxes);
+    /// the wave generator and data recorder are used for profile moves
+    virtual bool HasWaveGenerator() { return true; }
 
 
 private:
@@ -232,3 +232,122 @@ asynStatus PIInterface::sendAndReceive(char c, char *inputBuff, int inputSize, a
     return(status);
 }
 
+
+/**
+ * Sends a query and reads a GCS reply of multiple lines, like the one of DRR?,
+ * directly into the columns of values.  The lines of the header start with '#',
+ * each other line is one row with numColumns values.
+ * Every line except the last one ends with a space, so the reply is read line
+ * by line into one small buffer, independent of the number of rows.
+ * \param[in] outputBuff The query.
+ * \param[out] values numColumns arrays of at least maxRows values.
+ * \param[in] numColumns Number of values per row.
+ * \param[in] maxRows Maximum number of rows.
+ * \param[out] numRows Number of rows read.
+ * \param[in] logSink asynUser for the trace output.
+ */
+asynStatus PIInterface::sendAndReceiveValues(const char *outputBuff, double** values, int numColumns, int maxRows, int& numRows, asynUser* logSink)
+{
+    char inputBuff[MAX_VALUES_LINE_SIZE];
+    size_t nWriteRequested=strlen(outputBuff);
+    size_t nWrite, nRead;
+    int eomReason;
+    asynStatus status;
+    bool valuesOK = true;
+
+    numRows = 0;
+    asynPrint(logSink, ASYN_TRACEIO_DRIVER,
+    		"PIInterface::sendAndReceiveValues() sending \"%s\"\n", outputBuff);
+
+    status = pasynOctetSyncIO->write(m_pAsynInterface, outputBuff,
+    		nWriteRequested, TIMEOUT, &nWrite);
+    if (nWrite != nWriteRequested)
+	{
+        asynPrint(logSink, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
+                  "PIInterface::sendAndReceiveValues error calling write, output=%s status=%d, error=%s\n",
+                  outputBuff, status, m_pAsynInterface->errorMessage);
+    	return asynError;
+	}
+
+    status = pasynOctetSyncIO->writeRead(m_pAsynInterface,
+                                         "\n", 1,
+                                         inputBuff, sizeof(inputBuff),
+                                         TIMEOUT, &nWrite, &nRead, &eomReason);
+    while (status == asynSuccess)
+    {
+        if (eomReason & ASYN_EOM_CNT)
+        {
+            asynPrint(logSink, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
+                      "PIInterface::sendAndReceiveValues line of reply to %s longer than %d\n",
+                      outputBuff, int(sizeof(inputBuff)));
+            status = asynError;
+            break;
+        }
+        inputBuff[nRead] = '\0';
+        if (nRead > 0 && inputBuff[0] != '#')
+        {
+            // the reply is read until its end, even if it is too long, so that the next reply is not mixed up with it
+            if (numRows < maxRows && valuesOK)
+            {
+                char* p = inputBuff;
+                for (int column=0; column<numColumns; column++)
+                {
+                    char* pEnd;
+                    values[column][numRows] = strtod(p, &pEnd);
+                    if (pEnd == p)
+                    {
+                        valuesOK = false;
+                        asynPrint(logSink, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
+                                  "PIInterface::sendAndReceiveValues invalid line \"%s\" of reply to %s\n",
+                                  inputBuff, outputBuff);
+                        break;
+                    }
+                    p = pEnd;
+                }
+            }
+            else if (valuesOK)
+            {
+                valuesOK = false;
+                asynPrint(logSink, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
+                          "PIInterface::sendAndReceiveValues reply to %s has more than %d rows\n",
+                          outputBuff, maxRows);
+            }
+            if (valuesOK)
+            {
+                numRows++;
+            }
+        }
+        if (nRead == 0 || inputBuff[nRead-1] != ' ')
+        {
+            break;
+        }
+        status = pasynOctetSyncIO->read(m_pAsynInterface,
+                                         inputBuff, sizeof(inputBuff),
+                                         TIMEOUT, &nRead, &eomReason);
+    }
+    if (status != asynSuccess)
+    {
+        asynPrint(logSink, ASYN_TRACE_ERROR|ASYN_TRACEIO_DRIVER,
+                  "PIInterface::sendAndReceiveValues error reading reply, output=%s status=%d, error=%s\n",
+                  outputBuff, status, m_pAsynInterface->errorMessage);
+    }
+    else if (!valuesOK)
+    {
+        status = asynError;
+    }
+    asynPrint(logSink, ASYN_TRACEIO_DRIVER,
+    		"PIInterface::sendAndReceiveValues() received %d rows of %d values\n", numRows, numColumns);
+
+    return(status);
+}
+
+asynStatus PIInterface::sendAndReceiveValues(const char *outputBuff, double** values, int numColumns, int maxRows, int& numRows)
+{
+	asynUser* logSink = m_pCurrentLogSink;
+	if (NULL == logSink)
+		logSink = m_pAsynInterface;
+	m_interfaceMutex.lock();
+	asynStatus status = sendAndReceiveValues(outputBuff, values, numColumns, maxRows, numRows, logSink);
+	m_interfaceMutex.unlock();
+	return status;
+}
@@ -36,10 +36,14 @@ public:
 	asynStatus sendAndReceive(const char* output, char *inputBuff, int inputSize);
 	asynStatus sendAndReceive(char c, char *inputBuff, int inputSize, asynUser* logSink);
 
+	asynStatus sendAndReceiveValues(const char *outputBuff, double** values, int numColumns, int maxRows, int& numRows, asynUser* logSink);
+	asynStatus sendAndReceiveValues(const char *outputBuff, double** values, int numColumns, int maxRows, int& numRows);
+
     asynUser* m_pCurrentLogSink;
 
 protected:
     static double TIMEOUT;
+    enum { MAX_VALUES_LINE_SIZE = 1024 };	///< maximum length of one line of a reply to sendAndReceiveValues()
 	epicsMutex m_interfaceMutex;
 
 	asynUser* m_pAsynInterface;
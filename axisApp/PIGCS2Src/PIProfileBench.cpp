@@ -0,0 +1,604 @@
+/* Program to check the profile move of the PI GCS2 piezo controllers, which
+ * PIasynController::buildProfile(), runProfile() and readbackProfile() run with
+ * the wave generators and the data recorder of the controller.
+ * The controller is replaced by a stand-in server on the loopback interface, an E-727
+ * with two axes, which outputs the wave tables and records positions which differ
+ * from them by DEVIATION.
+ * Measures the times to build, execute and read back a profile move, and checks the
+ * readbacks and following errors.  Then aborts a profile move during the move to the
+ * first point, which must stop the axes, and during the output of the wave tables,
+ * which must stop the wave generators.
+ *
+ * Usage: PIProfileBench [numPoints [time]]
+ *
+ * Not in the Makefile until it has been run against the stand-in.  To build it, add
+ * PROD_IOC += PIProfileBench with PIProfileBench_LIBS += PI_GCS2Support axis asyn.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <epicsThread.h>
+#include <epicsTime.h>
+#include <epicsMutex.h>
+#include <osiSock.h>
+
+#include <asynDriver.h>
+#include <asynInt32SyncIO.h>
+#include <asynFloat64SyncIO.h>
+#include <asynFloat64ArraySyncIO.h>
+#include <drvAsynIPPort.h>
+
+#include "asynAxisController.h"
+#include "asynAxisStandIn.h"
+#include "picontrollererrors.h"
+
+extern "C" int PI_GCS2_CreateController(const char *portName, const char* asynPort, int numAxes, int priority, int stackSize, int movingPollingRate, int idlePollingRate);
+extern "C" int PI_GCS2_CreateProfile(const char *portName, int maxPoints);
+
+#define DEFAULT_NUM_POINTS 200
+#define DEFAULT_TIME 0.005
+#define NUM_AXES 2
+#define MAX_POINTS 1000
+#define MAX_ARGS (2*NUM_AXES + 60)
+#define LINE_LEN 2048
+#define REPLY_LEN ((MAX_POINTS + 10) * NUM_AXES * 24)
+#define PORT_NAME "PI"
+#define GCS_PORT_NAME "PIGCS"
+#define MOVING_POLL_MS 20
+#define IDLE_POLL_MS 500
+#define TIMEOUT 2.0
+#define WAIT_PERIOD 0.01
+
+/* The stand-in controller */
+#define SERVO_CYCLE 0.0001		/* s, the wave generator outputs a point every WTR servo cycles */
+#define MOVE_TIME 0.5			/* s, every MOV takes this time */
+#define TRAVEL_MIN 0.0			/* EGU, TMN? */
+#define TRAVEL_MAX 100.0		/* EGU, TMX? */
+#define DEVIATION 0.00005		/* EGU, the recorded positions differ from the wave tables by this */
+
+/* The profile, in EGU, the resolution of PIGCSController::getResolution() */
+#define RESOLUTION 0.0001
+#define CENTER 50.0
+#define AMPLITUDE 0.5
+
+typedef struct {
+	double position;			/* where the last motion ended */
+	double moveStart;			/* the position at the start of the move */
+	double target;
+	int moving;
+	epicsTimeStamp moveTime;
+	double wave[MAX_POINTS];	/* the wave table with the same id as the axis */
+	int waveLength;
+	double waveOffset;
+	int tableRate;
+	int running;				/* the wave generator with the same id as the axis */
+	epicsTimeStamp waveTime;
+} StandInAxis;
+
+static StandInAxis standInAxes[NUM_AXES];
+static epicsMutexId standInLock;
+static int gcsError;
+static int numMoves;
+static int numStops;
+static int numWaveStarts;
+
+static double elapsed(const epicsTimeStamp *pStart)
+{
+	epicsTimeStamp now;
+
+	epicsTimeGetCurrent(&now);
+	return epicsTimeDiffInSeconds(&now, pStart);
+}
+
+/* The axis or the wave table, generator and recorder table with this name or id */
+static StandInAxis *standInAxis(const char *name)
+{
+	char *pEnd;
+	long id = strtol(name, &pEnd, 10);
+
+	if (*pEnd != '\0' || id < 1 || id > NUM_AXES) return NULL;
+	return &standInAxes[id-1];
+}
+
+/* Ends the move or the wave table when its time is over */
+static void standInUpdate(StandInAxis *pAxis)
+{
+	if (pAxis->moving && elapsed(&pAxis->moveTime) >= MOVE_TIME) {
+		pAxis->moving = 0;
+		pAxis->position = pAxis->target;
+	}
+	if (pAxis->running &&
+		elapsed(&pAxis->waveTime) >= pAxis->waveLength * pAxis->tableRate * SERVO_CYCLE) {
+		pAxis->running = 0;
+		pAxis->position = pAxis->waveOffset + pAxis->wave[pAxis->waveLength-1];
+	}
+}
+
+static double standInPosition(StandInAxis *pAxis)
+{
+	int point;
+
+	standInUpdate(pAxis);
+	if (pAxis->moving) {
+		return pAxis->moveStart +
+			(pAxis->target - pAxis->moveStart) * elapsed(&pAxis->moveTime) / MOVE_TIME;
+	}
+	if (pAxis->running) {
+		point = int(elapsed(&pAxis->waveTime) / (pAxis->tableRate * SERVO_CYCLE));
+		if (point >= pAxis->waveLength) point = pAxis->waveLength - 1;
+		return pAxis->waveOffset + pAxis->wave[point];
+	}
+	return pAxis->position;
+}
+
+static void standInStop(StandInAxis *pAxis)
+{
+	pAxis->position = standInPosition(pAxis);
+	pAxis->moving = 0;
+	pAxis->running = 0;
+}
+
+/* Appends a line of a reply, every line except the last one ends with a space */
+static int standInLine(char *reply, int len, const char *line)
+{
+	if (len > 0) {
+		reply[len-1] = ' ';
+		reply[len++] = '\n';
+	}
+	return len + sprintf(reply+len, "%s\n", line);
+}
+
+/* Answers a query of one value per axis, for all axes if none is given */
+static void standInAxisQuery(int argc, char *argv[], char *reply, double (*value)(StandInAxis *))
+{
+	char line[LINE_LEN];
+	char name[16];
+	int len = 0;
+	int i;
+
+	for (i=1; i<=NUM_AXES && argc == 1; i++) {
+		sprintf(name, "%d", i);
+		sprintf(line, "%s=%.9g", name, value(standInAxis(name)));
+		len = standInLine(reply, len, line);
+	}
+	for (i=1; i<argc; i++) {
+		if (!standInAxis(argv[i])) {
+			gcsError = PI_CNTR_ILLEGAL_AXIS;
+			reply[0] = '\0';
+			return;
+		}
+		sprintf(line, "%s=%.9g", argv[i], value(standInAxis(argv[i])));
+		len = standInLine(reply, len, line);
+	}
+}
+
+static double standInVelocity(StandInAxis *pAxis) { return 10.0; }
+static double standInTravelMin(StandInAxis *pAxis) { return TRAVEL_MIN; }
+static double standInTravelMax(StandInAxis *pAxis) { return TRAVEL_MAX; }
+
+/* The recorded positions, a header with lines starting with '#', then one row per point */
+static void standInRecorded(int argc, char *argv[], char *reply)
+{
+	StandInAxis *pAxes[NUM_AXES];
+	char line[LINE_LEN];
+	int first, num, numAxes;
+	int len = 0, lineLen;
+	int i, j, point;
+
+	if (argc < 4) {
+		gcsError = PI_CNTR_UNKNOWN_COMMAND;
+		return;
+	}
+	first = atoi(argv[1]);
+	num = atoi(argv[2]);
+	numAxes = argc - 3;
+	if (numAxes > NUM_AXES) {
+		gcsError = PI_CNTR_ILLEGAL_AXIS;
+		return;
+	}
+	for (j=0; j<numAxes; j++) {
+		pAxes[j] = standInAxis(argv[j+3]);
+		if (!pAxes[j] || !pAxes[j]->waveLength) {
+			gcsError = PI_CNTR_ILLEGAL_AXIS;
+			return;
+		}
+	}
+	if (first < 1 || num < 1 || first-1+num > MAX_POINTS) {
+		gcsError = PI_CNTR_ILLEGAL_AXIS;
+		return;
+	}
+	len = standInLine(reply, len, "# REM E-727 data recorder");
+	sprintf(line, "# NDATA = %d", num);
+	len = standInLine(reply, len, line);
+	sprintf(line, "# DIM = %d", numAxes);
+	len = standInLine(reply, len, line);
+	len = standInLine(reply, len, "# END_HEADER");
+	for (i=0; i<num; i++) {
+		lineLen = 0;
+		for (j=0; j<numAxes; j++) {
+			point = first-1+i;
+			if (point >= pAxes[j]->waveLength) point = pAxes[j]->waveLength-1;
+			lineLen += sprintf(line+lineLen, "%s%.9g", j ? " " : "",
+							   pAxes[j]->waveOffset + pAxes[j]->wave[point] + DEVIATION);
+		}
+		len = standInLine(reply, len, line);
+	}
+}
+
+/* Handles a command, reply is empty when there is none */
+static void standInCommand(char *line, char *reply)
+{
+	char *argv[MAX_ARGS];
+	char *p;
+	int argc = 0;
+	int i, mask, started;
+	StandInAxis *pAxis;
+
+	reply[0] = '\0';
+	for (p = strtok(line, " "); p && argc < MAX_ARGS; p = strtok(NULL, " ")) argv[argc++] = p;
+	if (argc == 0) return;
+
+	if (!strcmp(argv[0], "\005") || !strcmp(argv[0], "\011")) {
+		/* #5 the moving axes, #9 the running wave generators */
+		mask = 0;
+		for (i=0; i<NUM_AXES; i++) {
+			standInUpdate(&standInAxes[i]);
+			if (standInAxes[i].running || (argv[0][0] == 5 && standInAxes[i].moving)) mask |= 1 << i;
+		}
+		sprintf(reply, "0x%x\n", mask);
+	} else if (!strcmp(argv[0], "\007")) {
+		strcpy(reply, "\261\n");
+	} else if (!strcmp(argv[0], "*IDN?")) {
+		strcpy(reply, "(c)2015 Physik Instrumente (PI) GmbH & Co. KG, E-727, 0, 01.00.00\n");
+	} else if (!strcmp(argv[0], "SAI?")) {
+		for (i=1; i<=NUM_AXES; i++) sprintf(reply+strlen(reply), "%d%s", i, (i < NUM_AXES) ? " \n" : "\n");
+	} else if (!strcmp(argv[0], "ERR?")) {
+		sprintf(reply, "%d\n", gcsError);
+		gcsError = 0;
+	} else if (!strcmp(argv[0], "SPA?") && argc == 3 && standInAxis(argv[1])) {
+		sprintf(reply, "%s %s=%.9g\n", argv[1], argv[2],
+				(strtol(argv[2], NULL, 0) == 0x0E000200) ? SERVO_CYCLE : 0.0);
+	} else if (!strcmp(argv[0], "POS?")) {
+		standInAxisQuery(argc, argv, reply, standInPosition);
+	} else if (!strcmp(argv[0], "VEL?")) {
+		standInAxisQuery(argc, argv, reply, standInVelocity);
+	} else if (!strcmp(argv[0], "TMN?")) {
+		standInAxisQuery(argc, argv, reply, standInTravelMin);
+	} else if (!strcmp(argv[0], "TMX?")) {
+		standInAxisQuery(argc, argv, reply, standInTravelMax);
+	} else if (!strcmp(argv[0], "SVO") || !strcmp(argv[0], "RTR") || !strcmp(argv[0], "WSL") ||
+			   !strcmp(argv[0], "WGC") || !strcmp(argv[0], "DRC") || !strcmp(argv[0], "DRT")) {
+		/* accepted, the stand-in records every wave generator */
+	} else if (!strcmp(argv[0], "MOV")) {
+		for (i=1; i+1<argc; i+=2) {
+			pAxis = standInAxis(argv[i]);
+			if (!pAxis) {
+				gcsError = PI_CNTR_ILLEGAL_AXIS;
+				return;
+			}
+			pAxis->moveStart = standInPosition(pAxis);
+			pAxis->target = atof(argv[i+1]);
+			pAxis->moving = 1;
+			epicsTimeGetCurrent(&pAxis->moveTime);
+		}
+		numMoves++;
+	} else if (!strcmp(argv[0], "STP")) {
+		for (i=0; i<NUM_AXES; i++) standInStop(&standInAxes[i]);
+		gcsError = PI_CNTR_STOP;
+		numStops++;
+	} else if (!strcmp(argv[0], "WAV") && argc >= 6 && standInAxis(argv[1])) {
+		pAxis = standInAxis(argv[1]);
+		if (!strcmp(argv[2], "X")) pAxis->waveLength = 0;
+		for (i=6; i<argc && pAxis->waveLength < MAX_POINTS; i++) {
+			pAxis->wave[pAxis->waveLength++] = atof(argv[i]);
+		}
+		if (argc-6 != atoi(argv[5])) gcsError = PI_CNTR_UNKNOWN_COMMAND;
+	} else if ((!strcmp(argv[0], "WOS") || !strcmp(argv[0], "WTR")) && argc >= 3 && standInAxis(argv[1])) {
+		pAxis = standInAxis(argv[1]);
+		if (argv[0][1] == 'O') pAxis->waveOffset = atof(argv[2]);
+		else pAxis->tableRate = atoi(argv[2]);
+	} else if (!strcmp(argv[0], "WGO")) {
+		started = 0;
+		for (i=1; i+1<argc; i+=2) {
+			pAxis = standInAxis(argv[i]);
+			if (!pAxis || (atoi(argv[i+1]) && (!pAxis->waveLength || pAxis->tableRate < 1))) {
+				gcsError = PI_CNTR_ILLEGAL_AXIS;
+				return;
+			}
+			if (atoi(argv[i+1])) {
+				standInStop(pAxis);
+				pAxis->running = 1;
+				started = 1;
+				epicsTimeGetCurrent(&pAxis->waveTime);
+			} else if (pAxis->running) {
+				standInStop(pAxis);
+			}
+		}
+		if (started) numWaveStarts++;
+	} else if (!strcmp(argv[0], "DRR?")) {
+		standInRecorded(argc, argv, reply);
+	} else {
+		gcsError = PI_CNTR_UNKNOWN_COMMAND;
+	}
+}
+
+/* One connection, as the asyn IP port of the controller */
+static void standInConnection(SOCKET sock, void *userPvt)
+{
+	static char line[LINE_LEN];
+	static char reply[REPLY_LEN];
+	int len = 0;
+	char c;
+
+	while (recv(sock, &c, 1, 0) == 1) {
+		/* #5, #7 and #9 are single characters without a terminator */
+		if (len == 0 && (c == 5 || c == 7 || c == 9)) {
+			line[len++] = c;
+		} else if (c != '\n') {
+			if (len < LINE_LEN-1) line[len++] = c;
+			continue;
+		}
+		line[len] = '\0';
+		len = 0;
+		epicsMutexMustLock(standInLock);
+		standInCommand(line, reply);
+		epicsMutexUnlock(standInLock);
+		if (reply[0] && send(sock, reply, (int)strlen(reply), 0) != (int)strlen(reply)) break;
+	}
+	epicsSocketDestroy(sock);
+}
+
+static int standInCount(int *pCount)
+{
+	int count;
+
+	epicsMutexMustLock(standInLock);
+	count = *pCount;
+	epicsMutexUnlock(standInLock);
+	return count;
+}
+
+static int standInWaveRunning(void)
+{
+	int i, running = 0;
+
+	epicsMutexMustLock(standInLock);
+	for (i=0; i<NUM_AXES; i++) {
+		standInUpdate(&standInAxes[i]);
+		if (standInAxes[i].running) running = 1;
+	}
+	epicsMutexUnlock(standInLock);
+	return running;
+}
+
+/* The parameters of the controller, as the records of the profile move write and read them */
+static int writeInt32(const char *drvInfo, int addr, int value)
+{
+	asynUser *pasynUser;
+	asynStatus status;
+
+	if (pasynInt32SyncIO->connect(PORT_NAME, addr, &pasynUser, drvInfo)) return -1;
+	status = pasynInt32SyncIO->write(pasynUser, value, TIMEOUT);
+	pasynInt32SyncIO->disconnect(pasynUser);
+	return status ? -1 : 0;
+}
+
+static int readInt32(const char *drvInfo, int addr, int *pValue)
+{
+	asynUser *pasynUser;
+	epicsInt32 value;
+	asynStatus status;
+
+	if (pasynInt32SyncIO->connect(PORT_NAME, addr, &pasynUser, drvInfo)) return -1;
+	status = pasynInt32SyncIO->read(pasynUser, &value, TIMEOUT);
+	pasynInt32SyncIO->disconnect(pasynUser);
+	*pValue = value;
+	return status ? -1 : 0;
+}
+
+static int writeFloat64(const char *drvInfo, int addr, double value)
+{
+	asynUser *pasynUser;
+	asynStatus status;
+
+	if (pasynFloat64SyncIO->connect(PORT_NAME, addr, &pasynUser, drvInfo)) return -1;
+	status = pasynFloat64SyncIO->write(pasynUser, value, TIMEOUT);
+	pasynFloat64SyncIO->disconnect(pasynUser);
+	return status ? -1 : 0;
+}
+
+static int writeFloat64Array(const char *drvInfo, int addr, double *values, int num)
+{
+	asynUser *pasynUser;
+	asynStatus status;
+
+	if (pasynFloat64ArraySyncIO->connect(PORT_NAME, addr, &pasynUser, drvInfo)) return -1;
+	status = pasynFloat64ArraySyncIO->write(pasynUser, values, num, TIMEOUT);
+	pasynFloat64ArraySyncIO->disconnect(pasynUser);
+	return status ? -1 : 0;
+}
+
+static int readFloat64Array(const char *drvInfo, int addr, double *values, int num, int *pNumRead)
+{
+	asynUser *pasynUser;
+	size_t numRead = 0;
+	asynStatus status;
+
+	if (pasynFloat64ArraySyncIO->connect(PORT_NAME, addr, &pasynUser, drvInfo)) return -1;
+	status = pasynFloat64ArraySyncIO->read(pasynUser, values, num, &numRead, TIMEOUT);
+	pasynFloat64ArraySyncIO->disconnect(pasynUser);
+	*pNumRead = (int)numRead;
+	return status ? -1 : 0;
+}
+
+enum {
+	ABORT_NEVER,
+	ABORT_MOVE,		/* during the move to the first point */
+	ABORT_WAVE		/* during the output of the wave tables */
+};
+
+/* Executes the profile move and waits until it is done, returns the execute status or -1 */
+static int executeProfile(int abortWhen, double maxTime, double *pTime)
+{
+	int numMovesBefore = standInCount(&numMoves);
+	int numWaveStartsBefore = standInCount(&numWaveStarts);
+	int state, status;
+	epicsTimeStamp start;
+
+	epicsTimeGetCurrent(&start);
+	if (writeInt32(profileExecuteString, 0, 1)) return -1;
+	while (1) {
+		if (readInt32(profileExecuteStateString, 0, &state)) return -1;
+		if (state == PROFILE_EXECUTE_DONE) break;
+		if ((abortWhen == ABORT_MOVE && standInCount(&numMoves) > numMovesBefore) ||
+			(abortWhen == ABORT_WAVE && standInCount(&numWaveStarts) > numWaveStartsBefore)) {
+			if (writeInt32(profileAbortString, 0, 1)) return -1;
+			abortWhen = ABORT_NEVER;
+		}
+		if (elapsed(&start) > maxTime) {
+			printf("Error, the profile move did not end within %.3f s\n", maxTime);
+			return -1;
+		}
+		epicsThreadSleep(WAIT_PERIOD);
+	}
+	*pTime = elapsed(&start);
+	if (readInt32(profileExecuteStatusString, 0, &status)) return -1;
+	return status;
+}
+
+int main(int argc, char *argv[])
+{
+	int numPoints = DEFAULT_NUM_POINTS;
+	double time = DEFAULT_TIME;
+	double *positions[NUM_AXES];
+	double *readbacks;
+	double buildTime, executeTime, readbackTime, maxTime;
+	double error, maxError;
+	double pi = 4.0*atan(1.0);
+	char host[40];
+	epicsTimeStamp start;
+	int port, status, numRead, numStops0;
+	int axis, i;
+
+	if (argc > 1) numPoints = atoi(argv[1]);
+	if (argc > 2) time = atof(argv[2]);
+	if (numPoints < 2 || numPoints > MAX_POINTS || time < SERVO_CYCLE) {
+		printf("Usage: %s [numPoints [time]], numPoints 2 to %d, time a multiple of %g s\n",
+			   argv[0], MAX_POINTS, SERVO_CYCLE);
+		return 1;
+	}
+
+	standInLock = epicsMutexMustCreate();
+	port = asynAxisStandInStart("PIGCSStandIn", epicsThreadGetStackSize(epicsThreadStackMedium),
+								standInConnection, NULL);
+	if (port < 0) {
+		printf("Error starting the stand-in server\n");
+		return 1;
+	}
+	printf("Stand-in E-727 on port %d, %d axes, %d points, %g s per point\n", port, NUM_AXES, numPoints, time);
+	sprintf(host, "127.0.0.1:%d", port);
+	drvAsynIPPortConfigure(GCS_PORT_NAME, host, 0, 0, 0);
+	PI_GCS2_CreateController(PORT_NAME, GCS_PORT_NAME, NUM_AXES, 0, 0, MOVING_POLL_MS, IDLE_POLL_MS);
+	if (PI_GCS2_CreateProfile(PORT_NAME, MAX_POINTS)) {
+		printf("Error creating the profile move of %s\n", PORT_NAME);
+		return 1;
+	}
+
+	/* The parameters which the motor records and the profile move records write */
+	status = 0;
+	readbacks = (double *)calloc(numPoints, sizeof(double));
+	for (axis=0; axis<NUM_AXES; axis++) {
+		positions[axis] = (double *)calloc(numPoints, sizeof(double));
+		for (i=0; i<numPoints; i++) {
+			positions[axis][i] = CENTER + (axis+1) * AMPLITUDE * sin(2.0*pi*i/(numPoints-1));
+		}
+		status |= writeFloat64(motorRecResolutionString, axis, RESOLUTION);
+		status |= writeFloat64(motorRecOffsetString, axis, 0.0);
+		status |= writeInt32(motorRecDirectionString, axis, 0);
+		status |= writeFloat64(motorHighLimitString, axis, TRAVEL_MAX / RESOLUTION);
+		status |= writeFloat64(motorLowLimitString, axis, TRAVEL_MIN / RESOLUTION);
+		status |= writeInt32(profileUseAxisString, axis, 1);
+		status |= writeFloat64Array(profilePositionsString, axis, positions[axis], numPoints);
+	}
+	status |= writeInt32(profileNumPointsString, 0, numPoints);
+	status |= writeInt32(profileTimeModeString, 0, PROFILE_TIME_MODE_FIXED);
+	status |= writeFloat64(profileFixedTimeString, 0, time);
+	status |= writeInt32(profileMoveModeString, 0, PROFILE_MOVE_MODE_ABSOLUTE);
+	if (status) {
+		printf("Error writing the parameters of the profile move\n");
+		return 1;
+	}
+
+	epicsTimeGetCurrent(&start);
+	status = writeInt32(profileBuildString, 0, 1);
+	buildTime = elapsed(&start);
+	if (status || readInt32(profileBuildStatusString, 0, &status) || status != PROFILE_STATUS_SUCCESS) {
+		printf("Error building the profile move\n");
+		return 1;
+	}
+
+	/* The move to the first point, the wave tables, and the time to see that they are done */
+	maxTime = MOVE_TIME + numPoints*time + 5.0;
+	status = executeProfile(ABORT_NEVER, maxTime, &executeTime);
+	if (status != PROFILE_STATUS_SUCCESS) {
+		printf("Error executing the profile move, status=%d\n", status);
+		return 1;
+	}
+
+	epicsTimeGetCurrent(&start);
+	status = writeInt32(profileReadbackString, 0, 1);
+	readbackTime = elapsed(&start);
+	if (status || readInt32(profileReadbackStatusString, 0, &status) || status != PROFILE_STATUS_SUCCESS ||
+		readInt32(profileNumReadbacksString, 0, &numRead) || numRead != numPoints) {
+		printf("Error reading back the profile move\n");
+		return 1;
+	}
+	printf("build %8.3f ms, execute %8.3f s (move %.3f s, wave tables %.3f s), readback %8.3f ms\n",
+		   1e3*buildTime, executeTime, MOVE_TIME, numPoints*time, 1e3*readbackTime);
+
+	/* The recorded positions differ from the profile by DEVIATION */
+	maxError = 0.;
+	for (axis=0; axis<NUM_AXES; axis++) {
+		if (readFloat64Array(profileReadbacksString, axis, readbacks, numPoints, &numRead) || numRead != numPoints) {
+			printf("Error reading the readbacks of axis %d\n", axis);
+			return 1;
+		}
+		for (i=0; i<numPoints; i++) {
+			error = fabs(readbacks[i] - (positions[axis][i] + DEVIATION));
+			if (error > maxError) maxError = error;
+		}
+		if (readFloat64Array(profileFollowingErrorsString, axis, readbacks, numPoints, &numRead) || numRead != numPoints) {
+			printf("Error reading the following errors of axis %d\n", axis);
+			return 1;
+		}
+		for (i=0; i<numPoints; i++) {
+			error = fabs(readbacks[i] - DEVIATION);
+			if (error > maxError) maxError = error;
+		}
+	}
+	if (maxError > RESOLUTION) {
+		printf("Error, the readbacks and following errors differ by up to %g from the recorded positions\n", maxError);
+		return 1;
+	}
+	printf("The readbacks and following errors of %d points match the recorded positions\n", numPoints);
+
+	/* An abort during the move to the first point stops the axes */
+	numStops0 = standInCount(&numStops);
+	status = executeProfile(ABORT_MOVE, maxTime, &executeTime);
+	if (status != PROFILE_STATUS_ABORT || standInCount(&numStops) == numStops0) {
+		printf("Error, the abort during the move to the first point did not stop the axes, status=%d\n", status);
+		return 1;
+	}
+	printf("Aborted during the move to the first point after %.3f s, the axes were stopped\n", executeTime);
+
+	/* An abort during the wave tables stops the wave generators */
+	status = executeProfile(ABORT_WAVE, maxTime, &executeTime);
+	if (status != PROFILE_STATUS_ABORT || standInWaveRunning()) {
+		printf("Error, the abort during the wave tables did not stop the wave generators, status=%d\n", status);
+		return 1;
+	}
+	printf("Aborted during the wave tables after %.3f s, the wave generators were stopped\n", executeTime);
+	return 0;
+}
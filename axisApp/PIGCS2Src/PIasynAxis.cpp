@@ -67,6 +67,8 @@ PIasynAxis::PIasynAxis(PIasynController *pController, PIGCSController* pGCSContr
 
       printf("PIasynAxis::PIasynAxis() %d: %s\n",
   			  axis, m_szAxisName);
+      // MOV sets a new target while the axis moves, for the software profile move
+      setMovesWhileMoving(true);
 }
 
 
@@ -138,9 +140,7 @@ asynStatus PIasynAxis::poll(bool *returnMoving)
 		{
 			m_bServoControl = (servoControl == 1);
 			m_pGCSController->getAxisPositionCts(this);
-			double realPosition;
-			m_pGCSController->getAxisPosition(this, realPosition);
-			setDoubleParam(pController_->PI_SUP_POSITION,      realPosition );
+			setDoubleParam(pController_->PI_SUP_POSITION,      m_position );
 		}
     }
     if (m_isHoming)
@@ -222,7 +222,7 @@ asynStatus PIasynAxis::move(double position, int relative, double minVelocity, d
 
 		status = m_pGCSController->moveCts(this, position);
    }
-    epicsEventSignal(pController_->pollEventId_);
+    pController_->wakeupPoller();
 
     asynPrint(pasynUser_, ASYN_TRACE_FLOW,
         "%s:%s: Set driver %s, axis %d move to %f, min vel=%f, max_vel=%f, accel=%f, deffered=%d - status=%d\n",
@@ -258,7 +258,7 @@ asynStatus PIasynAxis::moveVelocity(double minVelocity, double maxVelocity, doub
     m_pGCSController->setVelocityCts(this, maxVelocity);
     m_pGCSController->move(this, target);
 
-    epicsEventSignal(pController_->pollEventId_);
+    pController_->wakeupPoller();
 
     asynPrint(pasynUser_, ASYN_TRACE_FLOW,
         "%s:%s: Set port %s, axis %d move with velocity of %f, accel=%f / target %f - AFTER MOV\n",
@@ -275,7 +275,7 @@ asynStatus PIasynAxis::stop(double acceleration)
 
     m_pGCSController->haltAxis(this);
 
-    epicsEventSignal(pController_->pollEventId_);
+    pController_->wakeupPoller();
 
     asynPrint(pasynUser_, ASYN_TRACE_FLOW,
         "%s:%s: Set axis %d to stop with accel=%f",
@@ -301,7 +301,7 @@ asynStatus PIasynAxis::home(double minVelocity, double maxVelocity, double accel
     	return status;
     }
     setIntegerParam(pController_->motorStatusHomed_, m_homed );
-    epicsEventSignal(pController_->pollEventId_);
+    pController_->wakeupPoller();
 
     asynPrint(pasynUser_, ASYN_TRACE_FLOW,
         "%s:%s: Set driver %s, axis %d to home %s, min vel=%f, max_vel=%f, accel=%f",
@@ -314,7 +314,7 @@ asynStatus PIasynAxis::setPosition(double position)
 	m_pGCSController->m_pInterface->m_pCurrentLogSink = pasynUser_;
 	asynStatus status = asynError;
 	status = m_pGCSController->setAxisPositionCts(this, position);
-    epicsEventSignal(pController_->pollEventId_);
+    pController_->wakeupPoller();
 
     asynPrint(pasynUser_, ASYN_TRACE_FLOW,
         "%s:%s: Set driver %s, axis %d set position to %f - status=%d\n",
@@ -25,8 +25,10 @@ Based on drvMotorSim.c, Mark Rivers, December 13, 2009
 
 #include <epicsTime.h>
 #include <epicsThread.h>
+#include <epicsEvent.h>
 #include <epicsString.h>
 #include <epicsMutex.h>
+#include <epicsMath.h>
 #include <ellLib.h>
 #include <iocsh.h>
 #include <asynOctetSyncIO.h>
@@ -47,6 +49,13 @@ Based on drvMotorSim.c, Mark Rivers, December 13, 2009
 
 static const char *driverName = "PIasynDriver";
 
+/** Time between the checks whether the wave generators of a profile move are still running */
+#define PROFILE_WAIT_PERIOD 0.1
+/** Time after the end of a profile move until the wave generators must have stopped */
+#define PROFILE_STOP_TIMEOUT 5.0
+
+static void PIProfileThreadC(void *pPvt);
+
 
 static ELLLIST PIasynControllerList;
 static int PIasynControllerListInitialized = 0;
@@ -60,6 +69,14 @@ PIasynController::PIasynController(const char *portName, const char* asynPort, i
             priority, stackSize)
 	, movesDeferred( 0 )
 	, m_pGCSController( NULL )
+	, m_bWaveProfile( false )
+	, m_profileNumBuilt( 0 )
+	, m_profileTableRate( 1 )
+	, m_profileNumExecuted( 0 )
+	, m_profileAbort( false )
+	, m_profileWaveBuffer( NULL )
+	, m_profileExecuteEvent( NULL )
+	, m_profileAbortEvent( NULL )
 {
     createParam(PI_SUP_POSITION_String,		asynParamFloat64,	&PI_SUP_POSITION);
     createParam(PI_SUP_TARGET_String,		asynParamFloat64,	&PI_SUP_TARGET);
@@ -234,7 +251,7 @@ asynStatus PIasynController::processDeferredMoves()
         	getPIAxis(axis)->deferred_move = 0;
         }
     }
-    epicsEventSignal(pollEventId_);
+    wakeupPoller();
 
     return status;
 }
@@ -371,18 +388,566 @@ asynStatus PIasynController::writeFloat64(asynUser *pasynUser, epicsFloat64 valu
 
 
 
+/**
+ * Profile move of one axis, from the older motor interface.
+ * The positions are used as the profile of the axis, which is the only one used,
+ * and the profile is built.  Without trigger it is executed at once,
+ * otherwise triggerProfile() executes it.
+ */
 asynStatus PIasynController::profileMove(asynUser *pasynUser, int npoints, double positions[], double times[], int relative, int trigger )
 {
-	asynPrint(pasynUser, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
-			"PIasynController::profileMove() - not implemented\n");
-	return asynError;
+	PIasynAxis* pAxis = getPIAxis(pasynUser);
+	if (!m_bWaveProfile || pAxis == NULL || npoints < 2 || npoints > int(maxProfilePoints_))
+	{
+		asynPrint(pasynUser, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
+				"PIasynController::profileMove() - no profile move with %d points, see PI_GCS2_CreateProfile\n", npoints);
+		return asynError;
+	}
+	for (int axis=0; axis<numAxes_; axis++)
+	{
+		setIntegerParam(axis, profileUseAxis_, (axis == pAxis->getAxisNo()) ? 1 : 0);
+	}
+	asynStatus status = pAxis->defineProfile(positions, npoints);
+	if (status != asynSuccess)
+	{
+		return status;
+	}
+	memcpy(profileTimes_, times, npoints*sizeof(double));
+	setIntegerParam(profileNumPoints_, npoints);
+	setIntegerParam(profileTimeMode_, PROFILE_TIME_MODE_ARRAY);
+	setIntegerParam(profileMoveMode_, relative ? PROFILE_MOVE_MODE_RELATIVE : PROFILE_MOVE_MODE_ABSOLUTE);
+	status = buildProfile();
+	if (status == asynSuccess && !trigger)
+	{
+		status = executeProfile();
+	}
+	return status;
 }
 
 asynStatus PIasynController::triggerProfile(asynUser *pasynUser)
 {
-	asynPrint(pasynUser, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
-			"PIasynController::profileMove() - not implemented\n");
-	return asynError;
+	if (!m_bWaveProfile)
+	{
+		asynPrint(pasynUser, ASYN_TRACE_FLOW|ASYN_TRACE_ERROR,
+				"PIasynController::triggerProfile() - no profile move, see PI_GCS2_CreateProfile\n");
+		return asynError;
+	}
+	return executeProfile();
+}
+
+/**
+ * Enable the profile moves, which use the wave generator and the data recorder
+ * of the controller.  Called from PI_GCS2_CreateProfile.
+ * \param[in] maxPoints The maximum number of profile points, which must fit
+ *            into a wave table and a data recorder table of the controller.
+ */
+asynStatus PIasynController::createProfile(size_t maxPoints)
+{
+	static const char *functionName = "createProfile";
+
+	if (m_pGCSController == NULL || !m_pGCSController->HasWaveGenerator())
+	{
+		asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+				"%s:%s: Error, the controller of port %s has no wave generator\n",
+				driverName, functionName, portName);
+		return asynError;
+	}
+	if (softwareProfile_ || maxPoints < 2)
+	{
+		asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+				"%s:%s: Error, the software profile move is enabled, or invalid maximum number of points %d\n",
+				driverName, functionName, int(maxPoints));
+		return asynError;
+	}
+	lock();
+	initializeProfile(maxPoints);
+	if (m_profileWaveBuffer != NULL)
+	{
+		free(m_profileWaveBuffer);
+	}
+	m_profileWaveBuffer = (double *)calloc(maxPoints, sizeof(double));
+	m_profileNumBuilt = 0;
+	m_profileNumExecuted = 0;
+	if (!m_bWaveProfile)
+	{
+		m_profileExecuteEvent = epicsEventMustCreate(epicsEventEmpty);
+		m_profileAbortEvent = epicsEventMustCreate(epicsEventEmpty);
+		m_bWaveProfile = true;
+		epicsThreadCreate("PIProfile",
+				epicsThreadPriorityMedium,
+				epicsThreadGetStackSize(epicsThreadStackMedium),
+				(EPICSTHREADFUNC)PIProfileThreadC, (void *)this);
+	}
+	unlock();
+	return asynSuccess;
+}
+
+/** Fills pAxesArray with the axes which are used in the profile move, returns their number. */
+int PIasynController::getProfileAxes(PIasynAxis** pAxesArray)
+{
+	int numUsed = 0;
+	int useAxis;
+
+	for (int axis=0; axis<numAxes_; axis++)
+	{
+		PIasynAxis* pAxis = getPIAxis(axis);
+		if (pAxis == NULL) continue;
+		getIntegerParam(axis, profileUseAxis_, &useAxis);
+		if (useAxis) pAxesArray[numUsed++] = pAxis;
+	}
+	return numUsed;
+}
+
+/** Converts counts as used in EPICS to the physical units (EGU) of the controller. */
+double PIasynController::ctsToEGU(PIasynAxis* pAxis, double cts)
+{
+	if (pAxis->m_CPUdenominator == 0 || pAxis->m_CPUnumerator == 0)
+	{
+		return cts;
+	}
+	return cts * pAxis->m_CPUdenominator / pAxis->m_CPUnumerator;
+}
+
+/**
+ * Build a profile move: the positions of each axis are stored in its wave table.
+ * The wave generator outputs a point every m_profileTableRate servo cycles,
+ * so all points must have the same time, which must be a multiple of the servo cycle time.
+ */
+asynStatus PIasynController::buildProfile()
+{
+	int i;
+	int numPoints;
+	int numUsed;
+	int moveMode;
+	double time;
+	double cycleTime = 0.0;
+	int tableRate = 0;
+	bool buildOK = true;
+	char message[MAX_CONTROLLER_STRING_SIZE];
+	PIasynAxis* pAxesArray[PIGCSController::MAX_NR_AXES];
+	static const char *functionName = "buildProfile";
+
+	if (!m_bWaveProfile)
+	{
+		return asynAxisController::buildProfile();
+	}
+	/* Fills the times in PROFILE_TIME_MODE_FIXED */
+	asynAxisController::buildProfile();
+
+	strcpy(message, "");
+	setStringParam(profileBuildMessage_, message);
+	setIntegerParam(profileBuildState_, PROFILE_BUILD_BUSY);
+	setIntegerParam(profileBuildStatus_, PROFILE_STATUS_UNDEFINED);
+	callParamCallbacks();
+	m_pGCSController->m_pInterface->m_pCurrentLogSink = pasynUserSelf;
+
+	m_profileNumBuilt = 0;
+	getIntegerParam(profileNumPoints_, &numPoints);
+	getIntegerParam(profileMoveMode_, &moveMode);
+	if ((numPoints < 2) || (numPoints > (int)maxProfilePoints_))
+	{
+		buildOK = false;
+		epicsSnprintf(message, sizeof(message), "Invalid number of points %d, must be 2 to %d",
+				numPoints, (int)maxProfilePoints_);
+		goto done;
+	}
+	time = profileTimes_[0];
+	for (i=0; i<numPoints-1; i++)
+	{
+		if (!(profileTimes_[i] > 0.) || !isfinite(profileTimes_[i]))
+		{
+			buildOK = false;
+			epicsSnprintf(message, sizeof(message), "Negative, null or invalid time at point %d", i);
+			goto done;
+		}
+		if (fabs(profileTimes_[i] - time) > 1e-6 * time)
+		{
+			buildOK = false;
+			epicsSnprintf(message, sizeof(message), "Time at point %d differs, the wave generator needs the same time for all points", i);
+			goto done;
+		}
+	}
+	if (m_pGCSController->getServoCycleTime(cycleTime) != asynSuccess)
+	{
+		buildOK = false;
+		strcpy(message, "Error reading the servo cycle time");
+		goto done;
+	}
+	tableRate = int(time / cycleTime + 0.5);
+	if ((tableRate < 1) || (fabs(tableRate*cycleTime - time) > 0.01*cycleTime))
+	{
+		buildOK = false;
+		epicsSnprintf(message, sizeof(message), "Time %g s is not a multiple of the servo cycle time %g s",
+				time, cycleTime);
+		goto done;
+	}
+	numUsed = getProfileAxes(pAxesArray);
+	if (numUsed == 0)
+	{
+		buildOK = false;
+		strcpy(message, "No axis is used");
+		goto done;
+	}
+	if (checkProfileKinematics(numPoints, moveMode == PROFILE_MOVE_MODE_ABSOLUTE,
+				message, sizeof(message)))
+	{
+		buildOK = false;
+		goto done;
+	}
+	/* In PROFILE_MOVE_MODE_RELATIVE the position is the wave offset of the axis */
+	for (int j=0; j<numUsed; j++)
+	{
+		PIasynAxis* pAxis = pAxesArray[j];
+		for (i=0; i<numPoints; i++)
+		{
+			m_profileWaveBuffer[i] = ctsToEGU(pAxis, pAxis->profilePositions_[i]);
+		}
+		if (m_pGCSController->defineWaveTable(pAxis, m_profileWaveBuffer, numPoints) != asynSuccess)
+		{
+			buildOK = false;
+			epicsSnprintf(message, sizeof(message), "Error storing the wave table of axis %d", pAxis->getAxisNo());
+			goto done;
+		}
+	}
+	m_profileNumBuilt = numPoints;
+	m_profileTableRate = tableRate;
+
+	done:
+	asynPrint(pasynUserSelf, ASYN_TRACE_FLOW,
+			"%s:%s: numPoints=%d, servo cycle=%g, table rate=%d\n",
+			driverName, functionName, numPoints, cycleTime, tableRate);
+	setIntegerParam(profileBuildStatus_, buildOK ? PROFILE_STATUS_SUCCESS : PROFILE_STATUS_FAILURE);
+	setStringParam(profileBuildMessage_, message);
+	if (!buildOK)
+	{
+		asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+				"%s:%s: %s\n",
+				driverName, functionName, message);
+	}
+	/* Clear build command.  This is a "busy" record, don't want to do this until build is complete. */
+	setIntegerParam(profileBuild_, 0);
+	setIntegerParam(profileBuildState_, PROFILE_BUILD_DONE);
+	callParamCallbacks();
+	return buildOK ? asynSuccess : asynError;
+}
+
+/** Execute a profile move, which runProfile() does in the profile thread. */
+asynStatus PIasynController::executeProfile()
+{
+	int executeState;
+	static const char *functionName = "executeProfile";
+
+	if (!m_bWaveProfile)
+	{
+		return asynAxisController::executeProfile();
+	}
+	getIntegerParam(profileExecuteState_, &executeState);
+	if (executeState != PROFILE_EXECUTE_DONE)
+	{
+		asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+				"%s:%s: Error, the profile move is already executing\n",
+				driverName, functionName);
+		return asynError;
+	}
+	/* Set the state now, so that it is busy before the thread runs,
+	 * and an abort before the thread runs is not lost */
+	m_profileAbort = false;
+	epicsEventTryWait(m_profileAbortEvent);
+	setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_MOVE_START);
+	callParamCallbacks();
+	epicsEventSignal(m_profileExecuteEvent);
+	return asynSuccess;
+}
+
+/** Abort a profile move, runProfile() stops the wave generators. */
+asynStatus PIasynController::abortProfile()
+{
+	int executeState;
+
+	if (m_bWaveProfile)
+	{
+		getIntegerParam(profileExecuteState_, &executeState);
+		if (executeState != PROFILE_EXECUTE_DONE)
+		{
+			m_profileAbort = true;
+			epicsEventSignal(m_profileAbortEvent);
+		}
+	}
+	return asynAxisController::abortProfile();
+}
+
+/* C Function which runs the profile thread */
+static void PIProfileThreadC(void *pPvt)
+{
+	PIasynController *pC = (PIasynController*)pPvt;
+	pC->profileThread();
+}
+
+/** The thread which runs the profile moves, started by createProfile(). */
+void PIasynController::profileThread()
+{
+	while (true)
+	{
+		epicsEventMustWait(m_profileExecuteEvent);
+		runProfile();
+	}
+}
+
+/**
+ * Runs a profile move.  The axes move to the first point, then the wave generators
+ * of all axes are started with one WGO, and the data recorder records the actual
+ * position of each axis at each point.
+ * Called from profileThread() without the lock, the lock is released while waiting.
+ */
+asynStatus PIasynController::runProfile()
+{
+	int j;
+	int numPoints = 0;
+	int numUsed = 0;
+	int point = 0;
+	int moveMode;
+	int axisDone;
+	bool allDone;
+	bool running;
+	bool executeOK = true;
+	bool aborted = false;
+	double time = 0.0;
+	double elapsed;
+	double pollPeriod;
+	char message[MAX_CONTROLLER_STRING_SIZE];
+	PIasynAxis* pAxesArray[PIGCSController::MAX_NR_AXES];
+	int targetsCts[PIGCSController::MAX_NR_AXES];
+	double offsets[PIGCSController::MAX_NR_AXES];
+	epicsTimeStamp startTime, nowTime;
+	static const char *functionName = "runProfile";
+
+	lock();
+	m_pGCSController->m_pInterface->m_pCurrentLogSink = pasynUserSelf;
+	strcpy(message, "");
+	setIntegerParam(profileExecuteStatus_, PROFILE_STATUS_UNDEFINED);
+	setStringParam(profileExecuteMessage_, message);
+	setIntegerParam(profileCurrentPoint_, 0);
+	setIntegerParam(profileNumReadbacks_, 0);
+	callParamCallbacks();
+	m_profileNumExecuted = 0;
+	if (m_profileNumBuilt < 2)
+	{
+		executeOK = false;
+		strcpy(message, "The profile has not been built");
+		goto done;
+	}
+	numPoints = m_profileNumBuilt;
+	time = profileTimes_[0];
+	numUsed = getProfileAxes(pAxesArray);
+	getIntegerParam(profileMoveMode_, &moveMode);
+
+	/* Move to the first point */
+	for (j=0; j<numUsed; j++)
+	{
+		PIasynAxis* pAxis = pAxesArray[j];
+		int axis = pAxis->getAxisNo();
+		m_profileOffsets[axis] = 0.0;
+		if (moveMode == PROFILE_MOVE_MODE_RELATIVE) getDoubleParam(axis, motorPosition_, &m_profileOffsets[axis]);
+		targetsCts[j] = int(floor(m_profileOffsets[axis] + pAxis->profilePositions_[0] + 0.5));
+		offsets[j] = ctsToEGU(pAxis, m_profileOffsets[axis]);
+		pAxis->setIntegerParam(motorStatusDone_, 0);
+		pAxis->callParamCallbacks();
+	}
+	if (m_pGCSController->moveCts(pAxesArray, targetsCts, numUsed) != asynSuccess)
+	{
+		executeOK = false;
+		strcpy(message, "Error moving to the first point");
+		goto done;
+	}
+	wakeupPoller();
+	pollPeriod = (movingPollPeriod_ > 0.0) ? movingPollPeriod_ : PROFILE_WAIT_PERIOD;
+	while (1)
+	{
+		allDone = true;
+		for (j=0; j<numUsed; j++)
+		{
+			getIntegerParam(pAxesArray[j]->getAxisNo(), motorStatusDone_, &axisDone);
+			if (!axisDone) allDone = false;
+		}
+		if (allDone) break;
+		unlock();
+		epicsEventWaitWithTimeout(m_profileAbortEvent, pollPeriod);
+		lock();
+		if (m_profileAbort)
+		{
+			/* The wave generators have not been started, stop the move to the first point */
+			aborted = true;
+			m_pGCSController->m_pInterface->m_pCurrentLogSink = pasynUserSelf;
+			for (j=0; j<numUsed; j++)
+			{
+				m_pGCSController->haltAxis(pAxesArray[j]);
+			}
+			wakeupPoller();
+			goto done;
+		}
+	}
+
+	/* Start the wave generators, clearing the readbacks of the last profile move */
+	profileReadbackGeneration_++;
+	for (j=0; j<numAxes_; j++)
+	{
+		PIasynAxis* pAxis = getPIAxis(j);
+		if (pAxis == NULL) continue;
+		memset(pAxis->profileReadbacks_,       0, maxProfilePoints_*sizeof(double));
+		memset(pAxis->profileFollowingErrors_, 0, maxProfilePoints_*sizeof(double));
+	}
+	m_pGCSController->m_pInterface->m_pCurrentLogSink = pasynUserSelf;
+	if (m_pGCSController->startWaveGenerators(pAxesArray, offsets, numUsed, m_profileTableRate) != asynSuccess)
+	{
+		executeOK = false;
+		strcpy(message, "Error starting the wave generators");
+		m_pGCSController->stopWaveGenerators(pAxesArray, numUsed);
+		goto done;
+	}
+	epicsTimeGetCurrent(&startTime);
+	setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_EXECUTING);
+	callParamCallbacks();
+	wakeupPoller();
+
+	/* Wait until the wave generators have output the wave tables */
+	point = 1;
+	while (1)
+	{
+		unlock();
+		epicsEventWaitWithTimeout(m_profileAbortEvent, PROFILE_WAIT_PERIOD);
+		lock();
+		epicsTimeGetCurrent(&nowTime);
+		elapsed = epicsTimeDiffInSeconds(&nowTime, &startTime);
+		point = int(elapsed / time) + 1;
+		if (point > numPoints) point = numPoints;
+		setIntegerParam(profileCurrentPoint_, point);
+		callParamCallbacks();
+		if (m_profileAbort)
+		{
+			aborted = true;
+			break;
+		}
+		m_pGCSController->m_pInterface->m_pCurrentLogSink = pasynUserSelf;
+		if (m_pGCSController->getWaveGeneratorsRunning(pAxesArray, numUsed, running) != asynSuccess)
+		{
+			executeOK = false;
+			strcpy(message, "Error reading the state of the wave generators");
+			break;
+		}
+		if (!running)
+		{
+			point = numPoints;
+			break;
+		}
+		if (elapsed > time*(numPoints-1) + PROFILE_STOP_TIMEOUT)
+		{
+			executeOK = false;
+			strcpy(message, "The wave generators did not stop");
+			break;
+		}
+	}
+	m_pGCSController->stopWaveGenerators(pAxesArray, numUsed);
+	m_profileNumExecuted = point;
+	setIntegerParam(profileCurrentPoint_, point);
+	wakeupPoller();
+	asynPrint(pasynUserSelf, ASYN_TRACE_FLOW,
+			"%s:%s: done, numPoints=%d, executed=%d\n",
+			driverName, functionName, numPoints, point);
+
+	done:
+	if (aborted)
+	{
+		strcpy(message, "Profile move aborted");
+	}
+	else if (!executeOK)
+	{
+		asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+				"%s:%s: %s\n",
+				driverName, functionName, message);
+	}
+	setIntegerParam(profileExecuteStatus_, aborted ? PROFILE_STATUS_ABORT :
+			executeOK ? PROFILE_STATUS_SUCCESS : PROFILE_STATUS_FAILURE);
+	setStringParam(profileExecuteMessage_, message);
+	/* Clear execute command.  This is a "busy" record, don't want to do this until execution is complete. */
+	setIntegerParam(profileExecute_, 0);
+	setIntegerParam(profileExecuteState_, PROFILE_EXECUTE_DONE);
+	callParamCallbacks();
+	unlock();
+	return (executeOK && !aborted) ? asynSuccess : asynError;
+}
+
+/**
+ * Read the positions which the data recorder recorded during the last profile move,
+ * and compute the following errors in counts.  asynAxisController::readbackProfile()
+ * converts them to user units and posts them.
+ */
+asynStatus PIasynController::readbackProfile()
+{
+	int i, j;
+	int numUsed;
+	int numReadbacks;
+	bool readbackOK = true;
+	char message[MAX_CONTROLLER_STRING_SIZE];
+	PIasynAxis* pAxesArray[PIGCSController::MAX_NR_AXES];
+	double* positions[PIGCSController::MAX_NR_AXES];
+	static const char *functionName = "readbackProfile";
+
+	if (!m_bWaveProfile)
+	{
+		return asynAxisController::readbackProfile();
+	}
+	strcpy(message, "");
+	setStringParam(profileReadbackMessage_, message);
+	setIntegerParam(profileReadbackState_, PROFILE_READBACK_BUSY);
+	setIntegerParam(profileReadbackStatus_, PROFILE_STATUS_UNDEFINED);
+	callParamCallbacks();
+	m_pGCSController->m_pInterface->m_pCurrentLogSink = pasynUserSelf;
+
+	numReadbacks = m_profileNumExecuted;
+	numUsed = getProfileAxes(pAxesArray);
+	if (numReadbacks > 0 && numUsed > 0)
+	{
+		for (j=0; j<numUsed; j++)
+		{
+			positions[j] = pAxesArray[j]->profileReadbacks_;
+		}
+		if (m_pGCSController->readRecordedPositions(pAxesArray, numUsed, 0, numReadbacks, positions) != asynSuccess)
+		{
+			readbackOK = false;
+			strcpy(message, "Error reading the data recorder");
+			numReadbacks = 0;
+		}
+		for (j=0; j<numUsed && readbackOK; j++)
+		{
+			PIasynAxis* pAxis = pAxesArray[j];
+			double offset = m_profileOffsets[pAxis->getAxisNo()];
+			for (i=0; i<numReadbacks; i++)
+			{
+				if (pAxis->m_CPUdenominator != 0 && pAxis->m_CPUnumerator != 0)
+				{
+					pAxis->profileReadbacks_[i] = pAxis->profileReadbacks_[i] * pAxis->m_CPUnumerator / pAxis->m_CPUdenominator;
+				}
+				pAxis->profileFollowingErrors_[i] = pAxis->profileReadbacks_[i] - (offset + pAxis->profilePositions_[i]);
+			}
+		}
+	}
+	setIntegerParam(profileNumReadbacks_, numReadbacks);
+	setIntegerParam(profileActualPulses_, numReadbacks);
+	/* Converts to user units and posts the arrays */
+	asynAxisController::readbackProfile();
+	if (!readbackOK)
+	{
+		asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+				"%s:%s: %s\n",
+				driverName, functionName, message);
+	}
+	setIntegerParam(profileReadbackStatus_, readbackOK ? PROFILE_STATUS_SUCCESS : PROFILE_STATUS_FAILURE);
+	setStringParam(profileReadbackMessage_, message);
+	/* Clear readback command.  This is a "busy" record, don't want to do this until readback is complete. */
+	setIntegerParam(profileReadback_, 0);
+	setIntegerParam(profileReadbackState_, PROFILE_READBACK_DONE);
+	callParamCallbacks();
+	return readbackOK ? asynSuccess : asynError;
 }
 
 asynStatus PIasynController::configAxis(PIasynAxis *pAxis)
@@ -418,7 +983,7 @@ asynStatus PIasynController::configAxis(PIasynAxis *pAxis)
 
     /* Send a signal to the poller task which will make it do a poll,
      * updating values for this axis to use the new resolution (stepSize) */
-    epicsEventSignal(pollEventId_);
+    wakeupPoller();
 
     return(asynSuccess);
 }
@@ -485,7 +1050,23 @@ asynStatus PIasynController::configAxis(PIasynAxis *pAxis)
 
 asynStatus PIasynController::poll()
 {
+    asynAxisAxis* pDueAxes[PIGCSController::MAX_NR_AXES];
+    int numDue = 0;
+
     m_pGCSController->getGlobalState(pAxes_, numAxes_);
+    // one query per value for the axes which are polled in this cycle instead of one per axis,
+    // PIasynAxis::poll() uses the cached values
+    for (int i=0; i<numPollDueAxes_ && numDue<int(PIGCSController::MAX_NR_AXES); i++)
+    {
+        if (pAxes_[pollDueAxes_[i]] != NULL)
+        {
+            pDueAxes[numDue++] = pAxes_[pollDueAxes_[i]];
+        }
+    }
+    if (numDue > 0)
+    {
+        m_pGCSController->getAllAxesState(pDueAxes, numDue);
+    }
 
     setDoubleParam( 0, PI_SUP_RBPIVOT_X, m_pGCSController->GetPivotX());
     setDoubleParam( 0, PI_SUP_RBPIVOT_Y, m_pGCSController->GetPivotY());
@@ -497,6 +1078,12 @@ asynStatus PIasynController::poll()
     return asynSuccess;
 }
 
+/** The values which poll() cached, and an axis did not use, are not used outside of the poll cycle */
+void PIasynController::pollFinished()
+{
+    m_pGCSController->clearCachedState();
+}
+
 
 /** Configuration command, called directly or from iocsh */
 extern "C" int PI_GCS2_CreateController(const char *portName, const char* asynPort, int numAxes, int priority, int stackSize, int movingPollingRate, int idlePollingRate)
@@ -527,9 +1114,33 @@ static void PI_GCS2_CreateControllerCallFunc(const iocshArgBuf *args)
 }
 
 
+/** Enables the profile moves with the wave generator, called directly or from iocsh */
+extern "C" int PI_GCS2_CreateProfile(const char *portName, int maxPoints)
+{
+    PIasynController *pC = (PIasynController*) findAsynPortDriver(portName);
+    if (!pC)
+    {
+        printf("%s:PI_GCS2_CreateProfile: Error port %s not found\n", driverName, portName);
+        return asynError;
+    }
+    return pC->createProfile(maxPoints);
+}
+
+static const iocshArg PI_GCS2_CreateProfileArg0 = {"Port name", iocshArgString};
+static const iocshArg PI_GCS2_CreateProfileArg1 = {"Max points", iocshArgInt};
+static const iocshArg * const PI_GCS2_CreateProfileArgs[] = {&PI_GCS2_CreateProfileArg0,
+                                                             &PI_GCS2_CreateProfileArg1};
+static const iocshFuncDef PI_GCS2_CreateProfileDef = {"PI_GCS2_CreateProfile", 2, PI_GCS2_CreateProfileArgs};
+static void PI_GCS2_CreateProfileCallFunc(const iocshArgBuf *args)
+{
+    PI_GCS2_CreateProfile(args[0].sval, args[1].ival);
+}
+
+
 static void PIasynDriverRegister(void)
 {
     iocshRegister(&PI_GCS2_CreateControllerDef, PI_GCS2_CreateControllerCallFunc);
+    iocshRegister(&PI_GCS2_CreateProfileDef, PI_GCS2_CreateProfileCallFunc);
 }
 
 extern "C" {
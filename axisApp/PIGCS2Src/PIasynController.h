@@ -18,11 +18,13 @@ December 13, 2009
 #ifndef PI_ASYN_DRIVER_INCLUDED_
 #define PI_ASYN_DRIVER_INCLUDED_
 
+#include <epicsEvent.h>
+
 #include "asynAxisController.h"
 #include "asynAxisAxis.h"
+#include "PIGCSController.h"
 
 class PIasynAxis;
-class PIGCSController;
 
 class PIasynController : asynAxisController {
 public:
@@ -38,6 +40,15 @@ public:
     PIasynAxis* getPIAxis(int axisNo) { return (PIasynAxis*)asynAxisController::getAxis(axisNo); }
 
     virtual asynStatus poll();
+    virtual void pollFinished();
+
+    /* Profile moves with the wave generator and data recorder of the controller */
+    asynStatus createProfile(size_t maxPoints);
+    virtual asynStatus buildProfile();
+    virtual asynStatus executeProfile();
+    virtual asynStatus abortProfile();
+    virtual asynStatus readbackProfile();
+    void profileThread();  // This should be private but is called from C function
 
     friend class PIasynAxis;
 
@@ -51,6 +62,20 @@ private:
     
     PIGCSController* m_pGCSController;
 
+    asynStatus runProfile();
+    int getProfileAxes(PIasynAxis** pAxesArray);
+    double ctsToEGU(PIasynAxis* pAxis, double cts);
+
+    bool m_bWaveProfile;                ///< createProfile() has been called, the profile moves use the wave generator
+    int m_profileNumBuilt;              ///< number of points of the last successful buildProfile(), 0 if it failed
+    int m_profileTableRate;             ///< servo cycles per profile point of the built profile
+    int m_profileNumExecuted;           ///< number of points which the last profile move has recorded
+    bool m_profileAbort;                ///< abortProfile() has been called
+    double* m_profileWaveBuffer;        ///< profile positions of one axis in EGU
+    double m_profileOffsets[PIGCSController::MAX_NR_AXES];  ///< per axis, the wave offset of the profile move in counts
+    epicsEventId m_profileExecuteEvent; ///< wakes up profileThread()
+    epicsEventId m_profileAbortEvent;   ///< ends the waits of runProfile()
+
     int PI_SUP_POSITION;
     int PI_SUP_TARGET;
     int PI_SUP_SERVO;
@@ -0,0 +1,315 @@
+#!/usr/bin/python
+
+"""
+Description: Poll throughput benchmark of an EthercatMCController,
+             running against the simulator.
+             Started from run-EthercatMC-bench.sh
+
+Measures:
+  poll rate and poll cycle times, from the timing histograms of the driver
+  round trip times to the simulator, from the timing histograms
+  move start latency: caput of .VAL until the simulator is busy,
+                      and until .MOVN is 1
+  DMOV latency:       the simulator is done until .DMOV is 1
+
+The simulator is polled over its own connection, which is independent
+of the connection of the IOC.
+"""
+
+from __future__ import print_function
+
+import json
+import optparse
+import socket
+import sys
+import threading
+import time
+
+import epics
+
+PV_TIMEOUT = 5
+MOVE_DISTANCE = 1.0
+
+
+class SimulatorPoller(object):
+    """
+    Polls one axis of the simulator as fast as possible, and records
+    the time when it started and stopped being busy.
+    fActPosition? makes the simulator calculate the motion up to now.
+    """
+
+    def __init__(self, hostport):
+        host, port = hostport.split(':')
+        self.sock = socket.create_connection((host, int(port)), PV_TIMEOUT)
+        self.fp = self.sock.makefile('rw')
+        self.axis = None
+        self.busyTime = None
+        self.doneTime = None
+        self.lock = threading.Lock()
+        self.stopped = False
+        self.thread = threading.Thread(target=self.run)
+        self.thread.daemon = True
+        self.thread.start()
+
+    def query(self, line):
+        self.fp.write(line + '\n')
+        self.fp.flush()
+        return self.fp.readline().strip()
+
+    def watch(self, axis):
+        with self.lock:
+            self.axis = axis
+            self.busyTime = None
+            self.doneTime = None
+
+    def times(self):
+        with self.lock:
+            return (self.busyTime, self.doneTime)
+
+    def run(self):
+        while not self.stopped:
+            with self.lock:
+                axis = self.axis
+            if axis is None:
+                time.sleep(0.01)
+                continue
+            reply = self.query('Main.M%d.fActPosition?;Main.M%d.bBusy?;' % (axis, axis))
+            now = time.time()
+            busy = reply.split(';')[1] == '1'
+            with self.lock:
+                if axis != self.axis:
+                    continue
+                if busy and self.busyTime is None:
+                    self.busyTime = now
+                if not busy and self.busyTime is not None and self.doneTime is None:
+                    self.doneTime = now
+
+    def stop(self):
+        self.stopped = True
+        self.thread.join()
+        self.sock.close()
+
+
+class Histogram(object):
+    """
+    Counts of a timing histogram of the driver, see asynAxisTiming.template
+    """
+
+    def __init__(self, pvname):
+        self.pvname = pvname
+
+    def read(self):
+        counts = epics.caget(self.pvname, timeout=PV_TIMEOUT, use_monitor=False)
+        if counts is None:
+            raise Exception('caget %s failed' % self.pvname)
+        return [int(c) for c in counts]
+
+
+def readBuckets(pvname):
+    """
+    Upper limits of the buckets of the timing histograms, in seconds
+    """
+    buckets = epics.caget(pvname, timeout=PV_TIMEOUT, use_monitor=False)
+    if buckets is None:
+        raise Exception('caget %s failed' % pvname)
+    buckets = [float(b) for b in buckets]
+    if not any(buckets):
+        raise Exception('%s has no bucket limits' % pvname)
+    return buckets
+
+
+def checkSamples(name, buckets, counts):
+    if len(counts) != len(buckets):
+        raise Exception('%s has %d buckets, not %d' % (name, len(counts), len(buckets)))
+    if not sum(counts):
+        raise Exception('%s has no samples' % name)
+
+
+def percentile(buckets, counts, fraction):
+    """
+    Upper limit of the bucket which holds the fraction of the samples,
+    None for the last bucket, which has no limit
+    """
+    total = sum(counts)
+    if not total:
+        return None
+    needed = fraction * total
+    seen = 0
+    for i in range(len(counts)):
+        seen += counts[i]
+        if seen >= needed:
+            if i < len(buckets) - 1 and buckets[i] > 0:
+                return buckets[i]
+            return None
+    return None
+
+
+def histogramResult(buckets, counts, duration):
+    return {
+        'samples': sum(counts),
+        'rate_hz': sum(counts) / duration,
+        'p50_s': percentile(buckets, counts, 0.50),
+        'p90_s': percentile(buckets, counts, 0.90),
+        'p99_s': percentile(buckets, counts, 0.99),
+        'buckets_s': buckets,
+        'counts': counts,
+    }
+
+
+def latencyResult(samples):
+    if not samples:
+        return {'samples': 0}
+    samples = sorted(samples)
+    return {
+        'samples': len(samples),
+        'min_s': samples[0],
+        'median_s': samples[len(samples) // 2],
+        'p90_s': samples[int(len(samples) * 0.9)],
+        'max_s': samples[-1],
+    }
+
+
+def waitForIoc(prefix, timeout):
+    pvname = prefix + 'm1.RBV'
+    endTime = time.time() + timeout
+    while time.time() < endTime:
+        if epics.caget(pvname, timeout=1) is not None:
+            return True
+        time.sleep(1)
+    return False
+
+
+def measureHistograms(prefix, numAxes, duration):
+    """
+    Resets the histograms, waits, and reads them
+    """
+    controller = prefix + 'MCU1:'
+    buckets = readBuckets(controller + 'TimingBuckets')
+    pollCycle = Histogram(controller + 'TimingPollCycle')
+    writeRead = Histogram(controller + 'TimingWriteRead')
+    axisPolls = [Histogram('%sM%dTimingPoll' % (controller, axis))
+                 for axis in range(1, numAxes + 1)]
+
+    if epics.caput(controller + 'TimingReset', 1, wait=True, timeout=PV_TIMEOUT) != 1:
+        raise Exception('caput %sTimingReset failed' % controller)
+    startTime = time.time()
+    time.sleep(duration)
+    pollCycleCounts = pollCycle.read()
+    writeReadCounts = writeRead.read()
+    axisPollCounts = [0] * len(buckets)
+    for histogram in axisPolls:
+        counts = histogram.read()
+        checkSamples(histogram.pvname, buckets, counts)
+        axisPollCounts = [a + b for a, b in zip(axisPollCounts, counts)]
+    checkSamples(pollCycle.pvname, buckets, pollCycleCounts)
+    checkSamples(writeRead.pvname, buckets, writeReadCounts)
+    duration = time.time() - startTime
+    return {
+        'duration_s': duration,
+        'poll_cycle': histogramResult(buckets, pollCycleCounts, duration),
+        'axis_poll': histogramResult(buckets, axisPollCounts, duration),
+        'write_read': histogramResult(buckets, writeReadCounts, duration),
+    }
+
+
+def measureMoves(prefix, numAxes, simulator, numMoves):
+    """
+    Moves the axes one after the other, back and forth
+    """
+    moveStartHw = []
+    moveStartMovn = []
+    dmov = []
+    failed = 0
+
+    for n in range(numMoves):
+        axis = 1 + n % numAxes
+        motor = '%sm%d' % (prefix, axis)
+        events = {}
+
+        def onMovn(value=None, **kw):
+            if int(value) == 1 and 'movn' not in events:
+                events['movn'] = time.time()
+
+        def onDmov(value=None, **kw):
+            if 'start' not in events:
+                return
+            if int(value) == 0:
+                events['dmov0'] = time.time()
+            elif 'dmov0' in events and 'dmov' not in events:
+                events['dmov'] = time.time()
+
+        movn = epics.PV(motor + '.MOVN', callback=onMovn)
+        dmovPV = epics.PV(motor + '.DMOV', callback=onDmov)
+        movn.wait_for_connection(PV_TIMEOUT)
+        dmovPV.wait_for_connection(PV_TIMEOUT)
+        rbv = epics.caget(motor + '.RBV', timeout=PV_TIMEOUT, use_monitor=False)
+        target = rbv + (MOVE_DISTANCE if n % 2 == 0 else -MOVE_DISTANCE)
+
+        simulator.watch(axis)
+        events['start'] = time.time()
+        epics.caput(motor + '.VAL', target)
+        endTime = time.time() + 30
+        while 'dmov' not in events and time.time() < endTime:
+            time.sleep(0.001)
+        (busyTime, doneTime) = simulator.times()
+        simulator.watch(None)
+        movn.clear_callbacks()
+        dmovPV.clear_callbacks()
+
+        if 'dmov' not in events or busyTime is None or doneTime is None:
+            failed += 1
+            continue
+        moveStartHw.append(busyTime - events['start'])
+        if 'movn' in events:
+            moveStartMovn.append(events['movn'] - events['start'])
+        dmov.append(events['dmov'] - doneTime)
+
+    if numMoves and failed == numMoves:
+        raise Exception('none of the %d moves was completed' % numMoves)
+    return {
+        'moves': numMoves,
+        'failed': failed,
+        'move_start_hw': latencyResult(moveStartHw),
+        'move_start_movn': latencyResult(moveStartMovn),
+        'dmov': latencyResult(dmov),
+    }
+
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--prefix', default='IOC:')
+    parser.add_option('--axes', type='int', default=1)
+    parser.add_option('--duration', type='float', default=30.0)
+    parser.add_option('--moves', type='int', default=20)
+    parser.add_option('--simulator', default='127.0.0.1:5000')
+    parser.add_option('--output', default='-')
+    (options, args) = parser.parse_args()
+
+    if not waitForIoc(options.prefix, 120):
+        print('IOC not running: %sm1.RBV' % options.prefix, file=sys.stderr)
+        return 1
+
+    simulator = SimulatorPoller(options.simulator)
+    try:
+        result = {
+            'axes': options.axes,
+            'idle': measureHistograms(options.prefix, options.axes, options.duration),
+            'moving': measureMoves(options.prefix, options.axes, simulator, options.moves),
+        }
+    except Exception as e:
+        print('Error: %s' % e, file=sys.stderr)
+        return 1
+    finally:
+        simulator.stop()
+
+    text = json.dumps(result, indent=2, sort_keys=True)
+    if options.output == '-':
+        print(text)
+    else:
+        with open(options.output, 'w') as fp:
+            fp.write(text + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
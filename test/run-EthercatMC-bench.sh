@@ -0,0 +1,97 @@
+#!/bin/sh
+#
+# Poll throughput benchmark of the EthercatMC driver against the simulator.
+#
+# Starts the simulator with <numAxes> axes, an IOC with an
+# EthercatMCController with <numAxes> axes, and measures poll rate,
+# poll cycle and round trip times, move start and DMOV latencies.
+# The results are written as JSON into <resultfile>, default stdout.
+#
+# Needs the same environment as run-EthercatMC-ioc.sh and pyepics.
+
+if test -z "$1" ; then
+  echo >&2 "$0" "<numAxes> [duration] [resultfile]"
+  exit 1
+fi
+NUMAXES=$1
+DURATION=${2:-30}
+RESULTFILE=$3
+MOTORPORT=${BENCH_MOTORPORT:-5042}
+PREFIX=${BENCH_PREFIX:-IOC:}
+MOVINGPOLL=${BENCH_MOVINGPOLL:-100}
+IDLEPOLL=${BENCH_IDLEPOLL:-1000}
+STCMD=startup/st.Bench.cmd
+LOGDIR=${BENCH_LOGDIR:-/tmp}
+
+cleanup ()
+{
+  test -n "$IOCPID" && kill $IOCPID 2>/dev/null
+  test -n "$SIMPID" && kill $SIMPID 2>/dev/null
+  pkill -f "simMotor -a $NUMAXES -p $MOTORPORT" 2>/dev/null
+  rm -f $STCMD
+}
+trap cleanup EXIT INT TERM
+
+# The startup file has one controller with NUMAXES axes
+# (axis 0 is not used) and the timing histograms
+{
+  cat <<-EOF2
+require asyn,4.31
+require axis,USER
+
+epicsEnvSet("MOTOR_PORT",    "MCU1")
+epicsEnvSet("IPADDR",        "127.0.0.1")
+epicsEnvSet("IPPORT",        "5000")
+epicsEnvSet("ASYN_PORT",     "MC_CPU1")
+epicsEnvSet("PREFIX",        "$PREFIX")
+
+drvAsynIPPortConfigure("\$(ASYN_PORT)","\$(IPADDR):\$(IPPORT)",0,0,0)
+asynOctetSetOutputEos("\$(ASYN_PORT)", -1, ";\n")
+asynOctetSetInputEos("\$(ASYN_PORT)", -1, ";\n")
+EthercatMCCreateController("\$(MOTOR_PORT)", "\$(ASYN_PORT)", "$(($NUMAXES + 1))", "$MOVINGPOLL", "$IDLEPOLL")
+< EthercatMCTiming.cmd
+
+epicsEnvSet("DESC",          "bench")
+epicsEnvSet("EGU",           "mm")
+epicsEnvSet("PREC",          "3")
+epicsEnvSet("VELO",          "10")
+epicsEnvSet("JVEL",          "5")
+epicsEnvSet("JAR",           "10")
+epicsEnvSet("ACCL",          "0.1")
+epicsEnvSet("MRES",          "1")
+epicsEnvSet("ERES",          "1")
+epicsEnvSet("SDBD",          "0")
+epicsEnvSet("RDBD",          "0")
+epicsEnvSet("DLLM",          "0")
+epicsEnvSet("DHLM",          "0")
+EOF2
+  axis=1
+  while test $axis -le $NUMAXES; do
+    cat <<-EOF2
+
+epicsEnvSet("AXIS_NO",       "$axis")
+epicsEnvSet("MOTOR_NAME",    "m$axis")
+epicsEnvSet("R",             "m$axis-")
+epicsEnvSet("AXISCONFIG",    "stepSize=1.0;encoder=Main.M$axis.fActPosition")
+< EthercatMCAxis.cmd
+< EthercatMCTimingAxis.cmd
+EOF2
+    axis=$(($axis + 1))
+  done
+} >$STCMD || exit 1
+
+./run-EthercatMC-simulator.sh -a $NUMAXES -p $MOTORPORT >$LOGDIR/bench-simulator.log 2>&1 &
+SIMPID=$!
+sleep 2
+
+# iocsh exits at the end of stdin, keep it open
+tail -f /dev/null | ./run-EthercatMC-ioc.sh Bench 127.0.0.1:$MOTORPORT >$LOGDIR/bench-ioc.log 2>&1 &
+IOCPID=$!
+
+(
+  cd bench &&
+  ./EthercatMCBench.py --prefix "$PREFIX" --axes $NUMAXES \
+                       --duration $DURATION \
+                       --simulator 127.0.0.1:$MOTORPORT \
+                       --output "${RESULTFILE:--}"
+)
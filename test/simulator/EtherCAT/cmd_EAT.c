@@ -61,14 +61,26 @@ typedef struct
 } cmd_Motor_status_type;
 
 /* values commanded to the motor */
-static cmd_Motor_cmd_type cmd_Motor_cmd[MAX_AXES];
+static cmd_Motor_cmd_type *cmd_Motor_cmd;
 
 /* values reported back from the motor */
-static cmd_Motor_status_type cmd_Motor_status[MAX_AXES];
+static cmd_Motor_status_type *cmd_Motor_status;
+
+static char *init_done;
+
+/* Point the per axis data to the axes of the selected controller */
+static void select_controller_data(void)
+{
+  static void *cmd_Motor_cmd_all;
+  static void *cmd_Motor_status_all;
+  static void *init_done_all;
+  cmd_Motor_cmd = getControllerAxesData(&cmd_Motor_cmd_all, sizeof(cmd_Motor_cmd_type));
+  cmd_Motor_status = getControllerAxesData(&cmd_Motor_status_all, sizeof(cmd_Motor_status_type));
+  init_done = getControllerAxesData(&init_done_all, sizeof(char));
+}
 
 static void init_axis(int axis_no)
 {
-  static char init_done[MAX_AXES];
   const double MRES = 1;
   const double UREV = 60.0; /* mm/revolution */
   const double SREV = 2000.0; /* ticks/revolution */
@@ -854,6 +866,7 @@ static void motorHandleOneArg(const char *myarg_1)
 void cmd_EAT(int argc, const char *argv[])
 {
   const char *myargline = (argc > 0) ? argv[0] : "";
+  select_controller_data();
   if (PRINT_STDOUT_BIT6())
   {
     const char *myarg[5];
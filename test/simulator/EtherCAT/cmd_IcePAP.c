@@ -19,12 +19,21 @@ typedef struct
   int    velocity;
 } cmd_Motor_cmd_type;
 
-static cmd_Motor_cmd_type cmd_Motor_cmd[MAX_AXES];
+static cmd_Motor_cmd_type *cmd_Motor_cmd;
+static char *init_done;
+
+/* Point the per axis data to the axes of the selected controller */
+static void select_controller_data(void)
+{
+  static void *cmd_Motor_cmd_all;
+  static void *init_done_all;
+  cmd_Motor_cmd = getControllerAxesData(&cmd_Motor_cmd_all, sizeof(cmd_Motor_cmd_type));
+  init_done = getControllerAxesData(&init_done_all, sizeof(char));
+}
 
 
 static void init_axis(int axis_no)
 {
-  static char init_done[MAX_AXES];
   const double MRES = 0.03;
   const double ERES = MRES;
   double ReverseMRES = (double)1.0/MRES;
@@ -51,6 +60,78 @@ static void init_axis(int axis_no)
 }
 
 
+/* Page 21 */
+#define STATUS_BIT_READY     (1<<9)
+#define STATUS_BIT_MOVING    (1<<10)
+#define STATUS_BIT_LIMIT_POS (1<<18)
+#define STATUS_BIT_LIMIT_NEG (1<<19)
+#define STATUS_BIT_HSIGNAL   (1<<20)
+#define STATUS_BIT_POWERON   (1<<23)
+
+static int get_status(int motor_axis_no)
+{
+  int status = 0;
+
+  if (isMotorMoving(motor_axis_no))     status |= STATUS_BIT_MOVING;
+  if (getAxisHome(motor_axis_no))       status |= STATUS_BIT_HSIGNAL;
+  if (getPosLimitSwitch(motor_axis_no)) status |= STATUS_BIT_LIMIT_POS;
+  if (getNegLimitSwitch(motor_axis_no)) status |= STATUS_BIT_LIMIT_NEG;
+  if (1)                                status |= STATUS_BIT_POWERON; /* Power always on for now */
+  if (!(status & STATUS_BIT_MOVING))    status |= STATUS_BIT_READY;
+  return status;
+}
+
+/* The system queries, which read several axes at once:
+   ?FSTATUS 1 2 3
+   ?FPOS 1 2 3
+   ?FPOS MEASURE 1 2 3
+   The reply has one value per axis: "?FPOS 100 -200 300" */
+static int handle_IcePAP_multi(int argc, const char *argv[])
+{
+  int is_status;
+  int use_encoder = 0;
+  int first = 2;
+  int motor_axis_no = 0;
+  int nvals;
+  int i;
+
+  if (argc < 3) return 0;
+  if (0 == strcmp(argv[1], "?FSTATUS")) {
+    is_status = 1;
+  } else if (0 == strcmp(argv[1], "?FPOS")) {
+    is_status = 0;
+    /* An optional signal source before the axes */
+    if (!isdigit((unsigned char)argv[2][0])) {
+      use_encoder = strcmp(argv[2], "AXIS") ? 1 : 0;
+      first = 3;
+    }
+  } else {
+    return 0;
+  }
+  if (argc <= first) return 0;
+  /* Check all axes first, a bad query gets no partial reply */
+  for (i = first; i < argc; i++) {
+    nvals = sscanf(argv[i], "%d", &motor_axis_no);
+    if (nvals != 1) return 0;
+    AXIS_CHECK_RETURN_ZERO(motor_axis_no);
+  }
+  cmd_buf_printf("%s", argv[1]);
+  for (i = first; i < argc; i++) {
+    sscanf(argv[i], "%d", &motor_axis_no);
+    if (is_status) {
+      cmd_buf_printf(" 0x%08x", get_status(motor_axis_no));
+    } else if (use_encoder) {
+      cmd_buf_printf(" %d", (int)getEncoderPos(motor_axis_no));
+    } else {
+      cmd_buf_printf(" %d", (int)getMotorPos(motor_axis_no));
+    }
+  }
+  LOGINFO4("%s/%s:%d argv[0]=%s\n",
+           __FILE__, __FUNCTION__, __LINE__,
+           argv[0]);
+  return ICEPAP_SEND_NEWLINE;
+}
+
 static int handle_IcePAP_cmd(const char *myarg_1)
 {
   int motor_axis_no = 0;
@@ -77,22 +158,7 @@ static int handle_IcePAP_cmd(const char *myarg_1)
     return ret;
   }
   if (0 == strcmp(myarg_1, "?STATUS")) {
-    /* Page 21 */
-    #define STATUS_BIT_READY     (1<<9)
-    #define STATUS_BIT_MOVING    (1<<10)
-    #define STATUS_BIT_LIMIT_POS (1<<18)
-    #define STATUS_BIT_LIMIT_NEG (1<<19)
-    #define STATUS_BIT_HSIGNAL   (1<<20)
-    #define STATUS_BIT_POWERON   (1<<23)
-    int status = 0;
-
-    if (isMotorMoving(motor_axis_no))     status |= STATUS_BIT_MOVING;
-    if (getAxisHome(motor_axis_no))       status |= STATUS_BIT_HSIGNAL;
-    if (getPosLimitSwitch(motor_axis_no)) status |= STATUS_BIT_LIMIT_POS;
-    if (getNegLimitSwitch(motor_axis_no)) status |= STATUS_BIT_LIMIT_NEG;
-    if (1)                                status |= STATUS_BIT_POWERON; /* Power always on for now */
-    if (!(status & STATUS_BIT_MOVING))    status |= STATUS_BIT_READY;
-    cmd_buf_printf("%d:?STATUS %x", motor_axis_no, status);
+    cmd_buf_printf("%d:?STATUS %x", motor_axis_no, get_status(motor_axis_no));
     return ICEPAP_SEND_NEWLINE;
   }
   if (0 == strcmp(myarg_1, "?POS")) {
@@ -131,17 +197,7 @@ static int handle_IcePAP_cmd3(const char *myarg_1, const char *myarg_2)
     myarg_1++;
   }
   (void)ret;
-  /* ?FPOS 1 */
-  if (0 == strcmp(myarg_1, "?FPOS")) {
-    nvals = sscanf(myarg_2, "%d", &motor_axis_no);
-    LOGINFO4("%s/%s:%d nvals=%d motor_axis_no=%d\n",
-             __FILE__, __FUNCTION__, __LINE__,
-             nvals, motor_axis_no);
-    if (nvals == 1) {
-      cmd_buf_printf("%s %d", myarg_1, (int)getMotorPos(motor_axis_no));
-      return ICEPAP_SEND_NEWLINE;
-    }
-  }
+  /* ?FPOS 1 is handled in handle_IcePAP_multi() */
 
   nvals = sscanf(myarg_1, "%d:", &motor_axis_no);
   if (nvals != 1) {
@@ -166,7 +222,7 @@ static int handle_IcePAP_cmd3(const char *myarg_1, const char *myarg_2)
       moveVelocity(motor_axis_no,
                    value > 0, /* int direction */
                    velocity, /* double max_velocity, */
-                   1.0 /*double acceleration */ );
+                   0.0 /* double acceleration, no ramp */ );
       return ret;
     }
   }
@@ -179,7 +235,7 @@ static int handle_IcePAP_cmd3(const char *myarg_1, const char *myarg_2)
       moveHome(motor_axis_no,
                value, /* int direction */
                cmd_Motor_cmd[motor_axis_no].homevel,
-               1.0 /*double acceleration */ );
+               0.0 /* double acceleration, no ramp */ );
       return ret;
     }
   }
@@ -193,7 +249,7 @@ static int handle_IcePAP_cmd3(const char *myarg_1, const char *myarg_2)
                    (double)value,
                    0, /* int relative, */
                    cmd_Motor_cmd[motor_axis_no].velocity,
-                   1.0 /*double acceleration */ );
+                   0.0 /* double acceleration, no ramp */ );
       return ret; /* MOVE does respond */
     }
   }
@@ -231,7 +287,7 @@ static int handle_IcePAP_cmd3(const char *myarg_1, const char *myarg_2)
                    (double)value,
                    1, /* int relative, */
                    1000.0, /* double max_velocity, */
-                   1.0 /*double acceleration */ );
+                   0.0 /* double acceleration, no ramp */ );
       return ICEPAP_SEND_NEWLINE; /* MOVE doesn't respond */
     }
   }
@@ -253,23 +309,7 @@ static int handle_IcePAP_cmd4(const char *myarg_1,
   }
   (void)ret;
   (void)value;
-  /* Commands with '?' must be first, they don't have a board number
-     (or axis number) and don't have a ':' */
-  if (0 == strcmp(myarg_1, "?FPOS")) {
-    if (0 == strcmp(myarg_2, "MEASURE")) {
-      nvals = sscanf(myarg_3, "%d", &motor_axis_no);
-      LOGINFO4("%s/%s:%d nvals=%d motor_axis_no=%d\n",
-               __FILE__, __FUNCTION__, __LINE__,
-               nvals, motor_axis_no);
-      if (nvals == 1) {
-        int value = (int)getEncoderPos(motor_axis_no);
-        cmd_buf_printf("%s %d", myarg_1, value);
-        LOGINFO3("%s/%s:%d encoderpos=%d\n",
-                 __FILE__, __FUNCTION__, __LINE__, value);
-        return ICEPAP_SEND_NEWLINE;
-      }
-    }
-  }
+  /* ?FPOS MEASURE 1 is handled in handle_IcePAP_multi() */
   nvals = sscanf(myarg_1, "%d:", &motor_axis_no);
   if (nvals != 1) {
     return 0; /* Not IcePAP */
@@ -321,6 +361,7 @@ static int handle_IcePAP_cmd4(const char *myarg_1,
 int cmd_IcePAP(int argc, const char *argv[])
 {
   int ret = 0;
+  select_controller_data();
   LOGINFO5("%s/%s:%d argc=%d argv[0]=%s\n",
            __FILE__, __FUNCTION__, __LINE__,
            argc, argv[0]);
@@ -330,7 +371,10 @@ int cmd_IcePAP(int argc, const char *argv[])
      argv[1]  "1:MOVE"
      argv[2]  "2011"
   */
-  if (argc == 4) {
+  ret = handle_IcePAP_multi(argc, argv);
+  if (ret) {
+    ;
+  } else if (argc == 4) {
     LOGINFO5("%s/%s:%d argv[1]=%s argv[2]=%s\n",
              __FILE__, __FUNCTION__, __LINE__,
              argv[1], argv[2]);
@@ -19,6 +19,43 @@ static void init_axis(int axis_no)
 {
   (void)axis_no;
 }
+/* Commands for the simulator as a whole, not for an axis.
+   Returns 1 if the command was handled */
+static int simHandleGlobalArg(const char *myarg_1)
+{
+  int iValue = 0;
+  double fValue = 0;
+  int nvals;
+
+  /* fVirtualTime? */
+  if (!strcmp(myarg_1, "fVirtualTime?")) {
+    cmd_buf_printf("%.9f", getSimulatorTimeNs() / 1000000000.0);
+    return 1;
+  }
+  /* bVirtualTime? */
+  if (!strcmp(myarg_1, "bVirtualTime?")) {
+    cmd_buf_printf("%d", getSimulatorVirtualTime());
+    return 1;
+  }
+  /* bVirtualTime=1 */
+  nvals = sscanf(myarg_1, "bVirtualTime=%d", &iValue);
+  if (nvals == 1) {
+    setSimulatorVirtualTime(iValue);
+    cmd_buf_printf("OK");
+    return 1;
+  }
+  /* fVirtualTimeStep=0.1 */
+  nvals = sscanf(myarg_1, "fVirtualTimeStep=%lf", &fValue);
+  if (nvals == 1) {
+    if (!stepSimulatorVirtualTime(fValue))
+      cmd_buf_printf("OK");
+    else
+      cmd_buf_printf("Error virtual time not enabled");
+    return 1;
+  }
+  return 0;
+}
+
 static void motorHandleOneArg(const char *myarg_1)
 {
   const char *myarg = myarg_1;
@@ -35,6 +72,7 @@ static void motorHandleOneArg(const char *myarg_1)
   if (!strncmp(myarg_1, Sim_dot_str, strlen(Sim_dot_str))) {
     myarg_1 += strlen(Sim_dot_str);
   }
+  if (simHandleGlobalArg(myarg_1)) return;
 
   /* From here on, only M1. commands */
   nvals = sscanf(myarg_1, "M%d.", &motor_axis_no);
@@ -52,6 +90,9 @@ static void motorHandleOneArg(const char *myarg_1)
   }
   myarg_1++; /* Jump over '.' */
 
+  /* Sim.M1.bVirtualTime=1 is the same as Sim.bVirtualTime=1 */
+  if (simHandleGlobalArg(myarg_1)) return;
+
   /* log= */
   if (!strncmp(myarg_1, log_equals_str, strlen(log_equals_str))) {
     int ret;
@@ -145,6 +186,14 @@ static void motorHandleOneArg(const char *myarg_1)
     return;
   }
 
+  /* fJerk=1000 */
+  nvals = sscanf(myarg_1, "fJerk=%lf", &fValue);
+  if (nvals == 1) {
+    setMotorJerk(motor_axis_no, fValue);
+    cmd_buf_printf("OK");
+    return;
+  }
+
   /* fActPosition=30 */
   nvals = sscanf(myarg_1, "fActPosition=%lf", &fValue);
   if (nvals == 1) {
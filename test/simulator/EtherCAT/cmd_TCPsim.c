@@ -18,11 +18,20 @@ typedef struct
   int    velocity;
 } cmd_Motor_cmd_type;
 
-static cmd_Motor_cmd_type cmd_Motor_cmd[MAX_AXES];
+static cmd_Motor_cmd_type *cmd_Motor_cmd;
+static char *init_done;
+
+/* Point the per axis data to the axes of the selected controller */
+static void select_controller_data(void)
+{
+  static void *cmd_Motor_cmd_all;
+  static void *init_done_all;
+  cmd_Motor_cmd = getControllerAxesData(&cmd_Motor_cmd_all, sizeof(cmd_Motor_cmd_type));
+  init_done = getControllerAxesData(&init_done_all, sizeof(char));
+}
 
 static void init_axis(int axis_no)
 {
-  static char init_done[MAX_AXES];
   const static double MRES = 0.001;
   const double ERES = 1.0;
   double ReverseMRES = (double)1.0/MRES;
@@ -110,7 +119,7 @@ static int handle_TCPSIM_cmd4(int motor_axis_no,
                    (double)value,
                    0, /* int relative, */
                    cmd_Motor_cmd[motor_axis_no].velocity,
-                   1.0 /*double acceleration */ );
+                   0.0 /* double acceleration, no ramp */ );
       return TCPSIM_SEND_OK;
     }
   }
@@ -133,7 +142,7 @@ static int handle_TCPSIM_cmd4(int motor_axis_no,
       moveHome(motor_axis_no,
                value,
                cmd_Motor_cmd[motor_axis_no].velocity,
-               1 /* double acceleration */);
+               0.0 /* double acceleration, no ramp */);
       return TCPSIM_SEND_OK;
     }
   }
@@ -151,7 +160,7 @@ static int handle_TCPSIM_cmd4(int motor_axis_no,
       moveVelocity(motor_axis_no,
                    direction,
                    (double)value,
-                   1 /* double acceleration */);
+                   0.0 /* double acceleration, no ramp */);
       return TCPSIM_SEND_OK;
     }
   }
@@ -173,6 +182,7 @@ int cmd_TCPsim(int argc, const char *argv[])
 {
   int ret = 0;
   int axis_no = 0;
+  select_controller_data();
   LOGINFO5("%s/%s:%d argc=%d argv[0]=%s\n",
            __FILE__, __FUNCTION__, __LINE__,
            argc, argv[0]);
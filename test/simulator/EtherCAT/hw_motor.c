@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <time.h>
 #include <math.h>
 #include "hw_motor.h"
 #include "sock-util.h" /* stdlog */
@@ -20,9 +21,14 @@
 
 #define RAMPDOWNONLIMIT 3
 
+/* The motion is integrated in steps of 1 msec, so that the result
+   does not depend on how often the simulator is polled */
+#define SIM_TICK_NS 1000000LL
+#define NS_PER_SEC  1000000000.0
+
 typedef struct
 {
-  struct timeval lastPollTime;
+  long long lastPollTimeNs;
 
   double amplifierPercent;
   /* What the (simulated) hardware has physically.
@@ -65,6 +71,12 @@ typedef struct
     unsigned int rampDownOnLimit;
     int clipped;
   } moving;
+  struct {
+    double velocity;        /* actual velocity */
+    double acceleration;    /* actual acceleration, S-curve only */
+    double maxAcceleration; /* from the move command, 0 == no ramp */
+  } kinematic;
+  double jerk;              /* 0 == trapezoidal profile */
   double EncoderPos;
   double ParkingPos;
   double ReverseERES;
@@ -76,9 +88,126 @@ typedef struct
 } motor_axis_type;
 
 
-static motor_axis_type motor_axis[MAX_AXES];
-static motor_axis_type motor_axis_last[MAX_AXES];
-static motor_axis_type motor_axis_reported[MAX_AXES];
+int hw_motor_max_axes = DEFAULT_NUM_AXES + 1;
+static int numControllers = 1;
+static int controllerNo;
+
+/* The axes of the selected controller */
+static motor_axis_type *motor_axis;
+static motor_axis_type *motor_axis_last;
+static motor_axis_type *motor_axis_reported;
+static char *init_done;
+
+static int virtualTimeEnabled;
+static long long virtualTimeNs;
+
+static long long getMonotonicTimeNs(void)
+{
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  if (!clock_gettime(CLOCK_MONOTONIC, &ts)) {
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+  }
+#endif
+  {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (long long)tv.tv_sec * 1000000000LL + tv.tv_usec * 1000LL;
+  }
+}
+
+long long getSimulatorTimeNs(void)
+{
+  if (virtualTimeEnabled) return virtualTimeNs;
+  return getMonotonicTimeNs();
+}
+
+int hw_motor_configure(int num_axes, int num_controllers)
+{
+  fprintf(stdlog, "%s/%s:%d num_axes=%d num_controllers=%d\n",
+          __FILE__, __FUNCTION__, __LINE__, num_axes, num_controllers);
+  if (motor_axis) return -1; /* Too late */
+  if (num_axes < 1 || num_axes > MAX_NUM_AXES) return -1;
+  if (num_controllers < 1 || num_controllers > MAX_NUM_CONTROLLERS) return -1;
+  hw_motor_max_axes = num_axes + 1;
+  numControllers = num_controllers;
+  selectController(0);
+  return 0;
+}
+
+int getNumControllers(void)
+{
+  return numControllers;
+}
+
+int getControllerNo(void)
+{
+  return controllerNo;
+}
+
+void *getControllerAxesData(void **ppAll, size_t sizeOfAxis)
+{
+  if (!*ppAll) {
+    *ppAll = calloc((size_t)numControllers * MAX_AXES, sizeOfAxis);
+    if (!*ppAll) {
+      fprintf(stdlog, "%s/%s:%d out of memory numControllers=%d MAX_AXES=%d\n",
+              __FILE__, __FUNCTION__, __LINE__, numControllers, MAX_AXES);
+      exit(3);
+    }
+  }
+  return (char *)*ppAll + (size_t)controllerNo * MAX_AXES * sizeOfAxis;
+}
+
+void selectController(int controller_no)
+{
+  static void *motor_axis_all;
+  static void *motor_axis_last_all;
+  static void *motor_axis_reported_all;
+  static void *init_done_all;
+
+  if (controller_no < 0 || controller_no >= numControllers) return;
+  controllerNo = controller_no;
+  motor_axis = getControllerAxesData(&motor_axis_all, sizeof(motor_axis_type));
+  motor_axis_last = getControllerAxesData(&motor_axis_last_all, sizeof(motor_axis_type));
+  motor_axis_reported = getControllerAxesData(&motor_axis_reported_all, sizeof(motor_axis_type));
+  init_done = getControllerAxesData(&init_done_all, sizeof(char));
+}
+
+int getSimulatorVirtualTime(void)
+{
+  return virtualTimeEnabled;
+}
+
+void setSimulatorVirtualTime(int enable)
+{
+  fprintf(stdlog, "%s/%s:%d enable=%d\n",
+          __FILE__, __FUNCTION__, __LINE__, enable);
+  if (enable && !virtualTimeEnabled) {
+    /* Continue where the real clock is, the axes keep their lastPollTimeNs */
+    virtualTimeNs = getMonotonicTimeNs();
+  } else if (!enable && virtualTimeEnabled) {
+    /* Time passed in virtual mode is lost, restart the integration */
+    int old_controller_no = controllerNo;
+    int ctrl_no;
+    int axis_no;
+    long long timeNowNs = getMonotonicTimeNs();
+    for (ctrl_no = 0; ctrl_no < numControllers; ctrl_no++) {
+      selectController(ctrl_no);
+      for (axis_no = 0; axis_no < MAX_AXES; axis_no++) {
+        motor_axis[axis_no].lastPollTimeNs = timeNowNs;
+      }
+    }
+    selectController(old_controller_no);
+  }
+  virtualTimeEnabled = enable;
+}
+
+int stepSimulatorVirtualTime(double seconds)
+{
+  if (!virtualTimeEnabled || seconds < 0) return -1;
+  virtualTimeNs += (long long)(seconds * NS_PER_SEC + 0.5);
+  return 0;
+}
 
 static void recalculate_pos(int axis_no, int nCmdData)
 {
@@ -143,8 +272,6 @@ void hw_motor_init(int axis_no,
                    double hWhighPos,
                    double homeSwitchPos)
 {
-  static char init_done[MAX_AXES];
-
 
   if (axis_no >= MAX_AXES || axis_no < 0) {
     return;
@@ -564,9 +691,151 @@ void setHWhomeSwitchpos(int axis_no, double value)
 }
 
 
+double getMotorJerk(int axis_no)
+{
+  AXIS_CHECK_RETURN_ZERO(axis_no);
+  return motor_axis[axis_no].jerk;
+}
+
+void setMotorJerk(int axis_no, double value)
+{
+  fprintf(stdlog,
+          "%s/%s:%d axis_no=%d value=%g\n",
+          __FILE__, __FUNCTION__, __LINE__, axis_no, value);
+  AXIS_CHECK_RETURN(axis_no);
+  motor_axis[axis_no].jerk = value > 0 ? value : 0;
+}
+
+/* The distance needed to ramp down from velocity to 0 */
+static double getStoppingDistance(int axis_no, double velocity)
+{
+  double maxAcceleration = motor_axis[axis_no].kinematic.maxAcceleration;
+  double jerk = motor_axis[axis_no].jerk;
+  velocity = fabs(velocity);
+  if (maxAcceleration <= 0) return 0;
+  if (jerk <= 0) {
+    return velocity * velocity / (2 * maxAcceleration);
+  }
+  if (velocity < maxAcceleration * maxAcceleration / jerk) {
+    /* maxAcceleration is not reached while ramping down */
+    return velocity * sqrt(velocity / jerk);
+  }
+  return velocity * velocity / (2 * maxAcceleration) +
+    velocity * maxAcceleration / (2 * jerk);
+}
+
+/* One step of the velocity ramp, trapezoidal or S-curve */
+static void rampVelocity(int axis_no, double velocityWanted, double dt)
+{
+  double maxAcceleration = motor_axis[axis_no].kinematic.maxAcceleration;
+  double jerk = motor_axis[axis_no].jerk;
+  double velocity = motor_axis[axis_no].kinematic.velocity;
+  double acceleration = motor_axis[axis_no].kinematic.acceleration;
+  double deltaVelocity = velocityWanted - velocity;
+
+  if (maxAcceleration <= 0) {
+    /* No ramp: Jump to the velocity */
+    velocity = velocityWanted;
+    acceleration = 0;
+  } else if (jerk <= 0) {
+    /* Trapezoidal */
+    double maxDeltaVelocity = maxAcceleration * dt;
+    if (deltaVelocity > maxDeltaVelocity) deltaVelocity = maxDeltaVelocity;
+    if (deltaVelocity < -maxDeltaVelocity) deltaVelocity = -maxDeltaVelocity;
+    velocity += deltaVelocity;
+    acceleration = 0;
+  } else {
+    /* S-curve: The acceleration is ramped with jerk, and ramped
+       down in time to reach velocityWanted without overshoot */
+    double accelerationWanted = maxAcceleration;
+    double accelerationLimit = sqrt(2 * jerk * fabs(deltaVelocity));
+    if (accelerationWanted > accelerationLimit) accelerationWanted = accelerationLimit;
+    if (deltaVelocity < 0) accelerationWanted = -accelerationWanted;
+    if (acceleration < accelerationWanted) {
+      acceleration += jerk * dt;
+      if (acceleration > accelerationWanted) acceleration = accelerationWanted;
+    } else {
+      acceleration -= jerk * dt;
+      if (acceleration < accelerationWanted) acceleration = accelerationWanted;
+    }
+    velocity += acceleration * dt;
+    if ((deltaVelocity > 0 && velocity > velocityWanted) ||
+        (deltaVelocity < 0 && velocity < velocityWanted)) {
+      velocity = velocityWanted;
+      acceleration = 0;
+    }
+  }
+  motor_axis[axis_no].kinematic.velocity = velocity;
+  motor_axis[axis_no].kinematic.acceleration = acceleration;
+}
+
+/* Move the axis for deltaNs nanoseconds.
+   velocity is the commanded velocity, the sign is the direction.
+   pTargetPos is the position to stop at, NULL when jogging.
+   Returns 1 when the target position is reached */
+static int advanceMotion(int axis_no, double velocity,
+                         const double *pTargetPos, long long deltaNs)
+{
+  while (deltaNs > 0) {
+    long long stepNs = deltaNs < SIM_TICK_NS ? deltaNs : SIM_TICK_NS;
+    double velocityOld = motor_axis[axis_no].kinematic.velocity;
+    double velocityWanted = velocity;
+    double distance = 0;
+    double dt;
+
+    if (pTargetPos) {
+      distance = *pTargetPos - motor_axis[axis_no].MotorPosNow;
+      if (distance * velocity <= 0) {
+        /* At the target, or beyond */
+        motor_axis[axis_no].MotorPosNow = *pTargetPos;
+        motor_axis[axis_no].kinematic.velocity = 0;
+        motor_axis[axis_no].kinematic.acceleration = 0;
+        return 1;
+      }
+      if (velocityOld * velocity > 0 &&
+          fabs(distance) <= getStoppingDistance(axis_no, velocityOld)) {
+        velocityWanted = 0;
+      }
+    }
+    if (velocityOld == velocity &&
+        motor_axis[axis_no].kinematic.acceleration == 0) {
+      /* Constant velocity: Take as many steps as possible at once */
+      if (!pTargetPos) {
+        stepNs = deltaNs;
+      } else {
+        double cruiseDistance = fabs(distance) - getStoppingDistance(axis_no, velocity);
+        long long cruiseTicks = (long long)(cruiseDistance / fabs(velocity) *
+                                            NS_PER_SEC / SIM_TICK_NS);
+        if (cruiseTicks > 1) {
+          stepNs = (cruiseTicks - 1) * SIM_TICK_NS;
+          if (stepNs > deltaNs) stepNs = deltaNs;
+        }
+      }
+    }
+    dt = stepNs / NS_PER_SEC;
+    if (velocityOld != velocityWanted ||
+        motor_axis[axis_no].kinematic.acceleration != 0) {
+      rampVelocity(axis_no, velocityWanted, dt);
+    }
+    motor_axis[axis_no].MotorPosNow +=
+      (velocityOld + motor_axis[axis_no].kinematic.velocity) / 2 * dt;
+    if (pTargetPos &&
+        (*pTargetPos - motor_axis[axis_no].MotorPosNow) * velocity <= 0) {
+      /* overshoot or undershoot. We are at the target position */
+      motor_axis[axis_no].MotorPosNow = *pTargetPos;
+      motor_axis[axis_no].kinematic.velocity = 0;
+      motor_axis[axis_no].kinematic.acceleration = 0;
+      return 1;
+    }
+    deltaNs -= stepNs;
+  }
+  return 0;
+}
+
 static void simulateMotion(int axis_no)
 {
-  struct timeval timeNow;
+  long long timeNowNs;
+  long long deltaNs;
   double velocity;
   int clipped = 0;
 
@@ -583,14 +852,15 @@ static void simulateMotion(int axis_no)
     }
   }
 
-  gettimeofday(&timeNow, NULL);
+  timeNowNs = getSimulatorTimeNs();
+  deltaNs = timeNowNs - motor_axis[axis_no].lastPollTimeNs;
 
   if (motor_axis[axis_no].moving.velo.JogVelocity) {
     clipped = soft_limits_clip(axis_no, velocity);
     if (!clipped) {
       /* Simulate jogging  */
-      motor_axis[axis_no].MotorPosNow += motor_axis[axis_no].moving.velo.JogVelocity *
-        (timeNow.tv_sec - motor_axis[axis_no].lastPollTime.tv_sec);
+      (void)advanceMotion(axis_no, motor_axis[axis_no].moving.velo.JogVelocity,
+                          NULL, deltaNs);
     }
   }
 
@@ -598,37 +868,23 @@ static void simulateMotion(int axis_no)
     clipped = soft_limits_clip(axis_no, velocity);
     if (!clipped) {
       /* Simulate a move to postion */
-      motor_axis[axis_no].MotorPosNow += motor_axis[axis_no].moving.velo.PosVelocity *
-        (timeNow.tv_sec - motor_axis[axis_no].lastPollTime.tv_sec);
-      if (((motor_axis[axis_no].moving.velo.PosVelocity > 0) &&
-           (motor_axis[axis_no].MotorPosNow > motor_axis[axis_no].MotorPosWanted)) ||
-          ((motor_axis[axis_no].moving.velo.PosVelocity < 0) &&
-           (motor_axis[axis_no].MotorPosNow < motor_axis[axis_no].MotorPosWanted))) {
-        /* overshoot or undershoot. We are at the target position */
-        motor_axis[axis_no].MotorPosNow = motor_axis[axis_no].MotorPosWanted;
+      if (advanceMotion(axis_no, motor_axis[axis_no].moving.velo.PosVelocity,
+                        &motor_axis[axis_no].MotorPosWanted, deltaNs)) {
         motor_axis[axis_no].moving.velo.PosVelocity = 0;
       }
     }
   }
   if (motor_axis[axis_no].moving.velo.HomeVelocity) {
     /* Simulate move to home */
-    motor_axis[axis_no].MotorPosNow += motor_axis[axis_no].moving.velo.HomeVelocity *
-      (timeNow.tv_sec - motor_axis[axis_no].lastPollTime.tv_sec);
-
-    if (((motor_axis[axis_no].moving.velo.HomeVelocity > 0) &&
-         (motor_axis[axis_no].MotorPosNow > motor_axis[axis_no].HomeProcPos)) ||
-        ((motor_axis[axis_no].moving.velo.HomeVelocity < 0) &&
-         (motor_axis[axis_no].MotorPosNow < motor_axis[axis_no].HomeProcPos))) {
-      /* overshoot or undershoot. We are at home */
-      motor_axis[axis_no].MotorPosNow = motor_axis[axis_no].HomeProcPos;
-    }
+    (void)advanceMotion(axis_no, motor_axis[axis_no].moving.velo.HomeVelocity,
+                        &motor_axis[axis_no].HomeProcPos, deltaNs);
   }
   if (motor_axis[axis_no].MotorPosNow == motor_axis[axis_no].HomeProcPos) {
     motor_axis[axis_no].moving.velo.HomeVelocity = 0;
     motor_axis[axis_no].homed = 1;
   }
 
-  motor_axis[axis_no].lastPollTime = timeNow;
+  motor_axis[axis_no].lastPollTimeNs = timeNowNs;
   clipped |= hard_limits_clip(axis_no, velocity);
 
   /* Compare moving to see if there is anything new */
@@ -712,6 +968,8 @@ void StopInternal_fl(int axis_no, const char *file, int line_no)
   AXIS_CHECK_RETURN(axis_no);
   memset(&motor_axis[axis_no].moving.velo, 0,
          sizeof(motor_axis[axis_no].moving.velo));
+  motor_axis[axis_no].kinematic.velocity = 0;
+  motor_axis[axis_no].kinematic.acceleration = 0;
   /* Restore the ramp down */
   motor_axis[axis_no].moving.rampDownOnLimit = rampDownOnLimit;
 }
@@ -750,7 +1008,8 @@ int movePosition(int axis_no,
           acceleration,
           motor_axis[axis_no].MotorPosNow);
   StopInternal(axis_no);
-  gettimeofday(&motor_axis[axis_no].lastPollTime, NULL);
+  motor_axis[axis_no].lastPollTimeNs = getSimulatorTimeNs();
+  motor_axis[axis_no].kinematic.maxAcceleration = acceleration;
 
   if (relative) {
     position += motor_axis[axis_no].MotorPosNow;
@@ -848,7 +1107,8 @@ int moveHomeProc(int axis_no,
           acceleration);
   StopInternal(axis_no);
   motor_axis[axis_no].homed = 0; /* Not homed any more */
-  gettimeofday(&motor_axis[axis_no].lastPollTime, NULL);
+  motor_axis[axis_no].lastPollTimeNs = getSimulatorTimeNs();
+  motor_axis[axis_no].kinematic.maxAcceleration = acceleration;
 
   if (position > motor_axis[axis_no].MotorPosNow) {
     motor_axis[axis_no].moving.velo.HomeVelocity = velocity;
@@ -908,6 +1168,8 @@ int moveVelocity(int axis_no,
   if (direction < 0) {
     velocity = -velocity;
   }
+  motor_axis[axis_no].lastPollTimeNs = getSimulatorTimeNs();
+  motor_axis[axis_no].kinematic.maxAcceleration = acceleration;
   motor_axis[axis_no].moving.velo.JogVelocity = velocity;
   return 0;
 };
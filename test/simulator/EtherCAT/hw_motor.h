@@ -2,8 +2,9 @@
 #define MOTOR_H
 
 #include <errno.h>
-/* Axis 0 is not used, we use 1..8 */
-#define MAX_AXES 9
+#include "hw_motor_ctrl.h"
+/* Axis 0 is not used, we use 1..num_axes */
+#define MAX_AXES hw_motor_max_axes
 #define AXIS_CHECK_RETURN(_axis) {init_axis(_axis); if (((_axis) <= 0) || ((_axis) >=MAX_AXES)) return;}
 #define AXIS_CHECK_RETURN_ZERO(_axis) {init_axis(_axis); if (((_axis) <= 0) || ((_axis) >=MAX_AXES)) return 0;}
 #define AXIS_CHECK_RETURN_ERROR(_axis) {init_axis(_axis); if (((_axis) <= 0) || ((_axis) >=MAX_AXES)) return (-1);}
@@ -82,6 +83,13 @@ int movePosition(int axis_no,
                  double max_velocity,
                  double acceleration);
 
+/*
+ *  Jerk of the velocity ramps in units/sec^3,
+ *  0 means a trapezoidal profile, >0 an S-curve.
+ */
+double getMotorJerk(int axis_no);
+void   setMotorJerk(int axis_no, double value);
+
 
 /*
  *  moveHome
@@ -92,7 +100,7 @@ int movePosition(int axis_no,
  *                the switch and return from the other side with min_velocity
  *  nCmdData      The homig procedure as described in a separate document
  *  max_velocity: >0 velocity after acceleration has been done
- *  acceleration: time in seconds to reach max_velocity
+ *  acceleration: in units/sec^2, 0 means no ramp
  *
  *  return value: 0 == OK,
  *                error codes and error handling needs to be defined
@@ -111,7 +119,7 @@ int moveHomeProc(int axis_no,
  *                should be reached (Which means that we may run over
  *                the switch and return from the other side with min_velocity
  *  max_velocity: >0 velocity after acceleration has been done
- *  acceleration: time in seconds to reach max_velocity
+ *  acceleration: in units/sec^2, 0 means no ramp
  *
  *  return value: 0 == OK,
  *                error codes and error handling needs to be defined
@@ -127,7 +135,7 @@ int moveHome(int axis_no,
  *
  *  direction:    either <0 or >=0
  *  max_velocity: >0 velocity after acceleration has been done
- *  acceleration: time in seconds to reach max_velocity
+ *  acceleration: in units/sec^2, 0 means no ramp
  *
  *  return value: 0 == OK,
  *                error codes and error handling needs to be defined
@@ -143,7 +151,7 @@ int moveAbsolute(int axis_no,
  *
  *  direction:    either <0 or >=0
  *  max_velocity: >0 velocity after acceleration has been done
- *  acceleration: time in seconds to reach max_velocity
+ *  acceleration: in units/sec^2, 0 means no ramp
  *
  *  return value: 0 == OK,
  *                error codes and error handling needs to be defined
@@ -161,7 +169,7 @@ int moveRelative(int axis_no,
  *  axis_no       1..max
  *  direction:    either <0 or >=0
  *  max_velocity: >0 velocity after acceleration has been done
- *  acceleration: time in seconds to reach max_velocity
+ *  acceleration: in units/sec^2, 0 means no ramp
  *
  *  return value: 0 == OK,
  *                error codes and error handling needs to be defined
@@ -220,6 +228,18 @@ void closeLogFile(int axis_no);
 int getManualSimulatorMode(int axis_no);
 void setManualSimulatorMode(int axis_no, int manualMode);
 
+/*
+ * The clock of the simulator in nanoseconds.
+ * This is the monotonic clock of the system, unless virtual time
+ * is enabled: Then time stands still until a test steps it with
+ * stepSimulatorVirtualTime(), and the motion is deterministic.
+ * stepSimulatorVirtualTime() returns 0 == OK, -1 when not enabled
+ */
+long long getSimulatorTimeNs(void);
+int  getSimulatorVirtualTime(void);
+void setSimulatorVirtualTime(int enable);
+int  stepSimulatorVirtualTime(double seconds);
+
 /*
  * Lock the amplifier to off (even if it should be on)
  */
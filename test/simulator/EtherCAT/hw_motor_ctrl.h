@@ -0,0 +1,42 @@
+#ifndef MOTOR_CTRL_H
+#define MOTOR_CTRL_H
+
+#include <stddef.h>
+
+/*
+ * The number of axes and the number of controllers are configured
+ * at startup, see main.c.
+ * Each controller has its own axes 1..num_axes, and listens on its
+ * own port. The axis numbers of the ADS index groups (0x5000 + axis_no)
+ * limit the number of axes.
+ */
+#define DEFAULT_NUM_AXES     8
+#define MAX_NUM_AXES         4095
+#define MAX_NUM_CONTROLLERS  100
+
+/* Axis 0 is not used: Arrays of axes have num_axes + 1 elements */
+extern int hw_motor_max_axes;
+
+/*
+ *  return value: 0 == OK,
+ *                -1 invalid value, or already configured
+ */
+int hw_motor_configure(int num_axes, int num_controllers);
+
+int getNumControllers(void);
+int getControllerNo(void);
+
+/*
+ * All commands are for the axes of the selected controller,
+ * the socket layer selects the controller of the connection
+ * before a command line is handled.
+ */
+void selectController(int controller_no);
+
+/*
+ * Per axis data of a module for the selected controller.
+ * *ppAll is allocated for the axes of all controllers on the first call.
+ */
+void *getControllerAxesData(void **ppAll, size_t sizeOfAxis);
+
+#endif /* MOTOR_CTRL_H */
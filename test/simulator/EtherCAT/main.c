@@ -14,6 +14,7 @@
 
 #include "sock-util.h"
 #include "logerr_info.h"
+#include "hw_motor_ctrl.h"
 
 /* defines */
 /*****************************************************************************/
@@ -41,7 +42,11 @@ void help_and_exit(const char *msg)
           "Example: telnet_motor -v   3 prints all data received or send\n"
           "Example: telnet_motor -v  64 prints the socket events\n"
           "Example: telnet_motor -v 128 prints all data received or send\n"
-          "Example:\n");
+          "Example: telnet_motor -a 100 simulates 100 axes, default %d\n"
+          "Example: telnet_motor -c 4   simulates 4 controllers, on 4 ports\n"
+          "Example: telnet_motor -p 5000 listens on port 5000 (and up), default\n"
+          "Example:\n",
+          DEFAULT_NUM_AXES);
 
   exit(1);
 }
@@ -55,22 +60,38 @@ int main(int argc, char** argv)
   (void)signal(SIGPIPE, SIG_IGN);
 #endif
 
-  if (argc == 3 &&
-      !strcmp(argv[1], "-v")) {
-    debug_print_flags = atoi(argv[2]);
-    if (!debug_print_flags) {
-      help_and_exit("debug_print_flags must not be 0");
-    }
-  } else if (argc == 1) {
-    ;
-  } else {
-    fprintf(stderr, "argc=%d\n", argc);
+  const char *listen_port_asc = "5000";
+  int num_axes = DEFAULT_NUM_AXES;
+  int num_controllers = 1;
+  int argno;
+
+  for (argno = 1; argno < argc; argno += 2) {
+    const char *value = argno + 1 < argc ? argv[argno + 1] : NULL;
+    if (!value) {
+      help_and_exit("missing value");
+    } else if (!strcmp(argv[argno], "-v")) {
+      debug_print_flags = atoi(value);
+      if (!debug_print_flags) {
+        help_and_exit("debug_print_flags must not be 0");
+      }
+    } else if (!strcmp(argv[argno], "-a")) {
+      num_axes = atoi(value);
+    } else if (!strcmp(argv[argno], "-c")) {
+      num_controllers = atoi(value);
+    } else if (!strcmp(argv[argno], "-p")) {
+      listen_port_asc = value;
+    } else {
+      fprintf(stderr, "argv[%d]=%s\n", argno, argv[argno]);
 
-    help_and_exit("wrong argc");
+      help_and_exit("wrong argument");
+    }
   }
 
   stdlog = stdout;
-  socket_loop();
+  if (hw_motor_configure(num_axes, num_controllers)) {
+    help_and_exit("invalid number of axes or controllers");
+  }
+  socket_loop(listen_port_asc, num_controllers);
 
   LOGINFO("End %s\n", __FUNCTION__);
   fflush(stdlog);
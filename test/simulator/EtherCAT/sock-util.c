@@ -7,6 +7,7 @@
 #include <stdbool.h>
 #include <errno.h>
 #include <sys/time.h>
+#include <time.h>
 
 #include "sock-util.h"
 #if (!defined _WIN32 && !defined __WIN32__ && !defined __CYGWIN__)
@@ -34,60 +35,126 @@
 
 #include "sock-util.h"
 #include "logerr_info.h"
+#include "hw_motor_ctrl.h"
 
 /* defines */
-#define NUM_CLIENT_CONS 5
+/* The connections are kept in an array which grows on demand */
+#define CLIENT_CONS_INITIAL_NUM 16
+/* The line buffer of a connection grows on demand up to the max */
 #define CLIENT_CONS_BUFLEN 1024
+#define CLIENT_CONS_MAXBUFLEN (64 * 1024)
+
+#if defined(__linux__) && !defined(USE_WINSOCK2)
+#define USE_EPOLL
+#include <sys/epoll.h>
+#define EPOLL_MAX_EVENTS 64
+/* epoll_event.data of the listen sockets is the controller number
+   with this bit set, the clients use their index */
+#define EPOLL_DATA_LISTEN_SOCKET 0x80000000u
+#endif
 
 /*****************************************************************************/
 
 /* typedefs */
 typedef struct client_con_type {
   size_t        len_used;
+  size_t        buflen;
   unsigned char *buffer;
   time_t        last_active_sec;
   time_t        idleTimeout;
   int           fd;
+  int           controller_no;  /* Index of the listen socket */
 } client_con_type;
 
 /* static variables */
-static client_con_type client_cons[NUM_CLIENT_CONS];
+static client_con_type *client_cons;
+static unsigned num_client_cons;
+#ifdef USE_EPOLL
+static int epoll_fd = -1;
+#endif
 /*****************************************************************************/
 void init_client_cons(void)
 {
+  client_cons = NULL;
+  num_client_cons = 0;
+#ifdef USE_EPOLL
+  epoll_fd = epoll_create(CLIENT_CONS_INITIAL_NUM);
+  if (epoll_fd < 0) {
+    LOGERR_ERRNO("epoll_create() failed\n");
+    exit(3);
+  }
+#endif
+}
+
+static int grow_client_cons(void)
+{
+  unsigned new_num = num_client_cons ? 2 * num_client_cons : CLIENT_CONS_INITIAL_NUM;
+  client_con_type *new_cons;
   unsigned i;
-  memset(client_cons, 0, sizeof(client_cons));
-  for (i=0; i < NUM_CLIENT_CONS; i++) {
-    client_cons[i].fd = -1; /* fd is closed */
-    client_cons[i].buffer = malloc(CLIENT_CONS_BUFLEN);
+
+  new_cons = realloc(client_cons, new_num * sizeof(client_con_type));
+  if (!new_cons) return -1;
+  memset(&new_cons[num_client_cons], 0,
+         (new_num - num_client_cons) * sizeof(client_con_type));
+  for (i = num_client_cons; i < new_num; i++) {
+    new_cons[i].fd = -1; /* fd is closed */
   }
+  LOGINFO7("%s/%s:%d num_client_cons=%u\n",
+           __FILE__,__FUNCTION__, __LINE__, new_num);
+  client_cons = new_cons;
+  num_client_cons = new_num;
+  return 0;
 }
 
-void add_client_con(int fd)
+void add_client_con(int fd, int controller_no)
 {
   unsigned int i;
-  for (i=0; i < NUM_CLIENT_CONS; i++) {
-    if (client_cons[i].fd < 0) {
-      client_cons[i].fd = fd;
-      client_cons[i].idleTimeout = 0;
-      LOGINFO7("%s/%s:%d add i=%d fd=%d\n",
-               __FILE__,__FUNCTION__, __LINE__, i, fd);
+  for (i=0; i < num_client_cons; i++) {
+    if (client_cons[i].fd < 0) break;
+  }
+  if (i == num_client_cons && grow_client_cons()) {
+    LOGERR("%s/%s:%d add() and close() i=%u fd=%d: out of memory\n",
+           __FILE__,__FUNCTION__, __LINE__, i, fd);
+    close(fd);
+    return;
+  }
+  if (!client_cons[i].buffer) {
+    client_cons[i].buffer = malloc(CLIENT_CONS_BUFLEN);
+    client_cons[i].buflen = client_cons[i].buffer ? CLIENT_CONS_BUFLEN : 0;
+    if (!client_cons[i].buffer) {
+      LOGERR("%s/%s:%d add() and close() i=%u fd=%d: out of memory\n",
+             __FILE__,__FUNCTION__, __LINE__, i, fd);
+      close(fd);
       return;
     }
   }
-  LOGINFO7("%s/%s:%d add() and close() i=%d fd=%d\n",
-           __FILE__,__FUNCTION__, __LINE__, i, fd);
-  /* No more space, we should close the oldest not used,
-       the most stale.
-       But now we close the new one */
-  close(fd);
+#ifdef USE_EPOLL
+  {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = i;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev)) {
+      LOGERR_ERRNO("epoll_ctl() failed i=%u fd=%d\n", i, fd);
+      close(fd);
+      return;
+    }
+  }
+#endif
+  client_cons[i].fd = fd;
+  client_cons[i].controller_no = controller_no;
+  client_cons[i].len_used = 0;
+  client_cons[i].idleTimeout = 0;
+  client_cons[i].last_active_sec = time(NULL);
+  LOGINFO7("%s/%s:%d add i=%u fd=%d controller_no=%d\n",
+           __FILE__,__FUNCTION__, __LINE__, i, fd, controller_no);
 }
 
 
 int find_client_con(int fd)
 {
   unsigned int i;
-  for (i=0; i < NUM_CLIENT_CONS; i++) {
+  for (i=0; i < num_client_cons; i++) {
     if (client_cons[i].fd == fd) {
       LOGINFO7("%s/%s:%d add i=%d fd=%d\n",
                __FILE__,__FUNCTION__, __LINE__, i, fd);
@@ -101,12 +168,17 @@ void close_and_remove_client_con_i(int i)
 {
   if (i >= 0) {
     int fd = client_cons[i].fd;
-    int res = close(fd);
+    int res;
+#ifdef USE_EPOLL
+    (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+#endif
+    res = close(fd);
     LOGINFO7("%s/%s:%d close i=%d fd=%d res=%d (%s)\n",
              __FILE__,__FUNCTION__, __LINE__,
              i, fd, res,
              res ? strerror(errno) : "");
     client_cons[i].fd = -1;
+    client_cons[i].len_used = 0;
     return;
   }
   LOGINFO7("%s/%s:%d close i=%d\n",
@@ -141,11 +213,6 @@ int get_listen_socket(const char *listen_port_asc)
   int gai;
 #endif
 
-  if (startWinSock()) {
-    LOGERR_ERRNO("startWinSock() failed\n");
-    exit(3);
-  }
-  init_client_cons();
 
 #ifndef USE_WINSOCK2
   /* initialize the hints */
@@ -237,7 +304,7 @@ int get_listen_socket(const char *listen_port_asc)
       break;
   }
 
-  if ((sockfd >= 0) && (listen(sockfd, 1) < 0))
+  if ((sockfd >= 0) && (listen(sockfd, SOMAXCONN) < 0))
   {
     LOGERR("listen() failed\n");
     goto error;
@@ -259,144 +326,221 @@ int get_listen_socket(const char *listen_port_asc)
   return sockfd;
 }
 
+/* Handle all complete lines in the buffer.
+   The rest of an incomplete line is moved to the start of the buffer */
+static void handle_lines_in_buffer(int i, int fd)
+{
+  char *pLine = (char *)client_cons[i].buffer;
+  char *pEnd = pLine + client_cons[i].len_used;
+  char *pNewline;
+
+  selectController(client_cons[i].controller_no);
+  while ((pNewline = memchr(pLine, '\n', pEnd - pLine))) {
+    size_t line_len = 1 + pNewline - pLine;
+    int had_cr = 0;
+    LOGINFO7("%s/%s:%d i=%d fd=%d line_len=%lu\n",
+             __FILE__, __FUNCTION__, __LINE__, i, fd,
+             (unsigned long)line_len);
+    *pNewline = 0; /* Remove '\n' */
+    if (line_len > 1 && pNewline[-1] == '\r') {
+      had_cr = 1;
+      pNewline[-1] = '\0';
+    }
+    if (handle_input_line(fd, pLine, had_cr, 1)) {
+      close_and_remove_client_con_i(i);
+      return;
+    }
+    if (client_cons[i].fd != fd) {
+      /* send_to_socket() failed and closed the connection */
+      return;
+    }
+    pLine = pNewline + 1;
+  }
+  client_cons[i].len_used = pEnd - pLine;
+  if (client_cons[i].len_used && pLine != (char *)client_cons[i].buffer) {
+    memmove(client_cons[i].buffer, pLine, client_cons[i].len_used);
+  }
+}
+
 static void handle_data_on_socket(int i, int fd)
 {
   ssize_t read_res = 0;
   size_t len_used = client_cons[i].len_used;
 
   /* append received data to the end
-     keep one place for the '\n'  */
+     keep one place for the '\0'  */
+  if (len_used + 1 >= client_cons[i].buflen) {
+    size_t new_buflen = 2 * client_cons[i].buflen;
+    unsigned char *new_buffer = NULL;
+    if (new_buflen <= CLIENT_CONS_MAXBUFLEN) {
+      new_buffer = realloc(client_cons[i].buffer, new_buflen);
+    }
+    if (new_buffer) {
+      client_cons[i].buffer = new_buffer;
+      client_cons[i].buflen = new_buflen;
+    } else {
+      LOGERR("%s/%s:%d i=%d fd=%d line too long, discarded len_used=%lu\n",
+             __FILE__, __FUNCTION__, __LINE__, i, fd,
+             (unsigned long)len_used);
+      len_used = 0;
+      client_cons[i].len_used = 0;
+    }
+  }
 
   read_res = recv(fd, (char *)&client_cons[i].buffer[len_used],
-                  CLIENT_CONS_BUFLEN - len_used - 1, 0);
-  LOGINFO7("%s/%s:%d FD_ISSET fd=%d read_res=%ld\n",
-           __FILE__, __FUNCTION__, __LINE__, fd, (long)read_res);
+                  client_cons[i].buflen - len_used - 1, 0);
+  LOGINFO7("%s/%s:%d i=%d fd=%d read_res=%ld\n",
+           __FILE__, __FUNCTION__, __LINE__, i, fd, (long)read_res);
   if (read_res <= 0)  {
     if (read_res == 0) {
       close_and_remove_client_con_i(i);
       LOGINFO(" EOF i=%d fd=%d\n", i, fd);
+    } else if (errno != EINTR && errno != EAGAIN) {
+      LOGERR_ERRNO("recv() failed i=%d fd=%d\n", i, fd);
+      close_and_remove_client_con_i(i);
     }
-  } else {
-    char *pNewline;
-    len_used = client_cons[i].len_used + read_res;
-    client_cons[i].len_used = len_used;
-    client_cons[i].buffer[len_used] = '\0';
-    pNewline = strchr((char *)client_cons[i].buffer, '\n');
-    LOGINFO7("%s/%s:%d FD_ISSET i=%d fd=%d len_used=%lu pNewline=%d\n",
-             __FILE__, __FUNCTION__, __LINE__, i, fd,
-             (unsigned long)len_used, pNewline ? 1 : 0);
-    if (pNewline) {
-      size_t line_len = 1 + (void*)pNewline - (void*)client_cons[i].buffer;
-      int had_cr = 0;
-      LOGINFO7("%s/%s:%d FD_ISSET i=%d fd=%d line_len=%lu\n",
-               __FILE__, __FUNCTION__, __LINE__, i, fd,
-               (unsigned long)line_len);
-      *pNewline = 0; /* Remove '\n' */
-      if (line_len > 1) pNewline--;
-      if (*pNewline == '\r') {
-        had_cr = 1;
-        *pNewline = '\0';
-      }
-      if (handle_input_line(fd, (const char *)&client_cons[i].buffer[0], had_cr, 1)) {
-        close_and_remove_client_con_i(i);
-      }
-      client_cons[i].len_used = 0;
-    }
+    return;
   }
+  len_used += read_res;
+  client_cons[i].len_used = len_used;
+  client_cons[i].buffer[len_used] = '\0';
+  handle_lines_in_buffer(i, fd);
 }
 
 /*****************************************************************************/
-void handle_accepted_socket(int listen_socket, int accepted_socket)
+static void accept_client_con(int listen_socket, int controller_no)
+{
+  int accepted_socket = accept(listen_socket, NULL, NULL);
+  if (accepted_socket < 0) {
+    LOGERR_ERRNO("accept() failed\n");
+    return;
+  }
+  LOGINFO("Connection accepted fd=%d controller_no=%d\n",
+          accepted_socket, controller_no);
+  add_client_con(accepted_socket, controller_no);
+}
+
+/* Close the connections which are idle too long.
+   Returns the time in seconds until the next one may time out,
+   or max_timeout */
+static int handle_idle_timeouts(time_t now_sec, int max_timeout)
 {
-  /* We come here if we have accepted a new connection */
+  int timeout = max_timeout;
   unsigned int i;
-  int end_recv_loop = 0;
-  int end_select_loop = 0;
 
-  add_client_con(accepted_socket);
-  do
-  {
-    do
-    {
-      int max_timeout = 2 * 60 * 60; /*  2 hours */
-      int res;
-      fd_set rfds;
-      struct timeval tv_now;
-      struct timeval tv_select;
-      int maxfd = 0;
-
-      (void)gettimeofday(&tv_now, NULL);
-
-      FD_ZERO (&rfds);
-      tv_select.tv_sec = max_timeout;
-      tv_select.tv_usec = 0;
-
-      FD_SET(listen_socket, &rfds);
-      for (i=0; i < NUM_CLIENT_CONS; i++) {
-        int fd = client_cons[i].fd;
-        time_t idleTimeout = client_cons[i].idleTimeout;
-        if (fd < 0) continue;
-        if (idleTimeout) {
-          time_t last_active_sec = client_cons[i].last_active_sec;
-          if (tv_now.tv_sec - idleTimeout > last_active_sec) {
-            LOGINFO7("%s/%s:%d timeout i=%d fd=%d\n",
-                     __FILE__, __FUNCTION__, __LINE__, i, fd);
-            close_and_remove_client_con_i(i);
-            fd = -1;
-          } else {
-            /* Wait at least 1 second */
-            time_t wait_now = 1 + idleTimeout + last_active_sec - tv_now.tv_sec;
-            if (tv_select.tv_sec > wait_now) {
-              tv_select.tv_sec = wait_now;
-            }
-          }
-        }
-        if (fd >= 0) {
-          FD_SET(fd, &rfds);
-          if (maxfd < fd) {
-            maxfd = fd;
-          }
-        }
+  for (i=0; i < num_client_cons; i++) {
+    int fd = client_cons[i].fd;
+    time_t idleTimeout = client_cons[i].idleTimeout;
+    time_t last_active_sec = client_cons[i].last_active_sec;
+    if (fd < 0 || !idleTimeout) continue;
+    if (now_sec - idleTimeout > last_active_sec) {
+      LOGINFO7("%s/%s:%d timeout i=%d fd=%d\n",
+               __FILE__, __FUNCTION__, __LINE__, i, fd);
+      close_and_remove_client_con_i(i);
+    } else {
+      /* Wait at least 1 second */
+      time_t wait_now = 1 + idleTimeout + last_active_sec - now_sec;
+      if (timeout > wait_now) {
+        timeout = (int)wait_now;
       }
-      maxfd = listen_socket > maxfd ? listen_socket : maxfd;
-      LOGINFO7("%s/%s:%d select(): maxfd=%d tv_sec=%lu\n",
-               __FILE__, __FUNCTION__, __LINE__,
-               maxfd, (unsigned long)tv_select.tv_sec);
-      res = select (maxfd + 1, &rfds, NULL, NULL, &tv_select);
-      LOGINFO7("%s/%s:%d maxfd=%d res(select)=%d %s\n",
-               __FILE__, __FUNCTION__, __LINE__,
-               maxfd,
-               res,
-               res < 0 ? strerror(errno) : "");
-      (void)gettimeofday(&tv_now, NULL);
-      if (res < 0) {
-        end_select_loop = 1;
-        end_recv_loop = 1;
-      } else {
-        if (FD_ISSET (listen_socket, &rfds)) {
-          LOGINFO7("%s/%s:%d FD_ISSET (listen_socket)\n",
-                   __FILE__, __FUNCTION__, __LINE__);
-          end_recv_loop = 1;
-        } else {
-          unsigned int i;
-
-          for (i=0; i < NUM_CLIENT_CONS; i++) {
-            int fd = client_cons[i].fd;
-            if (fd < 0) continue;
-            if (FD_ISSET (fd, &rfds)) {
-              LOGINFO7("%s/%s:%d FD_ISSET fd=%d\n",
-                       __FILE__, __FUNCTION__, __LINE__, fd);
-              client_cons[i].last_active_sec = tv_now.tv_sec;
-              handle_data_on_socket(i, fd);
-            } else {
-            }
-          }
-        }
+    }
+  }
+  return timeout;
+}
+
+#ifdef USE_EPOLL
+/* Wait for events, and handle them.
+   Returns -1 on a fatal error */
+static int wait_and_handle_events(const int *listen_sockets,
+                                  int num_listen_sockets, int timeout)
+{
+  struct epoll_event events[EPOLL_MAX_EVENTS];
+  time_t now_sec;
+  int res;
+  int n;
+
+  LOGINFO7("%s/%s:%d epoll_wait(): timeout=%d\n",
+           __FILE__, __FUNCTION__, __LINE__, timeout);
+  res = epoll_wait(epoll_fd, events, EPOLL_MAX_EVENTS, timeout * 1000);
+  if (res < 0) {
+    if (errno == EINTR) return 0;
+    LOGERR_ERRNO("epoll_wait() failed\n");
+    return -1;
+  }
+  now_sec = time(NULL);
+  for (n = 0; n < res; n++) {
+    unsigned i = events[n].data.u32;
+    if (i & EPOLL_DATA_LISTEN_SOCKET) {
+      int controller_no = (int)(i & ~EPOLL_DATA_LISTEN_SOCKET);
+      if (controller_no < num_listen_sockets) {
+        accept_client_con(listen_sockets[controller_no], controller_no);
       }
-    } while (!end_recv_loop && !end_select_loop);
-  } while (!end_recv_loop);
-  LOGINFO("End of loop\n");
+    } else if (i < num_client_cons && client_cons[i].fd >= 0) {
+      /* Not closed by an event before */
+      client_cons[i].last_active_sec = now_sec;
+      handle_data_on_socket(i, client_cons[i].fd);
+    }
+  }
+  return 0;
+}
+#else
+static int wait_and_handle_events(const int *listen_sockets,
+                                  int num_listen_sockets, int timeout)
+{
+  fd_set rfds;
+  struct timeval tv_select;
+  time_t now_sec;
+  int maxfd = 0;
+  int controller_no;
+  unsigned int i;
+  int res;
+
+  FD_ZERO (&rfds);
+  tv_select.tv_sec = timeout;
+  tv_select.tv_usec = 0;
+
+  for (controller_no = 0; controller_no < num_listen_sockets; controller_no++) {
+    int fd = listen_sockets[controller_no];
+    FD_SET(fd, &rfds);
+    if (maxfd < fd) {
+      maxfd = fd;
+    }
+  }
+  for (i=0; i < num_client_cons; i++) {
+    int fd = client_cons[i].fd;
+    if (fd < 0) continue;
+    FD_SET(fd, &rfds);
+    if (maxfd < fd) {
+      maxfd = fd;
+    }
+  }
+  LOGINFO7("%s/%s:%d select(): maxfd=%d tv_sec=%lu\n",
+           __FILE__, __FUNCTION__, __LINE__,
+           maxfd, (unsigned long)tv_select.tv_sec);
+  res = select (maxfd + 1, &rfds, NULL, NULL, &tv_select);
+  if (res < 0) {
+    if (errno == EINTR) return 0;
+    LOGERR_ERRNO("select() failed\n");
+    return -1;
+  }
+  now_sec = time(NULL);
+  for (i=0; i < num_client_cons; i++) {
+    int fd = client_cons[i].fd;
+    if (fd < 0) continue;
+    if (FD_ISSET (fd, &rfds)) {
+      client_cons[i].last_active_sec = now_sec;
+      handle_data_on_socket(i, fd);
+    }
+  }
+  /* Accept after the loop, add_client_con() may grow client_cons */
+  for (controller_no = 0; controller_no < num_listen_sockets; controller_no++) {
+    if (FD_ISSET (listen_sockets[controller_no], &rfds)) {
+      accept_client_con(listen_sockets[controller_no], controller_no);
+    }
+  }
+  return 0;
 }
+#endif
 
 /*****************************************************************************/
 void send_to_socket(int fd, const char *buf, unsigned len)
@@ -427,35 +571,56 @@ void send_to_socket(int fd, const char *buf, unsigned len)
 
 
 /*****************************************************************************/
-void socket_loop(void)
+void socket_loop(const char *listen_port_asc, int num_listen_ports)
 {
-  static const char *listen_port_asc = "5000";
-  int listen_socket;
-  int accepted_socket;
+  int max_timeout = 2 * 60 * 60; /*  2 hours */
+  int listen_sockets[MAX_NUM_CONTROLLERS];
+  int controller_no;
   int stop_and_exit = 0;
 
-  listen_socket = get_listen_socket(listen_port_asc);
-
-  if (listen_socket < 0)
-  {
-    LOGERR_ERRNO("no listening socket!\n");
+  if (startWinSock()) {
+    LOGERR_ERRNO("startWinSock() failed\n");
     exit(3);
   }
+  init_client_cons();
+  if (num_listen_ports < 1 || num_listen_ports > MAX_NUM_CONTROLLERS) {
+    LOGERR("invalid number of ports %d\n", num_listen_ports);
+    exit(3);
+  }
+
+  /* Controller n listens on listen_port_asc + n */
+  for (controller_no = 0; controller_no < num_listen_ports; controller_no++) {
+    char port_asc[16];
+    snprintf(port_asc, sizeof(port_asc), "%d",
+             atoi(listen_port_asc) + controller_no);
+    listen_sockets[controller_no] = get_listen_socket(port_asc);
+    if (listen_sockets[controller_no] < 0)
+    {
+      LOGERR_ERRNO("no listening socket!\n");
+      exit(3);
+    }
+#ifdef USE_EPOLL
+    {
+      struct epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      ev.events = EPOLLIN;
+      ev.data.u32 = EPOLL_DATA_LISTEN_SOCKET | (unsigned)controller_no;
+      if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_sockets[controller_no], &ev)) {
+        LOGERR_ERRNO("epoll_ctl() failed\n");
+        exit(3);
+      }
+    }
+#endif
+  }
 
   while (!stop_and_exit)
   {
-    accepted_socket = accept(listen_socket, NULL, NULL);
-    if (accepted_socket < 0)
-    {
-      LOGERR("accept() failed\n");
+    int timeout = handle_idle_timeouts(time(NULL), max_timeout);
+    if (wait_and_handle_events(listen_sockets, num_listen_ports, timeout) < 0) {
       stop_and_exit = 1;
-      continue;
     }
-
-    LOGINFO("Connection accepted fd=%d\n", accepted_socket);
-    handle_accepted_socket(listen_socket, accepted_socket);
-    LOGINFO("Connection closed\n");
   }
+  LOGINFO("End of loop\n");
 }
 
 
@@ -5,7 +5,7 @@ extern int get_listen_socket(const char *listen_port_asc);
 extern int handle_input_line(int socket_fd, const char *input_line, int had_cr, int had_lf);
 extern void send_to_socket(int fd, const char *buf, unsigned len);
 extern int socket_set_timeout(int fd, int seconds);
-void socket_loop(void);
+void socket_loop(const char *listen_port_asc, int num_listen_ports);
 
 
 #define PRINT_ADD_CR (1<<0)
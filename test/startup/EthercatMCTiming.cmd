@@ -0,0 +1,10 @@
+# Timing histograms of the controller, see asynAxisTiming.template
+
+# @field PREFIX
+# @type  STRING
+
+# @field MOTOR_PORT
+# @type  STRING
+# MCU1, MCU2
+
+dbLoadRecords("asynAxisTiming.template", "P=$(PREFIX), R=$(MOTOR_PORT):, PORT=$(MOTOR_PORT), TIMEOUT=1, SCAN=1 second")
@@ -0,0 +1,14 @@
+# Timing histogram of one axis, see asynAxisTimingAxis.template
+
+# @field PREFIX
+# @type  STRING
+
+# @field MOTOR_PORT
+# @type  STRING
+# MCU1, MCU2
+
+# @field AXIS_NO
+# @type  STRING
+# 1,2,3,4
+
+dbLoadRecords("asynAxisTimingAxis.template", "P=$(PREFIX), R=$(MOTOR_PORT):, M=$(AXIS_NO), PORT=$(MOTOR_PORT), ADDR=$(AXIS_NO), TIMEOUT=1, SCAN=1 second")